@@ -22,7 +22,6 @@
 #include <physfs.h>
 
 #include "addon/addon.hpp"
-#include "addon/md5.hpp"
 #include "physfs/util.hpp"
 #include "supertux/globals.hpp"
 #include "util/file_system.hpp"
@@ -38,45 +37,6 @@ namespace {
 
 static const char* ADDON_INFO_PATH = "/addons/repository.nfo";
 
-MD5 md5_from_file(const std::string& filename)
-{
-  // TODO: this does not work as expected for some files -- IFileStream seems to not always behave like an ifstream.
-  //IFileStream ifs(installed_physfs_filename);
-  //std::string md5 = MD5(ifs).hex_digest();
-
-  MD5 md5;
-
-  auto file = PHYSFS_openRead(filename.c_str());
-  if (!file)
-  {
-    std::ostringstream out;
-    out << "PHYSFS_openRead() failed: " << PHYSFS_getLastErrorCode();
-    throw std::runtime_error(out.str());
-  }
-  else
-  {
-    while (true)
-    {
-      unsigned char buffer[1024];
-      PHYSFS_sint64 len = PHYSFS_readBytes(file, buffer, sizeof(buffer));
-      if (len <= 0) break;
-      md5.update(buffer, static_cast<unsigned int>(len));
-    }
-    PHYSFS_close(file);
-
-    return md5;
-  }
-}
-
-MD5 md5_from_archive(const std::string& filename)
-{
-  if (physfsutil::is_directory(filename)) {
-    return MD5();
-  } else {
-    return md5_from_file(filename);
-  }
-}
-
 static Addon& get_addon(const AddonManager::AddonList& list, const AddonId& id,
                         bool installed)
 {
@@ -139,6 +99,7 @@ AddonManager::AddonManager(const std::string& addon_directory,
   m_addon_directory(addon_directory),
   m_repository_url("https://raw.githubusercontent.com/SuperTux/addons/master/index-0_6.nfo"),
   m_addon_config(addon_config),
+  m_hash_cache(FileSystem::join(addon_directory, "hash-cache")),
   m_installed_addons(),
   m_repository_addons(),
   m_has_been_updated(false),
@@ -321,28 +282,7 @@ AddonManager::request_install_addon(const AddonId& addon_id)
           // complete the addon install
           Addon& repository_addon = get_repository_addon(addon_id);
 
-          MD5 md5 = md5_from_file(install_filename);
-          if (repository_addon.get_md5() != md5.hex_digest())
-          {
-            if (PHYSFS_delete(install_filename.c_str()) == 0)
-            {
-              log_warning << "PHYSFS_delete failed: " << PHYSFS_getLastErrorCode() << std::endl;
-            }
-
-            throw std::runtime_error("Downloading Add-on failed: MD5 checksums differ");
-          }
-          else
-          {
-            const char* realdir = PHYSFS_getRealDir(install_filename.c_str());
-            if (!realdir)
-            {
-              throw std::runtime_error("PHYSFS_getRealDir failed: " + install_filename);
-            }
-            else
-            {
-              add_installed_archive(install_filename, md5.hex_digest());
-            }
-          }
+          finish_install(repository_addon, install_filename);
         }
       });
 
@@ -380,28 +320,7 @@ AddonManager::install_addon(const AddonId& addon_id)
 
   m_downloader.download(repository_addon.get_url(), install_filename);
 
-  MD5 md5 = md5_from_file(install_filename);
-  if (repository_addon.get_md5() != md5.hex_digest())
-  {
-    if (PHYSFS_delete(install_filename.c_str()) == 0)
-    {
-      log_warning << "PHYSFS_delete failed: " << PHYSFS_getLastErrorCode() << std::endl;
-    }
-
-    throw std::runtime_error("Downloading Add-on failed: MD5 checksums differ");
-  }
-  else
-  {
-    const char* realdir = PHYSFS_getRealDir(install_filename.c_str());
-    if (!realdir)
-    {
-      throw std::runtime_error("PHYSFS_getRealDir failed: " + install_filename);
-    }
-    else
-    {
-      add_installed_archive(install_filename, md5.hex_digest());
-    }
-  }
+  finish_install(repository_addon, install_filename);
 }
 
 void
@@ -673,15 +592,58 @@ AddonManager::add_installed_archive(const std::string& archive, const std::strin
   }
 }
 
+void
+AddonManager::finish_install(const Addon& repository_addon, const std::string& install_filename)
+{
+  const std::string md5 = ArchiveHashCache::hash_file(install_filename);
+  if (repository_addon.get_md5() != md5)
+  {
+    if (PHYSFS_delete(install_filename.c_str()) == 0)
+    {
+      log_warning << "PHYSFS_delete failed: " << PHYSFS_getLastErrorCode() << std::endl;
+    }
+
+    throw std::runtime_error("Downloading Add-on failed: MD5 checksums differ");
+  }
+  else
+  {
+    const char* realdir = PHYSFS_getRealDir(install_filename.c_str());
+    if (!realdir)
+    {
+      throw std::runtime_error("PHYSFS_getRealDir failed: " + install_filename);
+    }
+    else
+    {
+      m_hash_cache.set_hash(install_filename, md5);
+      save_hash_cache();
+      add_installed_archive(install_filename, md5);
+    }
+  }
+}
+
 void
 AddonManager::add_installed_addons()
 {
   auto archives = scan_for_archives();
+  auto hashes = m_hash_cache.get_hashes(archives);
+  save_hash_cache();
 
-  for (const auto& archive : archives)
+  for (size_t i = 0; i < archives.size(); ++i)
+  {
+    add_installed_archive(archives[i], hashes[i]);
+  }
+}
+
+void
+AddonManager::save_hash_cache()
+{
+  try
+  {
+    m_hash_cache.save();
+  }
+  catch(const std::exception& err)
   {
-    MD5 md5 = md5_from_archive(archive);
-    add_installed_archive(archive, md5.hex_digest());
+    log_warning << "Couldn't save the add-on hash cache: " << err.what() << std::endl;
   }
 }
 
@@ -24,6 +24,7 @@
 #include <string>
 #include <vector>
 
+#include "addon/archive_hash_cache.hpp"
 #include "addon/downloader.hpp"
 #include "supertux/gameconfig.hpp"
 #include "util/currenton.hpp"
@@ -44,6 +45,7 @@ private:
   std::string m_addon_directory;
   std::string m_repository_url;
   std::vector<Config::Addon>& m_addon_config;
+  ArchiveHashCache m_hash_cache;
 
   AddonList m_installed_addons;
   AddonList m_repository_addons;
@@ -95,6 +97,12 @@ private:
       archives */
   void add_installed_archive(const std::string& archive, const std::string& md5);
 
+  /** checks the hash of a downloaded add-on and adds it to the list of
+      installed archives, deletes it and throws if the hash is wrong */
+  void finish_install(const Addon& repository_addon, const std::string& install_filename);
+
+  void save_hash_cache();
+
   /** search for an .nfo file in the top level directory that
       originates from \a archive, \a archive is a OS path */
   std::string scan_for_info(const std::string& archive) const;
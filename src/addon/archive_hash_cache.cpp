@@ -0,0 +1,183 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "addon/archive_hash_cache.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+#include "addon/md5.hpp"
+#include "physfs/mapped_file.hpp"
+#include "physfs/util.hpp"
+#include "util/log.hpp"
+#include "util/reader_mapping.hpp"
+#include "util/writer.hpp"
+
+unsigned int ArchiveHashCache::s_worker_count = 0;
+
+std::string
+ArchiveHashCache::hash_file(const std::string& filename)
+{
+  MappedFile file(filename);
+  MD5 md5;
+  md5.update(file.get_data(), file.get_size());
+  return md5.hex_digest();
+}
+
+ArchiveHashCache::ArchiveHashCache(const std::string& filename) :
+  m_filename(filename),
+  m_entries(),
+  m_changed(false),
+  m_hashed_count(0)
+{
+  load();
+}
+
+std::vector<std::string>
+ArchiveHashCache::get_hashes(const std::vector<std::string>& archives)
+{
+  std::vector<std::string> hashes(archives.size());
+  std::unordered_map<std::string, Entry> entries;
+  std::vector<size_t> uncached;
+
+  for (size_t i = 0; i < archives.size(); ++i)
+  {
+    const std::string& archive = archives[i];
+    if (physfsutil::is_directory(archive)) {
+      hashes[i] = MD5().hex_digest();
+      continue;
+    }
+
+    Entry entry;
+    if (!FileStamp::stat(archive, entry.stamp))
+      throw std::runtime_error("Couldn't find add-on archive '" + archive + "'");
+
+    auto it = m_entries.find(archive);
+    if (it != m_entries.end() && it->second.stamp == entry.stamp)
+    {
+      hashes[i] = it->second.hash;
+    }
+    else
+    {
+      uncached.push_back(i);
+    }
+    entries[archive] = std::move(entry);
+  }
+
+  if (!uncached.empty())
+  {
+    // Workers only touch their own slots of hashes and errors, the
+    // results are checked and logged once they are done.
+    std::vector<std::string> errors(archives.size());
+    std::atomic<size_t> next(0);
+    auto worker = [&archives, &hashes, &errors, &uncached, &next]
+    {
+      for (size_t task = next++; task < uncached.size(); task = next++)
+      {
+        const size_t i = uncached[task];
+        try
+        {
+          hashes[i] = hash_file(archives[i]);
+        }
+        catch(const std::exception& err)
+        {
+          errors[i] = err.what();
+        }
+      }
+    };
+
+    unsigned int worker_count = s_worker_count;
+    if (worker_count == 0)
+      worker_count = std::max(1u, std::thread::hardware_concurrency());
+    worker_count = std::min(worker_count, static_cast<unsigned int>(uncached.size()));
+
+    // the calling thread is one of the workers
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i < worker_count; ++i)
+      threads.emplace_back(worker);
+    worker();
+    for (auto& thread : threads)
+      thread.join();
+
+    m_hashed_count += uncached.size();
+    log_debug << "hashed " << uncached.size() << " add-on archives on "
+              << worker_count << " threads" << std::endl;
+
+    for (const size_t i : uncached)
+    {
+      if (!errors[i].empty())
+        throw std::runtime_error("Couldn't hash add-on archive '" + archives[i] + "': " + errors[i]);
+      entries[archives[i]].hash = hashes[i];
+    }
+  }
+
+  if (!uncached.empty() || entries.size() != m_entries.size())
+    m_changed = true;
+  m_entries = std::move(entries);
+
+  return hashes;
+}
+
+void
+ArchiveHashCache::set_hash(const std::string& archive, const std::string& hash)
+{
+  Entry entry;
+  if (!FileStamp::stat(archive, entry.stamp))
+    return;
+
+  entry.hash = hash;
+  m_entries[archive] = std::move(entry);
+  m_changed = true;
+}
+
+void
+ArchiveHashCache::load()
+{
+  if (!FileStamp::read_cache(m_filename, "supertux-addon-hashes",
+                             [this](const std::string& file, const FileStamp& stamp,
+                                    const ReaderMapping& archive) {
+                               Entry entry{ stamp, {} };
+                               if (archive.get("hash", entry.hash)) {
+                                 m_entries[file] = std::move(entry);
+                               }
+                             }))
+  {
+    m_entries.clear();
+  }
+}
+
+void
+ArchiveHashCache::save()
+{
+  if (!m_changed)
+    return;
+
+  Writer writer(m_filename);
+  writer.start_list("supertux-addon-hashes");
+  for (const auto& entry : m_entries)
+  {
+    FileStamp::start_cache_entry(writer, "archive", entry.first, entry.second.stamp);
+    writer.write("hash", entry.second.hash);
+    writer.end_list("archive");
+  }
+  writer.end_list("supertux-addon-hashes");
+
+  m_changed = false;
+}
+
+/* EOF */
@@ -0,0 +1,85 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_ADDON_ARCHIVE_HASH_CACHE_HPP
+#define HEADER_SUPERTUX_ADDON_ARCHIVE_HASH_CACHE_HPP
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "physfs/file_stamp.hpp"
+
+/** Remembers the MD5 hashes of the installed add-on archives across
+    runs of the game, so that only new or changed archives have to be
+    read at startup. An entry is used as long as the size and
+    modification time of its archive stay the same. */
+class ArchiveHashCache final
+{
+public:
+  /** Returns the hex MD5 digest of a file of the PhysFS search path.
+      Throws std::runtime_error if the file can't be read. */
+  static std::string hash_file(const std::string& filename);
+
+  /** Amount of threads get_hashes() hashes archives on, 0 for one per
+      core */
+  static unsigned int s_worker_count;
+
+public:
+  ArchiveHashCache(const std::string& filename);
+
+  /** Returns the hashes of the archives, given as PhysFS paths, in the
+      same order. Archives that aren't cached are hashed in parallel;
+      directories have the hash of empty content. Entries of archives
+      that aren't in the list are forgotten. Throws std::runtime_error
+      if an archive can't be read. */
+  std::vector<std::string> get_hashes(const std::vector<std::string>& archives);
+
+  /** Stores the hash of an archive that was hashed elsewhere, e.g. to
+      check a download */
+  void set_hash(const std::string& archive, const std::string& hash);
+
+  /** Writes the cache if it changed since it was loaded */
+  void save();
+
+  /** Amount of archives get_hashes() had to read as they weren't
+      cached */
+  size_t get_hashed_count() const { return m_hashed_count; }
+
+private:
+  struct Entry
+  {
+    FileStamp stamp;
+    std::string hash;
+  };
+
+private:
+  void load();
+
+private:
+  std::string m_filename;
+  std::unordered_map<std::string, Entry> m_entries;
+  bool m_changed;
+  size_t m_hashed_count;
+
+private:
+  ArchiveHashCache(const ArchiveHashCache&) = delete;
+  ArchiveHashCache& operator=(const ArchiveHashCache&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -90,6 +90,21 @@ void MD5::update (uint8_t* input, uint32_t input_length) {
   memcpy(buffer+buffer_index, input+input_index, input_length-input_index);
 }
 
+void MD5::update(const void* input, size_t input_length) {
+  // The bit count of a single block update must fit in 32 bits, so feed
+  // large buffers in pieces; the digest doesn't depend on how the input
+  // is split.
+  const size_t max_length = 1u << 28;
+  uint8_t* data = static_cast<uint8_t*>(const_cast<void*>(input));
+
+  while (input_length > max_length) {
+    update(data, static_cast<uint32_t>(max_length));
+    data += max_length;
+    input_length -= max_length;
+  }
+  update(data, static_cast<uint32_t>(input_length));
+}
+
 void MD5::update(FILE *file) {
   uint8_t buffer_[1024];
   size_t len;
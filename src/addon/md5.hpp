@@ -57,6 +57,7 @@ public:
   MD5(std::ifstream& stream); /**< digest stream, close, finalize */
 
   void update(uint8_t* input, unsigned int input_length); /**< MD5 block update operation. Continues an MD5 message-digest operation, processing another message block, and updating the context. */
+  void update(const void* input, size_t input_length); /**< Like the above, for buffers of any size, e.g. a whole file mapped into memory. */
   void update(std::istream& stream);
   void update(FILE *file);
   void update(std::ifstream& stream);
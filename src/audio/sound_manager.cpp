@@ -17,7 +17,9 @@
 #include "audio/sound_manager.hpp"
 
 #include <SDL.h>
+#include <algorithm>
 #include <assert.h>
+#include <chrono>
 #include <stdexcept>
 #include <sstream>
 #include <memory>
@@ -26,6 +28,27 @@
 #include "audio/sound_file.hpp"
 #include "audio/stream_sound_source.hpp"
 #include "util/log.hpp"
+#include "util/profiler.hpp"
+
+namespace {
+
+/** Sounds with the same file started in the same frame closer than this are
+    merged into a single voice */
+const float MERGE_DISTANCE = 32.0f;
+
+} // namespace
+
+const size_t SoundManager::MAX_VOICES = 32;
+
+SoundManager::Voice::Voice(std::unique_ptr<OpenALSoundSource> source_) :
+  source(std::move(source_)),
+  filename(),
+  position(0.0f, 0.0f),
+  relative(true),
+  priority(0),
+  frame(0)
+{
+}
 
 SoundManager::SoundManager() :
   m_device(alcOpenDevice(nullptr)),
@@ -34,7 +57,14 @@ SoundManager::SoundManager() :
   m_sound_volume(0),
   m_buffers(),
   m_sources(),
+  m_voices(),
+  m_voice_stats(),
+  m_frame(0),
+  m_listener_position(0.0f, 0.0f),
   m_update_list(),
+  m_update_mutex(),
+  m_decoder_running(false),
+  m_decoder_thread(),
   m_music_source(),
   m_music_enabled(false),
   m_music_volume(0),
@@ -53,6 +83,10 @@ SoundManager::SoundManager() :
     m_music_enabled = true;
 
     set_listener_orientation(Vector(0.0f, 0.0f), Vector(0.0f, -1.0f));
+    m_voices.reserve(MAX_VOICES);
+
+    m_decoder_running = true;
+    m_decoder_thread = std::thread(&SoundManager::decode_streams, this);
   } catch(std::exception& e) {
     if (m_context != nullptr) {
       alcDestroyContext(m_context);
@@ -69,8 +103,14 @@ SoundManager::SoundManager() :
 
 SoundManager::~SoundManager()
 {
+  if (m_decoder_thread.joinable()) {
+    m_decoder_running = false;
+    m_decoder_thread.join();
+  }
+
   m_music_source.reset();
   m_sources.clear();
+  m_voices.clear();
 
   for (const auto& buffer : m_buffers) {
     alDeleteBuffers(1, &buffer.second);
@@ -109,39 +149,52 @@ SoundManager::load_file_into_buffer(SoundFile& file)
   return buffer;
 }
 
+ALuint
+SoundManager::get_buffer(const std::string& filename, std::unique_ptr<SoundFile>& stream_file)
+{
+  // reuse an existing static sound buffer
+  auto it = m_buffers.find(filename);
+  if (it != m_buffers.end())
+    return it->second;
+
+  // Load sound file
+  std::unique_ptr<SoundFile> file(load_sound_file(filename));
+
+  if (file->m_size >= 100000) {
+    log_debug << "Playing \"" << filename <<
+      "\" as StreamSoundSource, file size: " << file->m_size << std::endl;
+    stream_file = std::move(file);
+    return AL_NONE;
+  }
+
+  log_debug << "Adding \"" << filename <<
+    "\" into the buffer, file size: " << file->m_size << std::endl;
+  ALuint buffer = load_file_into_buffer(*file);
+  m_buffers.insert(std::make_pair(filename, buffer));
+  return buffer;
+}
+
+std::unique_ptr<OpenALSoundSource>
+SoundManager::create_stream_source(std::unique_ptr<SoundFile> file)
+{
+  auto stream_source = std::make_unique<StreamSoundSource>();
+  stream_source->set_sound_file(std::move(file));
+  stream_source->set_volume(static_cast<float>(m_sound_volume) / 100.0f);
+  return std::unique_ptr<OpenALSoundSource>(stream_source.release());
+}
+
 std::unique_ptr<OpenALSoundSource>
 SoundManager::intern_create_sound_source(const std::string& filename)
 {
   assert(m_sound_enabled);
 
+  std::unique_ptr<SoundFile> stream_file;
+  ALuint buffer = get_buffer(filename, stream_file);
+  if (stream_file)
+    return create_stream_source(std::move(stream_file));
+
   auto source = std::make_unique<OpenALSoundSource>();
   source->set_volume(static_cast<float>(m_sound_volume) / 100.0f);
-
-  ALuint buffer;
-
-  // reuse an existing static sound buffer
-  auto it = m_buffers.find(filename);
-  if (it != m_buffers.end()) {
-    buffer = it->second;
-  } else {
-    // Load sound file
-    std::unique_ptr<SoundFile> file(load_sound_file(filename));
-
-    if (file->m_size < 100000) {
-      log_debug << "Adding \"" << filename <<
-        "\" into the buffer, file size: " << file->m_size << std::endl;
-      buffer = load_file_into_buffer(*file);
-      m_buffers.insert(std::make_pair(filename, buffer));
-    } else {
-      log_debug << "Playing \"" << filename <<
-        "\" as StreamSoundSource, file size: " << file->m_size << std::endl;
-      auto stream_source = std::make_unique<StreamSoundSource>();
-      stream_source->set_sound_file(std::move(file));
-      stream_source->set_volume(static_cast<float>(m_sound_volume) / 100.0f);
-      return std::unique_ptr<OpenALSoundSource>(stream_source.release());
-    }
-  }
-
   alSourcei(source->m_source, AL_BUFFER, buffer);
   return source;
 }
@@ -185,7 +238,7 @@ SoundManager::preload(const std::string& filename)
 
 void
 SoundManager::play(const std::string& filename, const Vector& pos,
-  const float gain)
+  const float gain, int priority)
 {
   if (!m_sound_enabled)
     return;
@@ -194,22 +247,125 @@ SoundManager::play(const std::string& filename, const Vector& pos,
   // the value is set to min(sound_gain * sound_volume, 1)
   assert(gain >= 0.0f && gain <= 1.0f);
 
+  const bool relative = pos.x < 0 || pos.y < 0;
+
   try {
-    std::unique_ptr<OpenALSoundSource> source(intern_create_sound_source(filename));
-    source->set_gain(gain);
+    std::unique_ptr<SoundFile> stream_file;
+    ALuint buffer = get_buffer(filename, stream_file);
+
+    if (stream_file) {
+      // Long sounds are streamed, they need a source of their own
+      std::unique_ptr<OpenALSoundSource> source(create_stream_source(std::move(stream_file)));
+      source->set_gain(gain);
+      if (relative) {
+        source->set_relative(true);
+      } else {
+        source->set_position(pos);
+      }
+      source->play();
+      m_sources.push_back(std::move(source));
+      return;
+    }
 
-    if (pos.x < 0 || pos.y < 0) {
-      source->set_relative(true);
-    } else {
-      source->set_position(pos);
+    // The same sound triggered several times in a frame (coin rains, chains
+    // of explosions...) is only played once, as loud as the loudest request
+    for (auto& voice : m_voices) {
+      if (voice.frame == m_frame && voice.filename == filename &&
+          voice.relative == relative &&
+          (relative || glm::distance(voice.position, pos) < MERGE_DISTANCE)) {
+        if (voice.source->m_gain < gain)
+          voice.source->set_gain(gain);
+        voice.priority = std::max(voice.priority, priority);
+        m_voice_stats.merged += 1;
+        return;
+      }
+    }
+
+    Voice* voice = find_voice(pos, relative, priority);
+    if (!voice) {
+      m_voice_stats.drops += 1;
+      return;
     }
-    source->play();
-    m_sources.push_back(std::move(source));
+
+    OpenALSoundSource& source = *voice->source;
+    source.stop();
+    alSourcei(source.m_source, AL_BUFFER, buffer);
+    source.set_volume(static_cast<float>(m_sound_volume) / 100.0f);
+    source.set_gain(gain);
+    source.set_relative(relative);
+    source.set_position(relative ? Vector(0.0f, 0.0f) : pos);
+    source.play();
+
+    voice->filename = filename;
+    voice->position = pos;
+    voice->relative = relative;
+    voice->priority = priority;
+    voice->frame = m_frame;
   } catch(std::exception& e) {
     log_warning << "Couldn't play sound " << filename << ": " << e.what() << std::endl;
   }
 }
 
+SoundManager::Voice*
+SoundManager::find_voice(const Vector& pos, bool relative, int priority)
+{
+  Voice* victim = nullptr;
+  float victim_distance = 0.0f;
+
+  for (auto& voice : m_voices) {
+    if (!voice.source->playing() && !voice.source->paused())
+      return &voice;
+
+    const float distance = get_listener_distance(voice.position, voice.relative);
+    if (!victim || voice.priority < victim->priority ||
+        (voice.priority == victim->priority && distance > victim_distance)) {
+      victim = &voice;
+      victim_distance = distance;
+    }
+  }
+
+  if (m_voices.size() < MAX_VOICES) {
+    try {
+      auto source = std::make_unique<OpenALSoundSource>();
+      m_voices.emplace_back(std::move(source));
+      return &m_voices.back();
+    } catch(std::exception& e) {
+      // The driver ran out of sources before the pool was full, steal instead
+      log_debug << "Couldn't add sound voice: " << e.what() << std::endl;
+    }
+  }
+
+  if (!victim)
+    return nullptr;
+
+  const float distance = get_listener_distance(pos, relative);
+  if (victim->priority < priority ||
+      (victim->priority == priority && victim_distance > distance)) {
+    m_voice_stats.steals += 1;
+    return victim;
+  }
+
+  return nullptr;
+}
+
+float
+SoundManager::get_listener_distance(const Vector& pos, bool relative) const
+{
+  return relative ? 0.0f : glm::distance(pos, m_listener_position);
+}
+
+SoundManager::VoiceStats
+SoundManager::get_voice_stats() const
+{
+  VoiceStats stats = m_voice_stats;
+  stats.pool_size = static_cast<int>(m_voices.size());
+  stats.active = static_cast<int>(std::count_if(m_voices.begin(), m_voices.end(),
+                                                [](const Voice& voice) {
+                                                  return voice.source->playing();
+                                                }));
+  return stats;
+}
+
 void
 SoundManager::manage_source(std::unique_ptr<SoundSource> source)
 {
@@ -226,6 +382,7 @@ SoundManager::register_for_update(StreamSoundSource* sss)
 {
   if (sss)
   {
+    std::lock_guard<std::mutex> lock(m_update_mutex);
     m_update_list.push_back(sss);
   }
 }
@@ -235,6 +392,7 @@ SoundManager::remove_from_update(StreamSoundSource* sss)
 {
   if (sss)
   {
+    std::lock_guard<std::mutex> lock(m_update_mutex);
     auto it = m_update_list.begin();
     while (it != m_update_list.end()) {
       if (*it == sss) {
@@ -246,6 +404,23 @@ SoundManager::remove_from_update(StreamSoundSource* sss)
   }
 }
 
+void
+SoundManager::decode_streams()
+{
+  while (m_decoder_running) {
+    bool decoded = false;
+    {
+      std::lock_guard<std::mutex> lock(m_update_mutex);
+      for (auto* stream : m_update_list)
+        decoded |= stream->decode();
+    }
+
+    // Every stream is far enough ahead, check again later
+    if (!decoded)
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+}
+
 void
 SoundManager::enable_sound(bool enable)
 {
@@ -362,6 +537,11 @@ SoundManager::pause_sounds()
       source->pause();
     }
   }
+  for (auto& voice : m_voices) {
+    if (voice.source->playing()) {
+      voice.source->pause();
+    }
+  }
 }
 
 void
@@ -372,6 +552,11 @@ SoundManager::resume_sounds()
       source->resume();
     }
   }
+  for (auto& voice : m_voices) {
+    if (voice.source->paused()) {
+      voice.source->resume();
+    }
+  }
 }
 
 void
@@ -380,6 +565,9 @@ SoundManager::stop_sounds()
   for (auto& source : m_sources) {
     source->stop();
   }
+  for (auto& voice : m_voices) {
+    voice.source->stop();
+  }
 }
 
 void
@@ -389,6 +577,9 @@ SoundManager::set_sound_volume(int volume)
   for (auto& source : m_sources) {
     source->set_volume(static_cast<float>(volume) / 100.0f);
   }
+  for (auto& voice : m_voices) {
+    voice.source->set_volume(static_cast<float>(volume) / 100.0f);
+  }
 }
 
 void
@@ -411,6 +602,8 @@ SoundManager::resume_music(float fadetime)
 void
 SoundManager::set_listener_position(const Vector& pos)
 {
+  m_listener_position = pos;
+
   static Uint32 lastticks = SDL_GetTicks();
 
   Uint32 current_ticks = SDL_GetTicks();
@@ -437,6 +630,10 @@ SoundManager::set_listener_orientation(const Vector& at, const Vector& up)
 void
 SoundManager::update()
 {
+  ProfileZone profile_zone("SoundManager::update");
+
+  m_frame += 1;
+
   static Uint32 lasttime = SDL_GetTicks();
   Uint32 now = SDL_GetTicks();
 
@@ -17,9 +17,13 @@
 #ifndef HEADER_SUPERTUX_AUDIO_SOUND_MANAGER_HPP
 #define HEADER_SUPERTUX_AUDIO_SOUND_MANAGER_HPP
 
+#include <atomic>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <stdint.h>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <al.h>
@@ -45,6 +49,27 @@ private:
   static void print_openal_version();
   static void check_al_error(const char* message);
 
+public:
+  /** Priorities for play(). Sounds that must not be cut use
+      PRIORITY_HIGH, frequent ones that can be lost use PRIORITY_LOW. */
+  enum Priority
+  {
+    PRIORITY_LOW = -1,
+    PRIORITY_NORMAL = 0,
+    PRIORITY_HIGH = 1
+  };
+
+  /** Counters describing the pool of voices used by play(), drawn next
+      to the FPS when it is shown */
+  struct VoiceStats
+  {
+    int active;
+    int pool_size;
+    int steals;
+    int drops;
+    int merged;
+  };
+
 public:
   SoundManager();
   ~SoundManager() override;
@@ -57,12 +82,17 @@ public:
       This function never throws exceptions, but might return a DummySoundSource */
   std::unique_ptr<SoundSource> create_sound_source(const std::string& filename);
 
-  /** Convenience functions to simply play a sound at a given position. */
+  /** Convenience functions to simply play a sound at a given position.
+      The sound is played on a voice of a fixed-size pool; when all voices
+      are busy, the one with the lowest priority (then the farthest from the
+      listener) is stolen if the new sound outranks it, else the new sound
+      is dropped. Identical sounds started in the same frame at about the
+      same place are only played once. */
   void play(const std::string& name, const Vector& pos = Vector(-1, -1),
-    const float gain = 0.5f);
-  void play(const std::string& name, const float gain)
+    const float gain = 0.5f, int priority = PRIORITY_NORMAL);
+  void play(const std::string& name, const float gain, int priority = PRIORITY_NORMAL)
   {
-    play(name, Vector(-1, -1), gain);
+    play(name, Vector(-1, -1), gain, priority);
   }
 
 
@@ -97,15 +127,50 @@ public:
   std::string get_current_music() const { return m_current_music; }
   void update();
 
+  VoiceStats get_voice_stats() const;
+
   /** Tell soundmanager to call update() for stream_sound_source. */
   void register_for_update(StreamSoundSource* sss);
 
   /** Unsubscribe from updates for stream_sound_source. */
   void remove_from_update(StreamSoundSource* sss);
 
+private:
+  struct Voice
+  {
+    Voice(std::unique_ptr<OpenALSoundSource> source_);
+
+    std::unique_ptr<OpenALSoundSource> source;
+    std::string filename;
+    Vector position;
+    bool relative;
+    int priority;
+
+    /** Value of m_frame when the sound was started */
+    uint32_t frame;
+  };
+
+  /** Maximum amount of voices used by play() */
+  static const size_t MAX_VOICES;
+
 private:
   /** creates a new sound source, might throw exceptions, never returns nullptr */
   std::unique_ptr<OpenALSoundSource> intern_create_sound_source(const std::string& filename);
+  std::unique_ptr<OpenALSoundSource> create_stream_source(std::unique_ptr<SoundFile> file);
+
+  /** Returns the static buffer holding the sound, loading it if needed. If
+      the file is too large to be kept in memory, AL_NONE is returned and
+      the opened file is moved into stream_file. Might throw exceptions. */
+  ALuint get_buffer(const std::string& filename, std::unique_ptr<SoundFile>& stream_file);
+
+  /** Returns a voice that can play a new sound, or nullptr if all voices are
+      busy with sounds that are more important */
+  Voice* find_voice(const Vector& pos, bool relative, int priority);
+  float get_listener_distance(const Vector& pos, bool relative) const;
+
+  /** Body of the decoder thread, decodes the registered streams ahead of
+      the time they get queued by update() */
+  void decode_streams();
 
   void check_alc_error(const char* message) const;
 
@@ -118,8 +183,20 @@ private:
   std::map<std::string, ALuint> m_buffers;
   std::vector<std::unique_ptr<OpenALSoundSource> > m_sources;
 
+  std::vector<Voice> m_voices;
+  VoiceStats m_voice_stats;
+  uint32_t m_frame;
+  Vector m_listener_position;
+
   std::vector<StreamSoundSource*> m_update_list;
 
+  /** Guards m_update_list and the sound files of the streams in it against
+      the decoder thread; update() doesn't need it as only the main thread
+      modifies the list. */
+  std::mutex m_update_mutex;
+  std::atomic<bool> m_decoder_running;
+  std::thread m_decoder_thread;
+
   std::unique_ptr<StreamSoundSource> m_music_source;
 
   bool m_music_enabled;
@@ -14,18 +14,29 @@
 //  You should have received a copy of the GNU General Public License
 //  along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
+#include "audio/stream_sound_source.hpp"
+
+#include <mutex>
+
 #include "audio/sound_file.hpp"
 #include "audio/sound_manager.hpp"
-#include "audio/stream_sound_source.hpp"
 #include "supertux/globals.hpp"
 #include "util/log.hpp"
 
 StreamSoundSource::StreamSoundSource() :
   m_file(),
+  m_buffers(),
+  m_free_buffers(),
+  m_ring_buffer(STREAMBUFFERSIZE),
+  m_decode_buffer(new char[DECODECHUNKSIZE]),
+  m_fragment(new char[STREAMFRAGMENTSIZE]),
+  m_end_of_file(false),
+  m_decode_error(),
   m_fade_state(NoFading),
   m_fade_start_time(),
   m_fade_time(),
-  m_looping(false)
+  m_looping(false),
+  m_stopped(true)
 {
   alGenBuffers(STREAMFRAGMENTS, m_buffers);
   try
@@ -36,6 +47,7 @@ StreamSoundSource::StreamSoundSource() :
   {
     log_warning << e.what() << std::endl;
   }
+  m_free_buffers.assign(m_buffers, m_buffers + STREAMFRAGMENTS);
   //add me to update list
   SoundManager::current()->register_for_update( this );
 }
@@ -61,14 +73,36 @@ StreamSoundSource::~StreamSoundSource()
 void
 StreamSoundSource::set_sound_file(std::unique_ptr<SoundFile> newfile)
 {
+  // Keep the decoder thread away while the file is replaced
+  std::lock_guard<std::mutex> lock(SoundManager::current()->m_update_mutex);
+
   m_file = std::move(newfile);
+  m_ring_buffer.clear();
+  m_decode_error.clear();
+  m_end_of_file = false;
+
+  // Decode the first fragment here so that the sound can start right away,
+  // the decoder thread takes care of the rest
+  while (m_ring_buffer.get_read_available() < STREAMFRAGMENTSIZE && decode()) {}
+  if (!m_free_buffers.empty() && fillBufferAndQueue(m_free_buffers.back()))
+    m_free_buffers.pop_back();
+}
 
-  ALint queued;
-  alGetSourcei(m_source, AL_BUFFERS_QUEUED, &queued);
-  for (size_t i = 0; i < STREAMFRAGMENTS - queued; ++i) {
-    if (fillBufferAndQueue(m_buffers[i]) == false)
-      break;
-  }
+void
+StreamSoundSource::play()
+{
+  m_stopped = false;
+  queue_free_buffers();
+  OpenALSoundSource::play();
+}
+
+void
+StreamSoundSource::stop()
+{
+  m_stopped = true;
+  // Stopping detaches all the queued buffers from the source
+  OpenALSoundSource::stop();
+  m_free_buffers.assign(m_buffers, m_buffers + STREAMFRAGMENTS);
 }
 
 void
@@ -86,17 +120,27 @@ StreamSoundSource::update()
     catch(std::exception& e)
     {
       log_warning << e.what() << std::endl;
+      continue;
     }
 
-    if (fillBufferAndQueue(buffer) == false)
-      break;
+    m_free_buffers.push_back(buffer);
   }
 
-  if (!playing() && !paused()) {
-    if (processed == 0 || !m_looping)
+  queue_free_buffers();
+
+  if (m_end_of_file && !m_decode_error.empty()) {
+    log_warning << "Couldn't decode audio stream: " << m_decode_error << std::endl;
+    m_decode_error.clear();
+  }
+
+  if (!m_stopped && !playing() && !paused()) {
+    // OpenAL stops the source when it runs out of queued buffers, if
+    // the decoder caught up since, there's more to play
+    ALint queued = 0;
+    alGetSourcei(m_source, AL_BUFFERS_QUEUED, &queued);
+    if (queued == 0)
       return;
 
-    // we might have to restart the source if we had a buffer underrun
     log_info << "Restarting audio source because of buffer underrun" << std::endl;
     play();
   }
@@ -131,42 +175,76 @@ StreamSoundSource::set_fading(FadeState state, float fade_time_)
   m_fade_start_time = g_real_time;
 }
 
+void
+StreamSoundSource::queue_free_buffers()
+{
+  while (!m_free_buffers.empty() && fillBufferAndQueue(m_free_buffers.back()))
+    m_free_buffers.pop_back();
+}
+
 bool
-StreamSoundSource::fillBufferAndQueue(ALuint buffer)
+StreamSoundSource::decode()
 {
-  // fill buffer
-  std::unique_ptr<char[]> bufferdata(new char[STREAMFRAGMENTSIZE]);
+  if (!m_file || m_end_of_file)
+    return false;
+
+  if (m_ring_buffer.get_write_available() < DECODECHUNKSIZE)
+    return false;
+
   size_t bytesread = 0;
-  do {
-    bytesread += m_file->read(bufferdata.get() + bytesread,
-                            STREAMFRAGMENTSIZE - bytesread);
+  try
+  {
+    bytesread = m_file->read(m_decode_buffer.get(), DECODECHUNKSIZE);
     // end of sound file
-    if (bytesread < STREAMFRAGMENTSIZE) {
+    if (bytesread < DECODECHUNKSIZE) {
       if (m_looping)
         m_file->reset();
       else
-        break;
+        m_end_of_file = true;
     }
-  } while(bytesread < STREAMFRAGMENTSIZE);
+  }
+  catch(std::exception& e)
+  {
+    // Logging isn't thread-safe, update() reports the error
+    m_decode_error = e.what();
+    m_end_of_file = true;
+    return true;
+  }
 
-  if (bytesread > 0) {
-    ALenum format = SoundManager::get_sample_format(*m_file);
-    try
-    {
-      alBufferData(buffer, format, bufferdata.get(), static_cast<ALsizei>(bytesread), m_file->m_rate);
-      SoundManager::check_al_error("Couldn't refill audio buffer: ");
+  m_ring_buffer.write(m_decode_buffer.get(), bytesread);
+  return true;
+}
 
-      alSourceQueueBuffers(m_source, 1, &buffer);
-      SoundManager::check_al_error("Couldn't queue audio buffer: ");
-    }
-    catch(std::exception& e)
-    {
-      log_warning << e.what() << std::endl;
-    }
+bool
+StreamSoundSource::fillBufferAndQueue(ALuint buffer)
+{
+  if (!m_file)
+    return false;
+
+  // Only the last fragment of a sound may be shorter than the others
+  const bool end_of_file = m_end_of_file;
+  const size_t available = m_ring_buffer.get_read_available();
+  if (available == 0 || (available < STREAMFRAGMENTSIZE && !end_of_file))
+    return false;
+
+  size_t bytesread = m_ring_buffer.read(m_fragment.get(), STREAMFRAGMENTSIZE);
+
+  ALenum format = SoundManager::get_sample_format(*m_file);
+  try
+  {
+    alBufferData(buffer, format, m_fragment.get(), static_cast<ALsizei>(bytesread), m_file->m_rate);
+    SoundManager::check_al_error("Couldn't refill audio buffer: ");
+
+    alSourceQueueBuffers(m_source, 1, &buffer);
+    SoundManager::check_al_error("Couldn't queue audio buffer: ");
+  }
+  catch(std::exception& e)
+  {
+    log_warning << e.what() << std::endl;
+    return false;
   }
 
-  // return false if there aren't more buffers to fill
-  return bytesread >= STREAMFRAGMENTSIZE;
+  return true;
 }
 
 /* EOF */
@@ -17,7 +17,13 @@
 #ifndef HEADER_SUPERTUX_AUDIO_STREAM_SOUND_SOURCE_HPP
 #define HEADER_SUPERTUX_AUDIO_STREAM_SOUND_SOURCE_HPP
 
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "audio/openal_sound_source.hpp"
+#include "util/ring_buffer.hpp"
 
 class SoundFile;
 
@@ -27,6 +33,7 @@ private:
   static const size_t STREAMBUFFERSIZE = 1024 * 500;
   static const size_t STREAMFRAGMENTS = 5;
   static const size_t STREAMFRAGMENTSIZE = STREAMBUFFERSIZE / STREAMFRAGMENTS;
+  static const size_t DECODECHUNKSIZE = 1024 * 16;
 
 public:
   enum FadeState { NoFading, FadingOn, FadingOff, FadingPause, FadingResume };
@@ -35,6 +42,8 @@ public:
   StreamSoundSource();
   ~StreamSoundSource() override;
 
+  virtual void play() override;
+  virtual void stop() override;
   virtual void update() override;
   virtual void set_looping(bool looping_) override { m_looping = looping_; }
 
@@ -44,17 +53,41 @@ public:
   FadeState get_fade_state() const { return m_fade_state; }
   bool get_looping() const { return m_looping; }
 
+  /** Decodes the next chunk of the sound file into the ring buffer. Called
+      from the SoundManager's decoder thread with the update list locked.
+      Returns false if there was nothing to decode. */
+  bool decode();
+
 private:
+  /** Moves decoded samples from the ring buffer into an OpenAL buffer and
+      queues it. Returns false if not enough samples were decoded yet. */
   bool fillBufferAndQueue(ALuint buffer);
+  void queue_free_buffers();
 
 private:
   std::unique_ptr<SoundFile> m_file;
   ALuint m_buffers[STREAMFRAGMENTS];
 
+  /** Buffers that aren't queued on the source */
+  std::vector<ALuint> m_free_buffers;
+
+  /** Samples decoded by the decoder thread, waiting to be queued */
+  RingBuffer m_ring_buffer;
+  std::unique_ptr<char[]> m_decode_buffer;
+  std::unique_ptr<char[]> m_fragment;
+  std::atomic<bool> m_end_of_file;
+
+  /** Set by the decoder thread before m_end_of_file */
+  std::string m_decode_error;
+
   FadeState m_fade_state;
   float m_fade_start_time;
   float m_fade_time;
-  bool m_looping;
+  std::atomic<bool> m_looping;
+
+  /** false between play() and stop(), a source that stops on its own
+      in between ran out of buffers */
+  bool m_stopped;
 
 private:
   StreamSoundSource(const StreamSoundSource&) = delete;
@@ -28,6 +28,7 @@
 #include "object/water_drop.hpp"
 #include "sprite/sprite.hpp"
 #include "sprite/sprite_manager.hpp"
+#include "supertux/activation_region.hpp"
 #include "supertux/level.hpp"
 #include "supertux/sector.hpp"
 #include "supertux/tile.hpp"
@@ -38,9 +39,6 @@ static const float SQUISH_TIME = 2;
 static const float GEAR_TIME = 2;
 static const float BURN_TIME = 1;
 
-static const float X_OFFSCREEN_DISTANCE = 1280;
-static const float Y_OFFSCREEN_DISTANCE = 800;
-
 BadGuy::BadGuy(const Vector& pos, const std::string& sprite_name_, int layer_,
                const std::string& light_sprite_name) :
   BadGuy(pos, Direction::LEFT, sprite_name_, layer_, light_sprite_name)
@@ -70,7 +68,8 @@ BadGuy::BadGuy(const Vector& pos, Direction direction, const std::string& sprite
   m_state_timer(),
   m_on_ground_flag(false),
   m_floor_normal(0.0f, 0.0f),
-  m_colgroup_active(COLGROUP_MOVING)
+  m_colgroup_active(COLGROUP_MOVING),
+  m_sleeping(false)
 {
   SoundManager::current()->preload("sounds/squish.wav");
   SoundManager::current()->preload("sounds/fall.wav");
@@ -104,7 +103,8 @@ BadGuy::BadGuy(const ReaderMapping& reader, const std::string& sprite_name_, int
   m_state_timer(),
   m_on_ground_flag(false),
   m_floor_normal(0.0f, 0.0f),
-  m_colgroup_active(COLGROUP_MOVING)
+  m_colgroup_active(COLGROUP_MOVING),
+  m_sleeping(false)
 {
   std::string dir_str = "auto";
   reader.get("direction", dir_str);
@@ -150,9 +150,20 @@ BadGuy::draw(DrawingContext& context)
   }
 }
 
+void
+BadGuy::skip_draw()
+{
+  if (m_sprite.get() && m_state != STATE_INIT && m_state != STATE_INACTIVE)
+    m_sprite->update();
+}
+
 void
 BadGuy::update(float dt_sec)
 {
+  // The sector's activation region wakes us up once it gets close
+  if (m_sleeping)
+    return;
+
   if (!Sector::get().inside(m_col.m_bbox)) {
     auto this_portable = dynamic_cast<Portable*> (this);
     if (!this_portable || !this_portable->is_grabbed())
@@ -192,6 +203,8 @@ BadGuy::update(float dt_sec)
       m_is_active_flag = false;
       inactive_update(dt_sec);
       try_activate();
+      if ((m_state == STATE_INIT || m_state == STATE_INACTIVE) && !Editor::is_active())
+        Sector::get().get_activation_region().put_to_sleep(*this);
       break;
 
     case STATE_BURNING: {
@@ -517,7 +530,7 @@ BadGuy::kill_fall()
   if (!is_active()) return;
 
   if (m_frozen) {
-    SoundManager::current()->play("sounds/brick.wav");
+    SoundManager::current()->play("sounds/brick.wav", 0.5f, SoundManager::PRIORITY_LOW);
     Vector pr_pos(0.0f, 0.0f);
     float cx = m_col.m_bbox.get_width() / 2;
     float cy = m_col.m_bbox.get_height() / 2;
@@ -609,36 +622,18 @@ BadGuy::set_state(State state_)
 bool
 BadGuy::is_offscreen() const
 {
-  Vector cam_dist(0.0f, 0.0f);
-  Vector player_dist(0.0f, 0.0f);
-  Camera& cam = Sector::get().get_camera();
-  cam_dist = cam.get_center() - m_col.m_bbox.get_middle();
-  if (Editor::is_active()) {
-      if ((fabsf(cam_dist.x) <= X_OFFSCREEN_DISTANCE) && (fabsf(cam_dist.y) <= Y_OFFSCREEN_DISTANCE)) {
-        return false;
-    }
-  }
-  auto player = get_nearest_player();
-  if (!player)
-    return false;
-  if (!Editor::is_active()) {
-    player_dist = player->get_bbox().get_middle() - m_col.m_bbox.get_middle();
-  }
-  // In SuperTux 0.1.x, Badguys were activated when Tux<->Badguy center distance was approx. <= ~668px
-  // This doesn't work for wide-screen monitors which give us a virt. res. of approx. 1066px x 600px
-  if (((fabsf(player_dist.x) <= X_OFFSCREEN_DISTANCE) && (fabsf(player_dist.y) <= Y_OFFSCREEN_DISTANCE))
-      ||((fabsf(cam_dist.x) <= X_OFFSCREEN_DISTANCE) && (fabsf(cam_dist.y) <= Y_OFFSCREEN_DISTANCE))) {
+  // Nothing is offscreen in the editor
+  if (Editor::is_active())
     return false;
-  }
-  return true;
+
+  return !Sector::get().get_activation_region().contains(m_col.m_bbox.get_middle());
 }
 
 void
 BadGuy::try_activate()
 {
   // Don't activate if player is dying
-  auto player = get_nearest_player();
-  if (!player) return;
+  if (!Sector::get().get_activation_region().has_player()) return;
 
   if (!is_offscreen()) {
     set_state(STATE_ACTIVE);
@@ -33,6 +33,8 @@ class Bullet;
 class BadGuy : public MovingSprite,
                public ExposedObject<BadGuy, scripting::BadGuy>
 {
+  friend class ActivationRegion;
+
 public:
   BadGuy(const Vector& pos, const std::string& sprite_name, int layer = LAYER_OBJECTS,
          const std::string& light_sprite_name = "images/objects/lightmap_light/lightmap_light-medium.sprite");
@@ -44,6 +46,8 @@ public:
   /** Called when the badguy is drawn. The default implementation
       simply draws the badguy sprite on screen */
   virtual void draw(DrawingContext& context) override;
+  virtual bool draws_outside_bbox() const override { return m_glowing; }
+  virtual void skip_draw() override;
 
   /** Called each frame. The default implementation checks badguy
       state and calls active_update and inactive_update */
@@ -282,6 +286,10 @@ private:
   /** CollisionGroup the badguy should be in while active */
   CollisionGroup m_colgroup_active;
 
+  /** true while the badguy is inactive and waits in the sector's
+      ActivationRegion to be woken up; update() does nothing meanwhile */
+  bool m_sleeping;
+
 private:
   BadGuy(const BadGuy&) = delete;
   BadGuy& operator=(const BadGuy&) = delete;
@@ -34,6 +34,7 @@ public:
   virtual void activate() override;
   virtual void active_update(float dt_sec) override;
   virtual void draw(DrawingContext& context) override;
+  virtual bool draws_outside_bbox() const override { return true; }
 
   virtual bool collides(GameObject& other, const CollisionHit& hit) const override;
   virtual HitResponse collision(GameObject& other, const CollisionHit& hit) override;
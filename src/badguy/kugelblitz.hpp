@@ -35,6 +35,7 @@ public:
   virtual bool is_flammable() const override;
 
   virtual void draw(DrawingContext& context) override;
+  virtual bool draws_outside_bbox() const override { return true; }
   virtual std::string get_class() const override { return "kugelblitz"; }
   virtual std::string get_display_name() const override { return _("Kugelblitz"); }
 
@@ -242,7 +242,7 @@ MrIceBlock::set_state(IceState state_)
       m_physic.set_velocity_x(m_dir == Direction::LEFT ? -KICKSPEED : KICKSPEED);
       set_action(m_dir == Direction::LEFT ? "flat-left" : "flat-right", /* loops = */ -1);
       // we should slide above 1 block holes now...
-      m_col.m_bbox.set_size(34, 31.8f);
+      m_col.set_size(34, 31.8f);
       break;
     case ICESTATE_GRABBED:
       flat_timer.stop();
@@ -276,7 +276,7 @@ MrIceBlock::ungrab(MovingObject& object, Direction dir_)
   {
     //move icecube a little bit away as to not insta-kill Tux
     float swimangle = player->get_swimming_angle();
-    m_col.m_bbox.move(Vector(std::cos(swimangle) * 48.f, std::sin(swimangle) * 48.f));
+    m_col.set_pos(m_col.get_pos() + Vector(std::cos(swimangle) * 48.f, std::sin(swimangle) * 48.f));
   }
   if (dir_ == Direction::UP) {
     m_physic.set_velocity_y(-KICKSPEED);
@@ -86,7 +86,7 @@ RCrystallo::active_update(float dt_sec)
         player->get_bbox().get_middle() - Vector(0, 40), player))
     {
       //center enemy, begin falling
-      m_col.m_bbox.move(Vector(3.f, 0.f));
+      m_col.set_pos(m_col.get_pos() + Vector(3.f, 0.f));
       set_action(m_dir == Direction::LEFT ? "detected-left" : "detected-right", 1, ANCHOR_TOP);
       state = RCRYSTALLO_DETECT;
     }
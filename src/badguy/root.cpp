@@ -90,4 +90,11 @@ Root::draw(DrawingContext& context)
   if ((mystate != STATE_APPEARING) && (mystate != STATE_VANISHING)) BadGuy::draw(context);
 }
 
+void
+Root::skip_draw()
+{
+  base_sprite->update();
+  if ((mystate != STATE_APPEARING) && (mystate != STATE_VANISHING)) BadGuy::skip_draw();
+}
+
 /* EOF */
@@ -28,6 +28,7 @@ public:
   virtual void deactivate() override;
   virtual void active_update(float dt_sec) override;
   virtual void draw(DrawingContext& context) override;
+  virtual void skip_draw() override;
   virtual bool is_flammable() const override { return false; }
   virtual bool is_freezable() const override { return false; }
   virtual void kill_fall() override { }
@@ -36,6 +36,7 @@ public:
   virtual void kill_fall() override { vanish(); }
 
   virtual void draw(DrawingContext& context) override;
+  virtual bool draws_outside_bbox() const override { return true; }
 
   virtual void stop_looping_sounds() override;
   virtual void play_looping_sounds() override;
@@ -26,6 +26,7 @@ public:
   Yeti(const ReaderMapping& mapping);
 
   virtual void draw(DrawingContext& context) override;
+  virtual bool draws_outside_bbox() const override { return true; }
   virtual void initialize() override;
   virtual void active_update(float dt_sec) override;
   virtual void collision_solid(const CollisionHit& hit) override;
@@ -0,0 +1,220 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "collision/collision_grid.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "collision/collision_object.hpp"
+#include "math/rectf.hpp"
+#include "math/util.hpp"
+
+namespace {
+
+/** Objects spanning more cells than this go to the oversized list */
+const int MAX_OBJECT_CELLS = 64;
+
+/** Keeps cell coordinates well inside int range for objects that fell
+    out of the level or got bogus positions */
+const float MAX_COORDINATE = 1.0e8f;
+
+int to_cell(float v)
+{
+  if (std::isnan(v))
+    return 0;
+  return static_cast<int>(std::floor(math::clamp(v, -MAX_COORDINATE, MAX_COORDINATE) / CollisionGrid::CELL_SIZE));
+}
+
+uint64_t cell_key(int x, int y)
+{
+  return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+int cell_x(uint64_t key)
+{
+  return static_cast<int32_t>(static_cast<uint32_t>(key >> 32));
+}
+
+int cell_y(uint64_t key)
+{
+  return static_cast<int32_t>(static_cast<uint32_t>(key & 0xffffffff));
+}
+
+/** The area an object can touch during a collision pass */
+Rectf get_swept_rect(const Rectf& bbox, const Rectf& dest)
+{
+  return Rectf(std::min(bbox.get_left(), dest.get_left()),
+               std::min(bbox.get_top(), dest.get_top()),
+               std::max(bbox.get_right(), dest.get_right()),
+               std::max(bbox.get_bottom(), dest.get_bottom()));
+}
+
+} // namespace
+
+const float CollisionGrid::CELL_SIZE = 128.0f;
+
+CollisionGrid::CollisionGrid() :
+  m_cells(),
+  m_oversized_objects(),
+  m_dirty_objects(),
+  m_next_order(0)
+{
+}
+
+void
+CollisionGrid::insert(CollisionObject& object)
+{
+  object.m_grid = this;
+  object.m_grid_order = m_next_order++;
+  object.m_grid_dirty = false;
+  link(object, get_cell_range(get_swept_rect(object.m_bbox, object.m_dest)));
+}
+
+void
+CollisionGrid::remove(CollisionObject& object)
+{
+  unlink(object);
+
+  if (object.m_grid_dirty) {
+    m_dirty_objects.erase(std::remove(m_dirty_objects.begin(), m_dirty_objects.end(), &object),
+                          m_dirty_objects.end());
+  }
+
+  object.m_grid = nullptr;
+  object.m_grid_dirty = false;
+}
+
+void
+CollisionGrid::update(CollisionObject& object)
+{
+  const Rect cells = get_cell_range(get_swept_rect(object.m_bbox, object.m_dest));
+  if (cells == object.m_grid_cells)
+    return;
+
+  unlink(object);
+  link(object, cells);
+}
+
+void
+CollisionGrid::mark_dirty(CollisionObject& object)
+{
+  object.m_grid_dirty = true;
+  m_dirty_objects.push_back(&object);
+}
+
+void
+CollisionGrid::flush_dirty()
+{
+  for (auto* object : m_dirty_objects) {
+    object->m_grid_dirty = false;
+    update(*object);
+  }
+  m_dirty_objects.clear();
+}
+
+void
+CollisionGrid::query(const Rectf& rect, std::vector<CollisionObject*>& result)
+{
+  flush_dirty();
+
+  const size_t first = result.size();
+  const Rect range = get_cell_range(rect);
+
+  if (static_cast<size_t>(range.get_width()) * static_cast<size_t>(range.get_height()) > m_cells.size())
+  {
+    // Huge query rectangles, e.g. get_nearby_objects() with a large
+    // distance, are cheaper to answer by walking the occupied cells.
+    for (const auto& cell : m_cells) {
+      if (range.contains(cell_x(cell.first), cell_y(cell.first))) {
+        result.insert(result.end(), cell.second.begin(), cell.second.end());
+      }
+    }
+  }
+  else
+  {
+    for (int x = range.left; x < range.right; ++x) {
+      for (int y = range.top; y < range.bottom; ++y) {
+        auto it = m_cells.find(cell_key(x, y));
+        if (it != m_cells.end()) {
+          result.insert(result.end(), it->second.begin(), it->second.end());
+        }
+      }
+    }
+  }
+
+  result.insert(result.end(), m_oversized_objects.begin(), m_oversized_objects.end());
+
+  std::sort(result.begin() + first, result.end(),
+            [](const CollisionObject* lhs, const CollisionObject* rhs) {
+              return lhs->m_grid_order < rhs->m_grid_order;
+            });
+  result.erase(std::unique(result.begin() + first, result.end()), result.end());
+}
+
+Rect
+CollisionGrid::get_cell_range(const Rectf& rect) const
+{
+  return Rect(to_cell(rect.get_left()), to_cell(rect.get_top()),
+              to_cell(rect.get_right()) + 1, to_cell(rect.get_bottom()) + 1);
+}
+
+void
+CollisionGrid::link(CollisionObject& object, const Rect& cells)
+{
+  object.m_grid_cells = cells;
+  object.m_grid_oversized = (static_cast<int64_t>(cells.get_width()) * cells.get_height() > MAX_OBJECT_CELLS);
+
+  if (object.m_grid_oversized) {
+    m_oversized_objects.push_back(&object);
+    return;
+  }
+
+  for (int x = cells.left; x < cells.right; ++x) {
+    for (int y = cells.top; y < cells.bottom; ++y) {
+      m_cells[cell_key(x, y)].push_back(&object);
+    }
+  }
+}
+
+void
+CollisionGrid::unlink(CollisionObject& object)
+{
+  auto erase_from = [&object](std::vector<CollisionObject*>& objects) {
+    auto it = std::find(objects.begin(), objects.end(), &object);
+    if (it != objects.end()) {
+      *it = objects.back();
+      objects.pop_back();
+    }
+  };
+
+  if (object.m_grid_oversized) {
+    erase_from(m_oversized_objects);
+    return;
+  }
+
+  const Rect& cells = object.m_grid_cells;
+  for (int x = cells.left; x < cells.right; ++x) {
+    for (int y = cells.top; y < cells.bottom; ++y) {
+      auto it = m_cells.find(cell_key(x, y));
+      if (it != m_cells.end()) {
+        erase_from(it->second);
+      }
+    }
+  }
+}
+
+/* EOF */
@@ -0,0 +1,86 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_COLLISION_COLLISION_GRID_HPP
+#define HEADER_SUPERTUX_COLLISION_COLLISION_GRID_HPP
+
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+#include "math/rect.hpp"
+
+class CollisionObject;
+class Rectf;
+
+/** Uniform grid used as the broadphase of the CollisionSystem. Every
+    object is bucketed into the cells covered by the union of its
+    bbox and its anticipated destination, so a query returns a
+    superset of the objects that can possibly touch the given
+    rectangle. */
+class CollisionGrid final
+{
+public:
+  /** Size of a cell in pixels, four tiles wide */
+  static const float CELL_SIZE;
+
+public:
+  CollisionGrid();
+
+  void insert(CollisionObject& object);
+  void remove(CollisionObject& object);
+
+  /** Re-buckets the object if it moved to different cells */
+  void update(CollisionObject& object);
+
+  /** Queues an object whose bbox was changed from outside the
+      collision system, it gets re-bucketed before the next query */
+  void mark_dirty(CollisionObject& object);
+
+  /** Re-buckets all objects queued by mark_dirty() */
+  void flush_dirty();
+
+  /** Appends all objects whose cells overlap rect to result, sorted
+      by insertion order and without duplicates. The caller is
+      responsible for the exact intersection test. */
+  void query(const Rectf& rect, std::vector<CollisionObject*>& result);
+
+  /** Returns the cells touched by rect, right and bottom are exclusive */
+  Rect get_cell_range(const Rectf& rect) const;
+
+private:
+  void link(CollisionObject& object, const Rect& cells);
+  void unlink(CollisionObject& object);
+
+private:
+  std::unordered_map<uint64_t, std::vector<CollisionObject*> > m_cells;
+
+  /** Objects too large to be bucketed efficiently, e.g. level-wide
+      triggers, these are part of every query */
+  std::vector<CollisionObject*> m_oversized_objects;
+
+  std::vector<CollisionObject*> m_dirty_objects;
+
+  uint64_t m_next_order;
+
+private:
+  CollisionGrid(const CollisionGrid&) = delete;
+  CollisionGrid& operator=(const CollisionGrid&) = delete;
+};
+
+#endif
+
+/* EOF */
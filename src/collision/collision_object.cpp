@@ -17,6 +17,7 @@
 
 #include "collision/collision_object.hpp"
 
+#include "collision/collision_grid.hpp"
 #include "collision/collision_listener.hpp"
 #include "collision/collision_movement_manager.hpp"
 #include "supertux/game_object.hpp"
@@ -28,7 +29,14 @@ CollisionObject::CollisionObject(CollisionGroup group, CollisionListener& listen
   m_movement(0.0f, 0.0f),
   m_dest(),
   m_objects_hit_bottom(),
-  m_ground_movement_manager(nullptr)
+  m_carriers(),
+  m_ground_movement_manager(nullptr),
+  m_system_index(0),
+  m_grid(nullptr),
+  m_grid_cells(),
+  m_grid_order(0),
+  m_grid_oversized(false),
+  m_grid_dirty(false)
 {
 }
 
@@ -62,7 +70,8 @@ CollisionObject::collision_moving_object_bottom(CollisionObject& other)
   if (m_group == COLGROUP_STATIC
     || m_group == COLGROUP_MOVING_STATIC)
   {
-    m_objects_hit_bottom.insert(&other);
+    if (m_objects_hit_bottom.insert(&other).second)
+      other.m_carriers.insert(this);
   }
 }
 
@@ -75,9 +84,23 @@ CollisionObject::notify_object_removal(CollisionObject* other)
 void
 CollisionObject::clear_bottom_collision_list()
 {
+  for (CollisionObject* other_object : m_objects_hit_bottom) {
+    other_object->m_carriers.erase(this);
+  }
   m_objects_hit_bottom.clear();
 }
 
+void
+CollisionObject::release_references()
+{
+  for (CollisionObject* carrier : m_carriers) {
+    carrier->notify_object_removal(this);
+  }
+  m_carriers.clear();
+
+  clear_bottom_collision_list();
+}
+
 void CollisionObject::propagate_movement(const Vector& movement)
 {
   for (CollisionObject* other_object : m_objects_hit_bottom) {
@@ -86,6 +109,14 @@ void CollisionObject::propagate_movement(const Vector& movement)
   }
 }
 
+void
+CollisionObject::mark_grid_dirty()
+{
+  if (m_grid && !m_grid_dirty) {
+    m_grid->mark_dirty(*this);
+  }
+}
+
 bool
 CollisionObject::is_valid() const
 {
@@ -24,14 +24,17 @@
 
 #include "collision/collision_group.hpp"
 #include "collision/collision_hit.hpp"
+#include "math/rect.hpp"
 #include "math/rectf.hpp"
 
+class CollisionGrid;
 class CollisionListener;
 class CollisionGroundMovementManager;
 class GameObject;
 
 class CollisionObject
 {
+  friend class CollisionGrid;
   friend class CollisionSystem;
 
 public:
@@ -54,6 +57,8 @@ public:
   /** called when this object, if (moving) static, has collided on its top with a moving object */
   void collision_moving_object_bottom(CollisionObject& other);
 
+  /** called when other, which was touching the top of this object, is
+      removed */
   void notify_object_removal(CollisionObject* other);
 
   void set_ground_movement_manager(const std::shared_ptr<CollisionGroundMovementManager>& movement_manager)
@@ -88,6 +93,7 @@ public:
   {
     m_dest.move(pos - get_pos());
     m_bbox.set_pos(pos);
+    mark_grid_dirty();
   }
 
   Vector get_pos() const
@@ -110,6 +116,7 @@ public:
   {
     m_dest.set_width(w);
     m_bbox.set_width(w);
+    mark_grid_dirty();
   }
 
   /** sets the moving object's bbox to a specific size. Be careful
@@ -119,6 +126,7 @@ public:
   {
     m_dest.set_size(w, h);
     m_bbox.set_size(w, h);
+    mark_grid_dirty();
   }
 
   CollisionGroup get_group() const
@@ -133,6 +141,15 @@ public:
     return m_listener;
   }
 
+private:
+  /** Makes the objects this one touches, or that touch it, forget
+      about it, called when it is removed from the collision system */
+  void release_references();
+
+  /** Tells the broadphase grid that the bbox was changed outside of
+      the collision passes, so it can re-bucket the object lazily */
+  void mark_grid_dirty();
+
 private:
   CollisionListener& m_listener;
 
@@ -159,8 +176,22 @@ private:
       if this object was static or moving static. */
   std::unordered_set<CollisionObject*> m_objects_hit_bottom;
 
+  /** Objects that have this object in their m_objects_hit_bottom, only
+      those have to be notified when this object is removed */
+  std::unordered_set<CollisionObject*> m_carriers;
+
   std::shared_ptr<CollisionGroundMovementManager> m_ground_movement_manager;
 
+  /** Position in the object list of the CollisionSystem */
+  size_t m_system_index;
+
+  /** Broadphase bookkeeping, owned by CollisionGrid */
+  CollisionGrid* m_grid;
+  Rect m_grid_cells;
+  uint64_t m_grid_order;
+  bool m_grid_oversized;
+  bool m_grid_dirty;
+
 private:
   CollisionObject(const CollisionObject&) = delete;
   CollisionObject& operator=(const CollisionObject&) = delete;
@@ -17,6 +17,8 @@
 
 #include "collision/collision_system.hpp"
 
+#include <assert.h>
+
 #include "collision/collision.hpp"
 #include "collision/collision_movement_manager.hpp"
 #include "editor/editor.hpp"
@@ -25,8 +27,10 @@
 #include "object/player.hpp"
 #include "object/tilemap.hpp"
 #include "supertux/constants.hpp"
+#include "supertux/debug.hpp"
 #include "supertux/sector.hpp"
 #include "supertux/tile.hpp"
+#include "util/profiler.hpp"
 #include "video/color.hpp"
 #include "video/drawing_context.hpp"
 
@@ -39,7 +43,11 @@ const float MAX_SPEED = 16.0f;
 CollisionSystem::CollisionSystem(Sector& sector) :
   m_sector(sector),
   m_objects(),
-  m_ground_movement_manager(new CollisionGroundMovementManager)
+  m_removed_count(0),
+  m_grid(),
+  m_grid_active(g_debug.use_collision_broadphase),
+  m_ground_movement_manager(new CollisionGroundMovementManager),
+  m_pair_checks(0)
 {
 }
 
@@ -47,25 +55,54 @@ void
 CollisionSystem::add(CollisionObject* object)
 {
   object->set_ground_movement_manager(m_ground_movement_manager);
+  object->m_system_index = m_objects.size();
   m_objects.push_back(object);
+
+  // objects are usually placed by writing to the bbox directly, which
+  // leaves the destination behind and would bloat the grid cells
+  object->m_dest = object->get_bbox();
+  if (m_grid_active)
+    m_grid.insert(*object);
 }
 
 void
 CollisionSystem::remove(CollisionObject* object)
 {
-  m_objects.erase(
-    std::find(m_objects.begin(), m_objects.end(),
-              object));
-  
-  // FIXME: this is a patch. A better way of fixing this is coming.
-  for (auto* collision_object : m_objects) {
-    collision_object->notify_object_removal(object);
-  }
+  assert(object->m_system_index < m_objects.size() &&
+         m_objects[object->m_system_index] == object);
+
+  m_objects[object->m_system_index] = nullptr;
+  m_removed_count += 1;
+  if (m_grid_active)
+    m_grid.remove(*object);
+
+  // Only the objects it was touching keep pointers to it, tilemaps are
+  // few enough to be told in any case
+  object->release_references();
   for (auto* tilemap : m_sector.get_solid_tilemaps()) {
     tilemap->notify_object_removal(object);
   }
 }
 
+void
+CollisionSystem::flush_removals()
+{
+  if (m_removed_count == 0)
+    return;
+
+  size_t count = 0;
+  for (size_t i = 0; i < m_objects.size(); ++i)
+  {
+    CollisionObject* object = m_objects[i];
+    if (object) {
+      object->m_system_index = count;
+      m_objects[count++] = object;
+    }
+  }
+  m_objects.resize(count);
+  m_removed_count = 0;
+}
+
 void
 CollisionSystem::draw(DrawingContext& context)
 {
@@ -371,8 +408,12 @@ CollisionSystem::collision_static(collision::Constraints* constraints,
 {
   collision_tilemap(constraints, movement, dest, object);
 
+  // check_collisions() grows the other rectangle by EPSILON
+  std::vector<CollisionObject*> candidates;
+  get_candidates(dest.grown(EPSILON), candidates);
+
   // collision with other (static) objects
-  for (auto* static_object : m_objects)
+  for (auto* static_object : candidates)
   {
     if ((
           static_object->get_group() == COLGROUP_STATIC ||
@@ -381,6 +422,7 @@ CollisionSystem::collision_static(collision::Constraints* constraints,
         static_object->is_valid() &&
         static_object != &object)
     {
+      m_pair_checks += 1;
       collision::Constraints new_constraints = check_collisions(
         movement, dest, static_object->m_dest, &object, static_object);
 
@@ -512,6 +554,8 @@ CollisionSystem::collision_static_constrains(CollisionObject& object)
 void
 CollisionSystem::update()
 {
+  ProfileZone profile_zone("CollisionSystem::update");
+
   if (Editor::is_active()) {
     return;
     //Objects in editor shouldn't collide.
@@ -521,6 +565,11 @@ CollisionSystem::update()
 
   m_ground_movement_manager->apply_all_ground_movement();
 
+  m_pair_checks = 0;
+  sync_grid();
+  if (m_grid_active)
+    m_grid.flush_dirty();
+
   // calculate destination positions of the objects
   for (const auto& object : m_objects)
   {
@@ -534,6 +583,8 @@ CollisionSystem::update()
     object->m_dest = object->get_bbox();
     object->m_dest.move(object->get_movement());
     object->clear_bottom_collision_list();
+    if (m_grid_active)
+      m_grid.update(*object);
   }
 
   // part1: COLGROUP_MOVING vs COLGROUP_STATIC and tilemap
@@ -545,6 +596,8 @@ CollisionSystem::update()
       continue;
 
     collision_static_constrains(*object);
+    if (m_grid_active)
+      m_grid.update(*object);
   }
 
   // part2: COLGROUP_MOVING vs tile attributes
@@ -561,6 +614,8 @@ CollisionSystem::update()
     }
   }
 
+  std::vector<CollisionObject*> candidates;
+
   // part2.5: COLGROUP_MOVING vs COLGROUP_TOUCHABLE
   for (const auto& object : m_objects)
   {
@@ -569,11 +624,15 @@ CollisionSystem::update()
        || !object->is_valid())
       continue;
 
-    for (auto& object_2 : m_objects) {
+    candidates.clear();
+    get_candidates(object->m_dest, candidates);
+
+    for (auto& object_2 : candidates) {
       if (object_2->get_group() != COLGROUP_TOUCHABLE
          || !object_2->is_valid())
         continue;
 
+      m_pair_checks += 1;
       if (intersects(object->m_dest, object_2->m_dest)) {
         Vector normal(0.0f, 0.0f);
         CollisionHit hit;
@@ -591,23 +650,49 @@ CollisionSystem::update()
   }
 
   // part3: COLGROUP_MOVING vs COLGROUP_MOVING
-  for (auto i = m_objects.begin(); i != m_objects.end(); ++i)
+  for (auto* object : m_objects)
   {
-    auto object = *i;
-
     if ((object->get_group() != COLGROUP_MOVING
         && object->get_group() != COLGROUP_MOVING_STATIC)
        || !object->is_valid())
       continue;
 
-    for (auto i2 = i+1; i2 != m_objects.end(); ++i2) {
-      auto object_2 = *i2;
-      if ((object_2->get_group() != COLGROUP_MOVING
-          && object_2->get_group() != COLGROUP_MOVING_STATIC)
-         || !object_2->is_valid())
-        continue;
+    // Each pair is only handled once, by the object added first. The
+    // candidates come in the order of the object list.
+    // collision_object() pushes both objects apart, which can move
+    // object into cells that weren't part of the query, in that case
+    // the remaining candidates are fetched again.
+    size_t last_index = object->m_system_index;
+    bool refresh = true;
+    while (refresh)
+    {
+      refresh = false;
+      candidates.clear();
+      get_candidates(object->m_dest, candidates);
+      const Rect queried_cells = m_grid.get_cell_range(object->m_dest);
+
+      for (auto* object_2 : candidates) {
+        if (object_2->m_system_index <= last_index)
+          continue;
+        last_index = object_2->m_system_index;
+
+        if ((object_2->get_group() != COLGROUP_MOVING
+            && object_2->get_group() != COLGROUP_MOVING_STATIC)
+           || !object_2->is_valid())
+          continue;
 
-      collision_object(object, object_2);
+        m_pair_checks += 1;
+        collision_object(object, object_2);
+        if (!m_grid_active)
+          continue;
+
+        m_grid.update(*object);
+        m_grid.update(*object_2);
+        if (!queried_cells.contains(m_grid.get_cell_range(object->m_dest))) {
+          refresh = true;
+          break;
+        }
+      }
     }
   }
 
@@ -615,6 +700,8 @@ CollisionSystem::update()
   for (auto* object : m_objects) {
     object->m_bbox = object->m_dest;
     object->m_movement = Vector(0, 0);
+    if (m_grid_active)
+      m_grid.update(*object);
   }
 }
 
@@ -659,7 +746,10 @@ CollisionSystem::is_free_of_statics(const Rectf& rect, const CollisionObject* ig
 
   if (!is_free_of_tiles(rect, ignoreUnisolid)) return false;
 
-  for (const auto& object : m_objects) {
+  std::vector<CollisionObject*> candidates;
+  get_candidates(rect, candidates);
+
+  for (const auto& object : candidates) {
     if (object == ignore_object) continue;
     if (!object->is_valid()) continue;
     if (object->get_group() == COLGROUP_STATIC) {
@@ -677,7 +767,10 @@ CollisionSystem::is_free_of_movingstatics(const Rectf& rect, const CollisionObje
 
   if (!is_free_of_tiles(rect)) return false;
 
-  for (const auto& object : m_objects) {
+  std::vector<CollisionObject*> candidates;
+  get_candidates(rect, candidates);
+
+  for (const auto& object : candidates) {
     if (object == ignore_object) continue;
     if (!object->is_valid()) continue;
     if ((object->get_group() == COLGROUP_MOVING)
@@ -735,8 +828,17 @@ std::vector<CollisionObject*>
 CollisionSystem::get_nearby_objects (const Vector& center, float max_distance) const
 {
   std::vector<CollisionObject*> ret;
+  if (max_distance < 0.0f)
+    return ret;
 
-  for (const auto& object : m_objects) {
+  // the distance is measured to the middle of the bbox, which lies
+  // within the bbox, so any match overlaps this square
+  std::vector<CollisionObject*> candidates;
+  get_candidates(Rectf(center - Vector(max_distance, max_distance),
+                       center + Vector(max_distance, max_distance)),
+                 candidates);
+
+  for (const auto& object : candidates) {
     float distance = object->get_bbox().distance(center);
     if (distance <= max_distance)
       ret.push_back(object);
@@ -745,4 +847,36 @@ CollisionSystem::get_nearby_objects (const Vector& center, float max_distance) c
   return ret;
 }
 
+void
+CollisionSystem::sync_grid()
+{
+  if (m_grid_active == g_debug.use_collision_broadphase)
+    return;
+
+  m_grid_active = g_debug.use_collision_broadphase;
+  for (auto* object : m_objects)
+  {
+    if (!object)
+      continue;
+
+    if (m_grid_active)
+      m_grid.insert(*object);
+    else
+      m_grid.remove(*object);
+  }
+}
+
+void
+CollisionSystem::get_candidates(const Rectf& rect, std::vector<CollisionObject*>& result) const
+{
+  if (m_grid_active)
+  {
+    m_grid.query(rect, result);
+  }
+  else
+  {
+    result.insert(result.end(), m_objects.begin(), m_objects.end());
+  }
+}
+
 /* EOF */
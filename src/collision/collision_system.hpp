@@ -23,6 +23,7 @@
 #include <stdint.h>
 
 #include "collision/collision.hpp"
+#include "collision/collision_grid.hpp"
 #include "supertux/tile.hpp"
 #include "math/fwd.hpp"
 
@@ -38,8 +39,16 @@ public:
   CollisionSystem(Sector& sector);
 
   void add(CollisionObject* object);
+
+  /** Takes the object out of collision detection in constant time, its
+      slot in the object list is only dropped by flush_removals() */
   void remove(CollisionObject* object);
 
+  /** Drops the slots of the objects removed since the last call, keeping
+      the order of the remaining objects. Has to be called after a batch
+      of removals, before the objects are used again. */
+  void flush_removals();
+
   /** Draw collision shapes for debugging */
   void draw(DrawingContext& context);
 
@@ -60,6 +69,10 @@ public:
 
   std::vector<CollisionObject*> get_nearby_objects(const Vector& center, float max_distance) const;
 
+  /** Number of object pairs that went through the narrow phase during
+      the last update() */
+  size_t get_pair_check_count() const { return m_pair_checks; }
+
 private:
   /** Does collision detection of an object against all other static
       objects (and the tilemap) in the level. Collision response is
@@ -83,13 +96,33 @@ private:
 
   void collision_static_constrains(CollisionObject& object);
 
+  /** Collects the candidates for a collision with rect, either from
+      the grid or, with the broadphase disabled, all objects */
+  void get_candidates(const Rectf& rect, std::vector<CollisionObject*>& result) const;
+
+  /** Fills or empties the grid when the broadphase was toggled */
+  void sync_grid();
+
 private:
   Sector& m_sector;
 
+  /** Objects in the order they were added, removed objects leave a
+      nullptr until flush_removals() */
   std::vector<CollisionObject*>  m_objects;
+  size_t m_removed_count;
+
+  /** Broadphase, mutable as it re-buckets moved objects lazily on
+      queries */
+  mutable CollisionGrid m_grid;
+
+  /** Whether the objects are in m_grid, the grid is only kept up to
+      date while the broadphase is in use */
+  bool m_grid_active;
 
   std::shared_ptr<CollisionGroundMovementManager> m_ground_movement_manager;
 
+  size_t m_pair_checks;
+
 private:
   CollisionSystem(const CollisionSystem&) = delete;
   CollisionSystem& operator=(const CollisionSystem&) = delete;
@@ -23,6 +23,7 @@
 #include "control/input_manager.hpp"
 #include "editor/button_widget.hpp"
 #include "editor/layer_icon.hpp"
+#include "editor/marker_object.hpp"
 #include "editor/object_info.hpp"
 #include "editor/particle_editor.hpp"
 #include "editor/resize_marker.hpp"
@@ -753,6 +754,16 @@ Editor::delete_markers()
   m_overlay_widget->delete_markers();
 }
 
+void
+Editor::object_changed(GameObject& object)
+{
+  if (dynamic_cast<MarkerObject*>(&object)) {
+    m_overlay_widget->marker_changed();
+  } else {
+    m_undo_manager->object_changed(object);
+  }
+}
+
 void
 Editor::sort_layers()
 {
@@ -843,9 +854,13 @@ void
 Editor::undo()
 {
   log_info << "attempting undo" << std::endl;
-  auto level = m_undo_manager->undo();
-  if (level) {
-    set_level(std::move(level), false);
+  // markers point into the paths and objects that are about to change
+  delete_markers();
+  std::unique_ptr<Level> level;
+  if (m_undo_manager->undo(*m_level, level)) {
+    if (level) {
+      set_level(std::move(level), false);
+    }
     m_ignore_sector_change = true;
   } else {
     log_info << "undo failed" << std::endl;
@@ -856,9 +871,13 @@ void
 Editor::redo()
 {
   log_info << "attempting redo" << std::endl;
-  auto level = m_undo_manager->redo();
-  if (level) {
-    set_level(std::move(level), false);
+  // markers point into the paths and objects that are about to change
+  delete_markers();
+  std::unique_ptr<Level> level;
+  if (m_undo_manager->redo(*m_level, level)) {
+    if (level) {
+      set_level(std::move(level), false);
+    }
     m_ignore_sector_change = true;
   } else {
     log_info << "redo failed" << std::endl;
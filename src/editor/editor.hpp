@@ -123,6 +123,9 @@ public:
   void delete_markers();
   void sort_layers();
 
+  /** Tells the undo history which object the user just edited */
+  void object_changed(GameObject& object);
+
   void select_tilegroup(int id);
   const std::vector<Tilegroup>& get_tilegroups() const;
   void change_tileset();
@@ -85,6 +85,7 @@ ObjectMenu::on_back_action()
   BIND_SECTOR(*m_editor.get_sector());
 
   m_object->after_editor_set();
+  m_editor.object_changed(*m_object);
 
   m_editor.m_reactivate_request = true;
   if (!dynamic_cast<MovingObject*>(m_object)) {
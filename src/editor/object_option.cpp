@@ -16,6 +16,7 @@
 
 #include "editor/object_option.hpp"
 
+#include <algorithm>
 #include <string>
 #include <utility>
 
@@ -24,8 +25,10 @@
 
 #include "editor/object_menu.hpp"
 #include "gui/menu.hpp"
+#include "object/path.hpp"
 #include "object/tilemap.hpp"
 #include "util/gettext.hpp"
+#include "util/reader_mapping.hpp"
 #include "util/writer.hpp"
 #include "video/color.hpp"
 
@@ -79,6 +82,12 @@ BoolObjectOption::save(Writer& writer) const
   }
 }
 
+void
+BoolObjectOption::parse(const ReaderMapping& reader)
+{
+  reader.get(get_key().c_str(), *m_pointer, m_default_value);
+}
+
 std::string
 BoolObjectOption::to_string() const
 {
@@ -106,6 +115,12 @@ IntObjectOption::save(Writer& writer) const
   }
 }
 
+void
+IntObjectOption::parse(const ReaderMapping& reader)
+{
+  reader.get(get_key().c_str(), *m_pointer, m_default_value);
+}
+
 std::string
 IntObjectOption::to_string() const
 {
@@ -195,6 +210,12 @@ FloatObjectOption::save(Writer& writer) const
   }
 }
 
+void
+FloatObjectOption::parse(const ReaderMapping& reader)
+{
+  reader.get(get_key().c_str(), *m_pointer, m_default_value);
+}
+
 std::string
 FloatObjectOption::to_string() const
 {
@@ -228,6 +249,14 @@ StringObjectOption::save(Writer& writer) const
   }
 }
 
+void
+StringObjectOption::parse(const ReaderMapping& reader)
+{
+  if (!reader.get(get_key().c_str(), *m_pointer)) {
+    *m_pointer = m_default_value ? *m_default_value : "";
+  }
+}
+
 std::string
 StringObjectOption::to_string() const
 {
@@ -263,6 +292,12 @@ StringSelectObjectOption::save(Writer& writer) const
   }
 }
 
+void
+StringSelectObjectOption::parse(const ReaderMapping& reader)
+{
+  reader.get(get_key().c_str(), *m_pointer, m_default_value);
+}
+
 std::string
 StringSelectObjectOption::to_string() const
 {
@@ -311,6 +346,20 @@ EnumObjectOption::save(Writer& writer) const
   }
 }
 
+void
+EnumObjectOption::parse(const ReaderMapping& reader)
+{
+  std::string symbol;
+  if (reader.get(get_key().c_str(), symbol)) {
+    auto it = std::find(m_symbols.begin(), m_symbols.end(), symbol);
+    if (it != m_symbols.end()) {
+      *m_pointer = static_cast<int>(it - m_symbols.begin());
+    }
+  } else if (m_default_value) {
+    *m_pointer = *m_default_value;
+  }
+}
+
 std::string
 EnumObjectOption::to_string() const
 {
@@ -350,6 +399,14 @@ ScriptObjectOption::save(Writer& writer) const
   }
 }
 
+void
+ScriptObjectOption::parse(const ReaderMapping& reader)
+{
+  if (!reader.get(get_key().c_str(), *m_pointer)) {
+    m_pointer->clear();
+  }
+}
+
 std::string
 ScriptObjectOption::to_string() const
 {
@@ -395,6 +452,14 @@ FileObjectOption::save(Writer& writer) const
   }
 }
 
+void
+FileObjectOption::parse(const ReaderMapping& reader)
+{
+  if (!reader.get(get_key().c_str(), *m_pointer)) {
+    *m_pointer = m_default_value ? *m_default_value : "";
+  }
+}
+
 std::string
 FileObjectOption::to_string() const
 {
@@ -433,6 +498,17 @@ ColorObjectOption::save(Writer& writer) const
   }
 }
 
+void
+ColorObjectOption::parse(const ReaderMapping& reader)
+{
+  std::vector<float> vec;
+  if (reader.get(get_key().c_str(), vec)) {
+    *m_pointer = Color(vec);
+  } else if (m_default_value) {
+    *m_pointer = *m_default_value;
+  }
+}
+
 std::string
 ColorObjectOption::to_string() const
 {
@@ -460,6 +536,12 @@ BadGuySelectObjectOption::save(Writer& writer) const
   }
 }
 
+void
+BadGuySelectObjectOption::parse(const ReaderMapping& reader)
+{
+  reader.get(get_key().c_str(), *m_pointer);
+}
+
 std::string
 BadGuySelectObjectOption::to_string() const
 {
@@ -511,6 +593,18 @@ PathObjectOption::save(Writer& write) const
   m_path->save(write);
 }
 
+void
+PathObjectOption::parse(const ReaderMapping& reader)
+{
+  // an invalid path isn't saved at all
+  m_path->m_nodes.clear();
+
+  boost::optional<ReaderMapping> path_mapping;
+  if (reader.get("path", path_mapping)) {
+    m_path->read(*path_mapping);
+  }
+}
+
 std::string
 PathObjectOption::to_string() const
 {
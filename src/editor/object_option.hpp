@@ -41,6 +41,7 @@ class Value;
 class Color;
 class Menu;
 class Path;
+class ReaderMapping;
 class Rectf;
 class TileMap;
 class Writer;
@@ -55,6 +56,12 @@ public:
   virtual std::string to_string() const = 0;
   virtual void add_to_menu(Menu& menu) const = 0;
 
+  /** Reads back what save() wrote, an absent key restores the default.
+      Only available if can_parse() is true, the editor uses it to undo
+      changes to single options without reloading the level. */
+  virtual void parse(const ReaderMapping& reader) {}
+  virtual bool can_parse() const { return false; }
+
   const std::string& get_key() const { return m_key; }
   const std::string& get_text() const { return m_text; }
   unsigned int get_flags() const { return m_flags; }
@@ -79,6 +86,8 @@ public:
   virtual void save(Writer& write) const override;
   virtual std::string to_string() const override;
   virtual void add_to_menu(Menu& menu) const override;
+  virtual void parse(const ReaderMapping& reader) override;
+  virtual bool can_parse() const override { return true; }
 
 private:
   bool* const m_pointer;
@@ -99,6 +108,8 @@ public:
   virtual void save(Writer& write) const override;
   virtual std::string to_string() const override;
   virtual void add_to_menu(Menu& menu) const override;
+  virtual void parse(const ReaderMapping& reader) override;
+  virtual bool can_parse() const override { return true; }
 
 private:
   int* const m_pointer;
@@ -154,6 +165,8 @@ public:
   virtual void save(Writer& write) const override;
   virtual std::string to_string() const override;
   virtual void add_to_menu(Menu& menu) const override;
+  virtual void parse(const ReaderMapping& reader) override;
+  virtual bool can_parse() const override { return true; }
 
 private:
   float* const m_pointer;
@@ -174,6 +187,8 @@ public:
   virtual void save(Writer& write) const override;
   virtual std::string to_string() const override;
   virtual void add_to_menu(Menu& menu) const override;
+  virtual void parse(const ReaderMapping& reader) override;
+  virtual bool can_parse() const override { return true; }
 
 private:
   std::string* const m_pointer;
@@ -194,6 +209,8 @@ public:
   virtual void save(Writer& write) const override;
   virtual std::string to_string() const override;
   virtual void add_to_menu(Menu& menu) const override;
+  virtual void parse(const ReaderMapping& reader) override;
+  virtual bool can_parse() const override { return true; }
 
 private:
   int* const m_pointer;
@@ -217,6 +234,8 @@ public:
   virtual void save(Writer& write) const override;
   virtual std::string to_string() const override;
   virtual void add_to_menu(Menu& menu) const override;
+  virtual void parse(const ReaderMapping& reader) override;
+  virtual bool can_parse() const override { return true; }
 
 private:
   int* const m_pointer;
@@ -238,6 +257,8 @@ public:
   virtual void save(Writer& write) const override;
   virtual std::string to_string() const override;
   virtual void add_to_menu(Menu& menu) const override;
+  virtual void parse(const ReaderMapping& reader) override;
+  virtual bool can_parse() const override { return true; }
 
 private:
   std::string* const m_pointer;
@@ -260,6 +281,8 @@ public:
   virtual void save(Writer& write) const override;
   virtual std::string to_string() const override;
   virtual void add_to_menu(Menu& menu) const override;
+  virtual void parse(const ReaderMapping& reader) override;
+  virtual bool can_parse() const override { return true; }
 
 private:
   std::string* const m_pointer;
@@ -282,6 +305,8 @@ public:
   virtual void save(Writer& write) const override;
   virtual std::string to_string() const override;
   virtual void add_to_menu(Menu& menu) const override;
+  virtual void parse(const ReaderMapping& reader) override;
+  virtual bool can_parse() const override { return true; }
 
 private:
   Color* const m_pointer;
@@ -302,6 +327,8 @@ public:
   virtual void save(Writer& write) const override;
   virtual std::string to_string() const override;
   virtual void add_to_menu(Menu& menu) const override;
+  virtual void parse(const ReaderMapping& reader) override;
+  virtual bool can_parse() const override { return true; }
 
 private:
   std::vector<std::string>* const m_pointer;
@@ -338,6 +365,8 @@ public:
   virtual void save(Writer& write) const override;
   virtual std::string to_string() const override;
   virtual void add_to_menu(Menu& menu) const override;
+  virtual void parse(const ReaderMapping& reader) override;
+  virtual bool can_parse() const override { return true; }
 
 private:
   Path* m_path;
@@ -16,6 +16,9 @@
 
 #include "editor/overlay_widget.hpp"
 
+#include <map>
+#include <vector>
+
 #include "util/reader_document.hpp"
 #include "util/reader_mapping.hpp"
 #include "util/writer.hpp"
@@ -306,14 +309,53 @@ EditorOverlayWidget::draw_rectangle()
   bool sgn_x = m_drag_start.x < m_sector_pos.x;
   bool sgn_y = m_drag_start.y < m_sector_pos.y;
 
+  const int left = static_cast<int>(dr.get_left());
+  const int top = static_cast<int>(dr.get_top());
+  const int width = static_cast<int>(dr.get_right()) - left + 1;
+  const int height = static_cast<int>(dr.get_bottom()) - top + 1;
+  auto tiles = m_editor.get_tiles();
+
+  // Cells around the rectangle that need autotiling, per brush tile placed next to them
+  std::map<uint32_t, std::vector<bool>> autotile_cells;
+
   int x_ = sgn_x ? 0 : static_cast<int>(-dr.get_width());
-  for (int x = static_cast<int>(dr.get_left()); x <= static_cast<int>(dr.get_right()); x++, x_++) {
+  for (int x = 0; x < width; x++, x_++) {
     int y_ = sgn_y ? 0 : static_cast<int>(-dr.get_height());
-    for (int y = static_cast<int>(dr.get_top()); y <= static_cast<int>(dr.get_bottom()); y++, y_++) {
-      if (autotile_mode) {
-        input_autotile( Vector(static_cast<float>(x), static_cast<float>(y)), m_editor.get_tiles()->pos(x_, y_) );
-      } else {
-        input_tile( Vector(static_cast<float>(x), static_cast<float>(y)), m_editor.get_tiles()->pos(x_, y_) );
+    for (int y = 0; y < height; y++, y_++) {
+      const uint32_t tile = tiles->pos(x_, y_);
+      input_tile(Vector(static_cast<float>(left + x), static_cast<float>(top + y)), tile);
+
+      if (autotile_mode && (tiles->m_width > 1 || tiles->m_height > 1)) {
+        auto& cells = autotile_cells[tile];
+        cells.resize((width + 2) * (height + 2));
+        for (int ny = y; ny <= y + 2; ny++) {
+          for (int nx = x; nx <= x + 2; nx++) {
+            cells[ny * (width + 2) + nx] = true;
+          }
+        }
+      }
+    }
+  }
+
+  // Autotile once after all tiles are placed
+  auto tilemap = m_editor.get_selected_tilemap();
+  if (!autotile_mode || !tilemap) {
+    return;
+  }
+
+  if (autotile_cells.empty()) {
+    // Single tile brush: the whole rectangle and its border use the same tile
+    tilemap->autotile_region(Rect(left - 1, top - 1, left + width + 1, top + height + 1),
+                             tiles->pos(0, 0));
+    return;
+  }
+
+  for (const auto& it : autotile_cells) {
+    for (int y = 0; y < height + 2; y++) {
+      for (int x = 0; x < width + 2; x++) {
+        if (it.second[y * (width + 2) + x]) {
+          tilemap->autotile_region(Rect(left - 1 + x, top - 1 + y, left + x, top + y), it.first);
+        }
       }
     }
   }
@@ -629,6 +671,7 @@ EditorOverlayWidget::move_object()
     //}
 
     m_dragged_object->move_to(new_pos);
+    m_editor.object_changed(*m_dragged_object);
   }
 }
 
@@ -640,6 +683,7 @@ EditorOverlayWidget::rubber_object()
   }
   if (m_dragged_object) {
     m_dragged_object->editor_delete();
+    m_editor.object_changed(*m_dragged_object);
   }
   m_last_node_marker = nullptr;
 }
@@ -673,6 +717,22 @@ EditorOverlayWidget::update_node_iterators()
   }
 }
 
+void
+EditorOverlayWidget::marker_changed()
+{
+  if (m_selected_object && m_selected_object->is_valid()) {
+    m_editor.object_changed(*m_selected_object);
+  }
+
+  if (m_edited_path) {
+    for (auto& path_object : m_editor.get_sector()->get_objects_by_type<PathGameObject>()) {
+      if (&path_object.get_path() == m_edited_path) {
+        m_editor.object_changed(path_object);
+      }
+    }
+  }
+}
+
 void
 EditorOverlayWidget::add_path_node()
 {
@@ -691,6 +751,7 @@ EditorOverlayWidget::add_path_node()
   update_node_iterators();
   new_marker.update_node_times();
   m_editor.get_sector()->flush_game_objects();
+  marker_changed();
 
   // This will ensure that we will hover NodeMarkers in priority before BezierMarkers
   hover_object();
@@ -68,6 +68,9 @@ public:
   void update_pos();
   void delete_markers();
   void update_node_iterators();
+
+  /** Reports the objects the markers edit to the undo history */
+  void marker_changed();
   void on_level_change();
 
   void edit_path(Path* path, GameObject* new_marked_object = nullptr);
@@ -0,0 +1,186 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "editor/undo_journal.hpp"
+
+#include <algorithm>
+#include <assert.h>
+#include <iostream>
+
+#include "util/log.hpp"
+
+const int UndoJournal::CHECKPOINT_INTERVAL = 25;
+
+UndoJournal::UndoJournal(size_t max_entries, size_t max_memory) :
+  m_max_entries(max_entries),
+  m_max_memory(max_memory),
+  m_undo_stack(),
+  m_redo_stack()
+{
+}
+
+void
+UndoJournal::record(Entry entry, const std::function<std::string ()>& save)
+{
+  if (entry.diffable)
+  {
+    int deltas = 0;
+    for (auto it = m_undo_stack.rbegin(); it != m_undo_stack.rend() && it->snapshot.empty(); ++it)
+      deltas += 1;
+
+    if (deltas + 1 >= CHECKPOINT_INTERVAL)
+      entry.snapshot = save();
+  }
+  else
+  {
+    entry.snapshot = save();
+    entry.tiles.clear();
+    entry.objects.clear();
+  }
+
+  log_info << (entry.diffable ? "recording delta" : "doing snapshot") << std::endl;
+
+  m_redo_stack.clear();
+  m_undo_stack.push_back(std::move(entry));
+
+  cleanup();
+
+  debug_print("snapshot");
+}
+
+bool
+UndoJournal::undo(const ApplyFunc& apply, const LoadFunc& load)
+{
+  if (m_undo_stack.size() < 2) return false;
+
+  Entry entry = std::move(m_undo_stack.back());
+  m_undo_stack.pop_back();
+
+  if (entry.diffable)
+  {
+    apply(entry, false);
+  }
+  else
+  {
+    // Rebuild the previous state from the last saved level and the
+    // deltas recorded since
+    auto base = std::find_if(m_undo_stack.rbegin(), m_undo_stack.rend(),
+                             [](const Entry& e) {
+                               return !e.snapshot.empty();
+                             });
+    assert(base != m_undo_stack.rend());
+
+    load(base->snapshot);
+    for (auto it = base.base(); it != m_undo_stack.end(); ++it) {
+      apply(*it, true);
+    }
+  }
+
+  m_redo_stack.push_back(std::move(entry));
+
+  debug_print("undo");
+
+  return true;
+}
+
+bool
+UndoJournal::redo(const ApplyFunc& apply, const LoadFunc& load)
+{
+  if (m_redo_stack.empty()) return false;
+
+  Entry entry = std::move(m_redo_stack.back());
+  m_redo_stack.pop_back();
+
+  if (entry.diffable)
+  {
+    apply(entry, true);
+  }
+  else
+  {
+    load(entry.snapshot);
+  }
+
+  m_undo_stack.push_back(std::move(entry));
+
+  debug_print("redo");
+
+  return true;
+}
+
+void
+UndoJournal::cleanup()
+{
+  while (m_undo_stack.size() > m_max_entries ||
+         get_memory_usage() > m_max_memory)
+  {
+    // The oldest entry is the base everything else is replayed on, so
+    // it always has to carry a snapshot
+    auto next = std::find_if(m_undo_stack.begin() + 1, m_undo_stack.end(),
+                             [](const Entry& entry) {
+                               return !entry.snapshot.empty();
+                             });
+    if (next == m_undo_stack.end())
+      break;
+
+    m_undo_stack.erase(m_undo_stack.begin(), next);
+  }
+}
+
+size_t
+UndoJournal::get_memory_usage() const
+{
+  size_t usage = 0;
+  for (const auto* stack : { &m_undo_stack, &m_redo_stack }) {
+    for (const auto& entry : *stack) {
+      usage += sizeof(Entry) + entry.snapshot.size();
+      for (const auto& delta : entry.objects) {
+        usage += sizeof(ObjectDelta) + delta.old_settings.size() + delta.new_settings.size();
+        for (const auto& key : delta.keys) {
+          usage += sizeof(std::string) + key.size();
+        }
+      }
+      for (const auto& delta : entry.tiles) {
+        usage += sizeof(TileDelta) + delta.changes.size() * sizeof(TileMap::TileChange);
+      }
+    }
+  }
+  return usage;
+}
+
+void
+UndoJournal::debug_print(const char* action) const
+{
+#if 0
+  std::cout << action << std::endl;
+  std::cout << "undo_stack: ";
+  for(size_t i = 0; i < m_undo_stack.size(); ++i) {
+    std::cout << (m_undo_stack[i].diffable ? "d" : "s")
+              << (m_undo_stack[i].snapshot.empty() ? "" : "*") << " ";
+  }
+  std::cout << std::endl;
+
+  std::cout << "redo_stack: ";
+  for(size_t i = 0; i < m_redo_stack.size(); ++i) {
+    std::cout << (m_redo_stack[i].diffable ? "d" : "s")
+              << (m_redo_stack[i].snapshot.empty() ? "" : "*") << " ";
+  }
+  std::cout << std::endl;
+  std::cout << "memory: " << get_memory_usage() << std::endl;
+  std::cout << std::endl;
+#endif
+}
+
+/* EOF */
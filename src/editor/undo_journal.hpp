@@ -0,0 +1,117 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_EDITOR_UNDO_JOURNAL_HPP
+#define HEADER_SUPERTUX_EDITOR_UNDO_JOURNAL_HPP
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "math/rectf.hpp"
+#include "object/tilemap.hpp"
+
+/** Undo and redo stacks of the editor. The journal doesn't touch the
+    level itself, it decides when the level has to be saved along with
+    a change and what has to be replayed to undo or redo one. */
+class UndoJournal final
+{
+public:
+  /** Objects are identified by the index of their sector and their
+      position in the order in which the sector saves them */
+  struct TileDelta
+  {
+    size_t sector;
+    size_t object;
+    std::vector<TileMap::TileChange> changes;
+  };
+
+  struct ObjectDelta
+  {
+    size_t sector;
+    size_t object;
+    Rectf old_bbox;
+    Rectf new_bbox;
+
+    /** The options that changed and what they saved before and after
+        the change, empty if only the bbox changed */
+    std::vector<std::string> keys;
+    std::string old_settings;
+    std::string new_settings;
+  };
+
+  struct Entry
+  {
+    /** false if the change could only be recorded as a snapshot */
+    bool diffable;
+    std::vector<TileDelta> tiles;
+    std::vector<ObjectDelta> objects;
+
+    /** The level after the change, set for all snapshots and for every
+        few diffable entries, so that undoing a snapshot only has to
+        replay the deltas since the last one */
+    std::string snapshot;
+  };
+
+  /** Applies the deltas of an entry to the current level, forwards
+      to redo them or backwards to undo them */
+  typedef std::function<void (const Entry& entry, bool forward)> ApplyFunc;
+
+  /** Replaces the current level with a saved one */
+  typedef std::function<void (const std::string& snapshot)> LoadFunc;
+
+  /** Number of diffable entries after which the level is saved along
+      with the deltas, bounds the replay needed to undo a snapshot */
+  static const int CHECKPOINT_INTERVAL;
+
+public:
+  UndoJournal(size_t max_entries, size_t max_memory);
+
+  bool empty() const { return m_undo_stack.empty(); }
+
+  /** Pushes a change onto the undo stack and forgets the redo stack,
+      save is called when the entry has to carry a snapshot */
+  void record(Entry entry, const std::function<std::string ()>& save);
+
+  /** Reverts the last change. Diffable entries are undone in place,
+      for snapshots the last saved level is loaded and the deltas
+      recorded since are replayed on it. Returns false if there is
+      nothing to undo. */
+  bool undo(const ApplyFunc& apply, const LoadFunc& load);
+  bool redo(const ApplyFunc& apply, const LoadFunc& load);
+
+  const std::vector<Entry>& get_undo_stack() const { return m_undo_stack; }
+  const std::vector<Entry>& get_redo_stack() const { return m_redo_stack; }
+  size_t get_memory_usage() const;
+
+private:
+  void cleanup();
+  void debug_print(const char* action) const;
+
+private:
+  size_t m_max_entries;
+  size_t m_max_memory;
+  std::vector<Entry> m_undo_stack;
+  std::vector<Entry> m_redo_stack;
+
+private:
+  UndoJournal(const UndoJournal&) = delete;
+  UndoJournal& operator=(const UndoJournal&) = delete;
+};
+
+#endif
+
+/* EOF */
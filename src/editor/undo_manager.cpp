@@ -16,125 +16,407 @@
 
 #include "editor/undo_manager.hpp"
 
+#include <algorithm>
 #include <sstream>
-#include <iostream>
 
-#include "editor/editor.hpp"
+#include "editor/object_option.hpp"
+#include "editor/object_settings.hpp"
+#include "supertux/d_scope.hpp"
 #include "supertux/level.hpp"
 #include "supertux/level_parser.hpp"
+#include "supertux/moving_object.hpp"
+#include "supertux/sector.hpp"
 #include "util/log.hpp"
+#include "util/reader_document.hpp"
 #include "util/reader_mapping.hpp"
+#include "util/writer.hpp"
 
 UndoManager::UndoManager() :
-  m_max_snapshots(100),
   m_index_pos(),
-  m_undo_stack(),
-  m_redo_stack()
+  m_state(),
+  m_changed_objects(),
+  m_journal(100, 32 * 1024 * 1024)
 {
 }
 
 void
 UndoManager::try_snapshot(Level& level)
 {
-  std::ostringstream out;
-  level.save(out);
-  std::string level_snapshot = out.str();
+  UndoJournal::Entry entry{};
+  entry.diffable = !m_journal.empty() && update_state(level, entry.objects);
+  m_changed_objects.clear();
 
-  if (m_undo_stack.empty())
-  {
-    push_undo_stack(std::move(level_snapshot));
+  if (!entry.diffable) {
+    m_state = capture(level);
   }
-  else if (level_snapshot == m_undo_stack.back())
+  entry.tiles = take_tile_changes();
+
+  if (entry.diffable && entry.tiles.empty() && entry.objects.empty())
   {
     log_debug << "skipping snapshot as nothing has changed" << std::endl;
+    return;
   }
-  else // level_snapshot changed
+
+  m_journal.record(std::move(entry), [&level] {
+                     std::ostringstream out;
+                     level.save(out);
+                     return out.str();
+                   });
+  m_index_pos += 1;
+}
+
+void
+UndoManager::object_changed(GameObject& object)
+{
+  m_changed_objects.insert(&object);
+}
+
+bool
+UndoManager::update_state(Level& level, std::vector<UndoJournal::ObjectDelta>& deltas)
+{
+  if (capture_text(level) != m_state.text ||
+      level.m_sectors.size() != m_state.sectors.size())
+    return false;
+
+  for (size_t s = 0; s < level.m_sectors.size(); ++s)
   {
-    push_undo_stack(std::move(level_snapshot));
+    const auto& sector = *level.m_sectors[s];
+    auto& sector_state = m_state.sectors[s];
+    if (&sector != sector_state.sector ||
+        sector.get_change_count() != sector_state.change_count ||
+        capture_text(sector) != sector_state.text)
+      return false;
+
+    // only the objects the editor reported get saved again, for all
+    // others a change of the bbox or the tilemap size is all that can
+    // happen without going through the object menu
+    for (size_t o = 0; o < sector_state.objects.size(); ++o)
+    {
+      auto& state = sector_state.objects[o];
+      if (state.tilemap &&
+          (state.tilemap->get_width() != state.width ||
+           state.tilemap->get_height() != state.height))
+        return false;
+
+      UndoJournal::ObjectDelta delta{ s, o, state.bbox, state.moving ? state.moving->get_bbox() : Rectf(), {}, {}, {} };
+
+      if (m_changed_objects.count(state.object))
+      {
+        auto options = capture_options(*state.object, state.moving != nullptr, state.tilemap != nullptr);
+        if (options.size() != state.options.size())
+          return false;
+
+        for (size_t i = 0; i < options.size(); ++i)
+        {
+          if (options[i].text == state.options[i].text)
+            continue;
+
+          if (!options[i].parseable || options[i].key != state.options[i].key)
+            return false;
+
+          delta.keys.push_back(options[i].key);
+          delta.old_settings += state.options[i].text;
+          delta.new_settings += options[i].text;
+        }
+        state.options = std::move(options);
+      }
+
+      if (!(delta.old_bbox == delta.new_bbox) || !delta.keys.empty()) {
+        state.bbox = delta.new_bbox;
+        deltas.push_back(std::move(delta));
+      }
+    }
   }
+
+  return true;
 }
 
 void
-UndoManager::debug_print(const char* action)
+UndoManager::update_objects(const UndoJournal::Entry& entry)
 {
-#if 0
-  std::cout << action << std::endl;
-  std::cout << "undo_stack: ";
-  for(size_t i = 0; i < m_undo_stack.size(); ++i) {
-    std::cout << static_cast<const void*>(m_undo_stack[i].data()) << " ";
-  }
-  std::cout << std::endl;
+  for (const auto& delta : entry.objects)
+  {
+    if (delta.sector >= m_state.sectors.size() ||
+        delta.object >= m_state.sectors[delta.sector].objects.size())
+      continue;
 
-  std::cout << "redo_stack: ";
-  for(size_t i = 0; i < m_redo_stack.size(); ++i) {
-    std::cout << static_cast<const void*>(m_redo_stack[i].data()) << " ";
+    auto& state = m_state.sectors[delta.sector].objects[delta.object];
+    state = capture(*state.object);
   }
-  std::cout << std::endl;
-  std::cout << std::endl;
-#endif
 }
 
-void
-UndoManager::push_undo_stack(std::string&& level_snapshot)
+std::vector<GameObject*>
+UndoManager::get_saved_objects(const Sector& sector)
 {
-  log_info << "doing snapshot" << std::endl;
+  // same order as Sector::save()
+  std::vector<GameObject*> objects;
+  for (const auto& object : sector.get_objects()) {
+    if (object->is_saveable()) {
+      objects.push_back(object.get());
+    }
+  }
 
-  m_redo_stack.clear();
-  m_undo_stack.push_back(std::move(level_snapshot));
-  m_index_pos += 1;
+  std::stable_sort(objects.begin(), objects.end(),
+                   [](const GameObject* lhs, const GameObject* rhs) {
+                     return lhs->get_class() < rhs->get_class();
+                   });
+  return objects;
+}
 
-  cleanup();
+std::string
+UndoManager::capture_text(const Level& level)
+{
+  std::ostringstream out;
+  Writer writer(out);
+  writer.write("name", level.m_name);
+  writer.write("author", level.m_author);
+  writer.write("contact", level.m_contact);
+  writer.write("license", level.m_license);
+  writer.write("note", level.m_note);
+  writer.write("target-time", level.m_target_time);
+  writer.write("tileset", level.m_tileset);
+  writer.write("suppress-pause-menu", level.m_suppress_pause_menu);
+  return out.str();
+}
 
-  debug_print("snapshot");
+std::string
+UndoManager::capture_text(const Sector& sector)
+{
+  std::ostringstream out;
+  Writer writer(out);
+  writer.write("name", sector.get_name());
+  writer.write("gravity", sector.get_gravity());
+  writer.write("init-script", sector.get_init_script());
+  return out.str();
 }
 
-void
-UndoManager::cleanup()
+UndoManager::LevelState
+UndoManager::capture(Level& level)
 {
-  while (m_undo_stack.size() > m_max_snapshots) {
-    m_undo_stack.erase(m_undo_stack.end() - m_max_snapshots,
-                       m_undo_stack.end());
+  LevelState state;
+  state.text = capture_text(level);
+
+  for (const auto& sector : level.m_sectors)
+  {
+    SectorState sector_state;
+    sector_state.sector = sector.get();
+    sector_state.change_count = sector->get_change_count();
+    sector_state.text = capture_text(*sector);
+
+    for (auto* object : get_saved_objects(*sector)) {
+      sector_state.objects.push_back(capture(*object));
+    }
+
+    state.sectors.push_back(std::move(sector_state));
   }
+
+  return state;
 }
 
-std::unique_ptr<Level>
-UndoManager::undo()
+UndoManager::ObjectState
+UndoManager::capture(GameObject& object)
 {
-  if (m_undo_stack.size() < 2) return {};
+  ObjectState state;
+  state.object = &object;
+  state.moving = dynamic_cast<MovingObject*>(&object);
+  state.tilemap = dynamic_cast<TileMap*>(&object);
+  state.bbox = state.moving ? state.moving->get_bbox() : Rectf();
+  state.width = state.tilemap ? state.tilemap->get_width() : 0;
+  state.height = state.tilemap ? state.tilemap->get_height() : 0;
+  state.options = capture_options(object, state.moving != nullptr, state.tilemap != nullptr);
+  return state;
+}
 
-  m_redo_stack.push_back(std::move(m_undo_stack.back()));
-  m_undo_stack.pop_back();
+std::vector<UndoManager::OptionState>
+UndoManager::capture_options(GameObject& object, bool moving, bool tilemap)
+{
+  std::vector<OptionState> options;
 
-  std::istringstream in(m_undo_stack.back());
-  ReaderMapping::s_translations_enabled = false;
-  auto level = LevelParser::from_stream(in, "<undo_stack>", Editor::current()->get_level()->is_worldmap(), true);
-  ReaderMapping::s_translations_enabled = true;
+  std::ostringstream out;
+  Writer writer(out);
+  auto settings = object.get_settings();
+  for (const auto& option : settings.get_options())
+  {
+    const auto& key = option->get_key();
+    if (key.empty())
+      continue;
 
-  m_index_pos -= 1;
+    // tracked through the bbox and TileMap::take_changes()
+    if ((moving && (key == "x" || key == "y" || key == "region")) ||
+        (tilemap && key == "tiles"))
+      continue;
 
-  debug_print("undo");
+    out.str({});
+    option->save(writer);
+    options.push_back({ key, out.str(), option->can_parse() });
+  }
 
-  return level;
+  return options;
 }
 
-std::unique_ptr<Level>
-UndoManager::redo()
+std::vector<UndoJournal::TileDelta>
+UndoManager::take_tile_changes()
 {
-  if (m_redo_stack.empty()) return {};
+  std::vector<UndoJournal::TileDelta> deltas;
+  for (size_t s = 0; s < m_state.sectors.size(); ++s)
+  {
+    const auto& objects = m_state.sectors[s].objects;
+    for (size_t o = 0; o < objects.size(); ++o)
+    {
+      if (!objects[o].tilemap)
+        continue;
+
+      auto changes = objects[o].tilemap->take_changes();
+      if (!changes.empty()) {
+        deltas.push_back({ s, o, std::move(changes) });
+      }
+    }
+  }
+  return deltas;
+}
 
-  m_undo_stack.push_back(std::move(m_redo_stack.back()));
-  m_redo_stack.pop_back();
+void
+UndoManager::apply(Level& level, const UndoJournal::Entry& entry, bool forward)
+{
+  for (const auto& delta : entry.tiles)
+  {
+    if (delta.sector >= level.m_sectors.size())
+      continue;
 
-  m_index_pos += 1;
+    const auto objects = get_saved_objects(*level.m_sectors[delta.sector]);
+    auto* tilemap = delta.object < objects.size() ? dynamic_cast<TileMap*>(objects[delta.object]) : nullptr;
+    if (!tilemap)
+    {
+      log_warning << "undo journal doesn't match the level, missing tilemap" << std::endl;
+      continue;
+    }
+
+    const int width = tilemap->get_width();
+    for (const auto& change : delta.changes)
+    {
+      tilemap->change(change.index % width, change.index / width,
+                      forward ? change.new_tile : change.old_tile);
+    }
+    // don't record our own changes as new edits
+    tilemap->take_changes();
+  }
+
+  for (const auto& delta : entry.objects)
+  {
+    if (delta.sector >= level.m_sectors.size())
+      continue;
+
+    auto& sector = *level.m_sectors[delta.sector];
+    const auto objects = get_saved_objects(sector);
+    if (delta.object >= objects.size())
+    {
+      log_warning << "undo journal doesn't match the level, missing object" << std::endl;
+      continue;
+    }
+
+    auto* object = objects[delta.object];
+    if (!delta.keys.empty())
+    {
+      BIND_SECTOR(sector);
+      apply_options(*object, delta.keys, forward ? delta.new_settings : delta.old_settings);
+    }
+
+    const Rectf& bbox = forward ? delta.new_bbox : delta.old_bbox;
+    auto* moving_object = dynamic_cast<MovingObject*>(object);
+    if (!moving_object)
+    {
+      if (!(delta.old_bbox == delta.new_bbox)) {
+        log_warning << "undo journal doesn't match the level, object doesn't move" << std::endl;
+      }
+      continue;
+    }
+
+    if (moving_object->get_bbox().get_size() != bbox.get_size()) {
+      moving_object->get_collision_object()->set_size(bbox.get_width(), bbox.get_height());
+    }
+    moving_object->move_to(bbox.p1());
+  }
+}
+
+void
+UndoManager::apply_options(GameObject& object, const std::vector<std::string>& keys, const std::string& text)
+{
+  std::istringstream in("(options\n" + text + ")");
+  auto doc = ReaderDocument::from_stream(in, "<undo_stack>");
+  auto mapping = doc.get_root().get_mapping();
 
-  std::istringstream in(m_undo_stack.back());
   ReaderMapping::s_translations_enabled = false;
-  auto level = LevelParser::from_stream(in, "<redo_stack>", Editor::current()->get_level()->is_worldmap(), true);
+  auto settings = object.get_settings();
+  for (const auto& option : settings.get_options())
+  {
+    if (std::find(keys.begin(), keys.end(), option->get_key()) != keys.end()) {
+      option->parse(mapping);
+    }
+  }
   ReaderMapping::s_translations_enabled = true;
 
-  debug_print("redo");
+  object.after_editor_set();
+}
 
+std::unique_ptr<Level>
+UndoManager::parse(const std::string& snapshot, const std::string& context, bool worldmap)
+{
+  std::istringstream in(snapshot);
+  ReaderMapping::s_translations_enabled = false;
+  auto level = LevelParser::from_stream(in, context, worldmap, true);
+  ReaderMapping::s_translations_enabled = true;
   return level;
 }
 
+bool
+UndoManager::undo(Level& level, std::unique_ptr<Level>& replacement)
+{
+  // don't lose edits that haven't been recorded yet
+  try_snapshot(level);
+
+  Level* target = &level;
+  if (!m_journal.undo([&target, &level, this](const UndoJournal::Entry& entry, bool forward) {
+                        apply(*target, entry, forward);
+                        if (target == &level) {
+                          update_objects(entry);
+                        }
+                      },
+                      [&target, &replacement, &level](const std::string& snapshot) {
+                        replacement = parse(snapshot, "<undo_stack>", level.is_worldmap());
+                        target = replacement.get();
+                      }))
+    return false;
+
+  if (replacement) {
+    m_state = capture(*replacement);
+  }
+  m_index_pos -= 1;
+  return true;
+}
+
+bool
+UndoManager::redo(Level& level, std::unique_ptr<Level>& replacement)
+{
+  try_snapshot(level);
+
+  Level* target = &level;
+  if (!m_journal.redo([&target, &level, this](const UndoJournal::Entry& entry, bool forward) {
+                        apply(*target, entry, forward);
+                        if (target == &level) {
+                          update_objects(entry);
+                        }
+                      },
+                      [&target, &replacement, &level](const std::string& snapshot) {
+                        replacement = parse(snapshot, "<redo_stack>", level.is_worldmap());
+                        target = replacement.get();
+                      }))
+    return false;
+
+  if (replacement) {
+    m_state = capture(*replacement);
+  }
+  m_index_pos += 1;
+  return true;
+}
+
 /* EOF */
@@ -17,22 +17,74 @@
 #ifndef HEADER_SUPERTUX_EDITOR_UNDO_MANAGER_HPP
 #define HEADER_SUPERTUX_EDITOR_UNDO_MANAGER_HPP
 
-#include <vector>
-#include <string>
 #include <memory>
+#include <set>
+#include <string>
+#include <vector>
 
+#include "editor/undo_journal.hpp"
+#include "math/rectf.hpp"
+
+class GameObject;
 class Level;
+class MovingObject;
+class Sector;
+class TileMap;
 
+/** Undo history of the editor. Tile painting, moving or resizing
+    objects and changes to the options of single objects are recorded
+    as deltas that are undone in place, any other change falls back to
+    a snapshot of the whole level. */
 class UndoManager
 {
 private:
+  /** What one option of an object saved */
+  struct OptionState
+  {
+    std::string key;
+    std::string text;
+    bool parseable;
+  };
+
+  struct ObjectState
+  {
+    GameObject* object;
+    MovingObject* moving;
+    TileMap* tilemap;
+    Rectf bbox;
+    int width;
+    int height;
+    std::vector<OptionState> options;
+  };
+
+  struct SectorState
+  {
+    const Sector* sector;
+    uint32_t change_count;
+    std::string text;
+    std::vector<ObjectState> objects;
+  };
+
+  struct LevelState
+  {
+    std::string text;
+    std::vector<SectorState> sectors;
+  };
+
 public:
   UndoManager();
 
   void try_snapshot(Level& level);
 
-  std::unique_ptr<Level> undo();
-  std::unique_ptr<Level> redo();
+  /** Tells the undo history that the options of @a object were
+      edited, only those are compared on the next snapshot */
+  void object_changed(GameObject& object);
+
+  /** Reverts the last change. Deltas are applied to @a level directly,
+      snapshots are parsed into @a replacement, which then has to
+      replace @a level. Returns false if there is nothing to undo. */
+  bool undo(Level& level, std::unique_ptr<Level>& replacement);
+  bool redo(Level& level, std::unique_ptr<Level>& replacement);
 
   bool has_unsaved_changes() const
   {
@@ -45,15 +97,28 @@ public:
   }
 
 private:
-  void push_undo_stack(std::string&& level_snapshot);
-  void cleanup();
-  void debug_print(const char* action);
+  /** Compares the level against m_state and updates it, returns false
+      if the change can't be recorded as deltas */
+  bool update_state(Level& level, std::vector<UndoJournal::ObjectDelta>& deltas);
+  /** Re-captures the objects an entry was applied to in place */
+  void update_objects(const UndoJournal::Entry& entry);
+  std::vector<UndoJournal::TileDelta> take_tile_changes();
+
+  static std::vector<GameObject*> get_saved_objects(const Sector& sector);
+  static std::string capture_text(const Level& level);
+  static std::string capture_text(const Sector& sector);
+  static LevelState capture(Level& level);
+  static ObjectState capture(GameObject& object);
+  static std::vector<OptionState> capture_options(GameObject& object, bool moving, bool tilemap);
+  static void apply(Level& level, const UndoJournal::Entry& entry, bool forward);
+  static void apply_options(GameObject& object, const std::vector<std::string>& keys, const std::string& text);
+  static std::unique_ptr<Level> parse(const std::string& snapshot, const std::string& context, bool worldmap);
 
 private:
-  size_t m_max_snapshots;
   int m_index_pos;
-  std::vector<std::string> m_undo_stack;
-  std::vector<std::string> m_redo_stack;
+  LevelState m_state;
+  std::set<const GameObject*> m_changed_objects;
+  UndoJournal m_journal;
 
 private:
   UndoManager(const UndoManager&) = delete;
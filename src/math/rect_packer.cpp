@@ -0,0 +1,71 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "math/rect_packer.hpp"
+
+RectPacker::RectPacker(int width, int height) :
+  m_width(width),
+  m_height(height),
+  m_used_height(0),
+  m_shelves()
+{
+}
+
+boost::optional<Rect>
+RectPacker::insert(const Size& size)
+{
+  if (size.width <= 0 || size.height <= 0 ||
+      size.width > m_width || size.height > m_height)
+    return boost::none;
+
+  // Pick the shelf that wastes the least height
+  Shelf* best = nullptr;
+  for (auto& shelf : m_shelves)
+  {
+    if (shelf.height >= size.height &&
+        m_width - shelf.used_width >= size.width &&
+        (!best || shelf.height < best->height))
+    {
+      best = &shelf;
+    }
+  }
+
+  // Rather start a new shelf than put a small rectangle into a much
+  // taller shelf, as long as there is room for one
+  const bool wasteful = best && (best->height - size.height) * 4 > best->height;
+  if ((!best || wasteful) && m_height - m_used_height >= size.height)
+  {
+    m_shelves.push_back({m_used_height, size.height, 0});
+    m_used_height += size.height;
+    best = &m_shelves.back();
+  }
+
+  if (!best)
+    return boost::none;
+
+  const Rect rect(best->used_width, best->top, size);
+  best->used_width += size.width;
+  return rect;
+}
+
+void
+RectPacker::clear()
+{
+  m_used_height = 0;
+  m_shelves.clear();
+}
+
+/* EOF */
@@ -0,0 +1,66 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_MATH_RECT_PACKER_HPP
+#define HEADER_SUPERTUX_MATH_RECT_PACKER_HPP
+
+#include <vector>
+#include <boost/optional.hpp>
+
+#include "math/rect.hpp"
+#include "math/size.hpp"
+
+/** Packs rectangles into a fixed size area, row by row. Rows
+    ("shelves") are as tall as the first rectangle put into them, which
+    works well for sets of similarly sized images like tiles and
+    sprite frames. */
+class RectPacker final
+{
+public:
+  RectPacker(int width, int height);
+
+  /** Returns where the rectangle was put, or boost::none if there is
+      no room left for it */
+  boost::optional<Rect> insert(const Size& size);
+
+  /** Forgets about all the rectangles packed so far */
+  void clear();
+
+  int get_width() const { return m_width; }
+  int get_height() const { return m_height; }
+
+private:
+  struct Shelf
+  {
+    int top;
+    int height;
+    int used_width;
+  };
+
+private:
+  int m_width;
+  int m_height;
+  int m_used_height;
+  std::vector<Shelf> m_shelves;
+
+private:
+  RectPacker(const RectPacker&) = delete;
+  RectPacker& operator=(const RectPacker&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -227,7 +227,7 @@ AmbientSound::set_pos(const Vector& pos)
 void
 AmbientSound::set_pos(float x, float y)
 {
-  m_col.m_bbox.set_pos(Vector(x, y));
+  m_col.set_pos(Vector(x, y));
 }
 
 float
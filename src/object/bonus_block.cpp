@@ -261,7 +261,7 @@ BonusBlock::collision(GameObject& other, const CollisionHit& hit_)
 void
 BonusBlock::try_open(Player* player)
 {
-  SoundManager::current()->play("sounds/brick.wav");
+  SoundManager::current()->play("sounds/brick.wav", 0.5f, SoundManager::PRIORITY_LOW);
   if (m_sprite->get_action() == "empty")
     return;
 
@@ -383,7 +383,7 @@ BonusBlock::try_open(Player* player)
 void
 BonusBlock::try_drop(Player *player)
 {
-  SoundManager::current()->play("sounds/brick.wav");
+  SoundManager::current()->play("sounds/brick.wav", 0.5f, SoundManager::PRIORITY_LOW);
   if (m_sprite->get_action() == "empty")
     return;
 
@@ -553,6 +553,13 @@ BonusBlock::draw(DrawingContext& context)
   }
 }
 
+bool
+BonusBlock::draws_outside_bbox() const
+{
+  // the light is much larger than the block
+  return m_sprite->get_action() == "on";
+}
+
 BonusBlock::Content
 BonusBlock::get_content_from_string(const std::string& contentstring) const
 {
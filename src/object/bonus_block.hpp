@@ -51,6 +51,7 @@ public:
   virtual void hit(Player& player) override;
   virtual HitResponse collision(GameObject& other, const CollisionHit& hit) override;
   virtual void draw(DrawingContext& context) override;
+  virtual bool draws_outside_bbox() const override;
 
   virtual std::string get_class() const override { return "bonusblock"; }
   virtual std::string get_display_name() const override { return _("Bonus Block"); }
@@ -47,8 +47,8 @@ Bullet::Bullet(const Vector& pos, const Vector& xm, Direction dir, BonusType typ
     sprite = SpriteManager::current()->create("images/objects/bullets/firebullet.sprite");
   }
 
-  m_col.m_bbox.set_pos(pos);
-  m_col.m_bbox.set_size(sprite->get_current_hitbox_width(), sprite->get_current_hitbox_height());
+  m_col.set_pos(pos);
+  m_col.set_size(sprite->get_current_hitbox_width(), sprite->get_current_hitbox_height());
 }
 
 void
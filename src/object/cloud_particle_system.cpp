@@ -30,6 +30,8 @@ CloudParticleSystem::CloudParticleSystem() :
   ParticleSystem(128),
   ExposedObject<CloudParticleSystem, scripting::Clouds>(this),
   cloudimage(Surface::from_file("images/particles/cloud.png")),
+  target_alpha(),
+  target_time_remaining(),
 
   m_current_speed(1.f),
   m_target_speed(1.f),
@@ -47,6 +49,8 @@ CloudParticleSystem::CloudParticleSystem(const ReaderMapping& reader) :
   ParticleSystem(reader, 128),
   ExposedObject<CloudParticleSystem, scripting::Clouds>(this),
   cloudimage(Surface::from_file("images/particles/cloud.png")),
+  target_alpha(),
+  target_time_remaining(),
 
   m_current_speed(1.f),
   m_target_speed(1.f),
@@ -103,45 +107,29 @@ void CloudParticleSystem::update(float dt_sec)
 
   auto& cam = Sector::get().get_singleton_by_type<Camera>();
 
-  for (auto& particle : particles) {
-    auto cloudParticle = dynamic_cast<CloudParticle*>(particle.get());
-    if (!cloudParticle)
+  particles.integrate(dt_sec, m_current_speed);
+  particles.wrap_x(cam.get_translation().x - static_cast<float>(cloudimage->get_width()), virtual_width);
+  particles.wrap_y(cam.get_translation().y - static_cast<float>(cloudimage->get_height()), virtual_height);
+
+  for (size_t i = 0; i < particles.get_slot_count(); ++i) {
+    if (!particles.is_alive(i))
       continue;
-    cloudParticle->pos.x += cloudParticle->speed * dt_sec * m_current_speed;
-    while (cloudParticle->pos.x < cam.get_translation().x - static_cast<float>(cloudParticle->texture->get_width()))
-      cloudParticle->pos.x += virtual_width;
-    while (cloudParticle->pos.x > cam.get_translation().x + static_cast<float>(SCREEN_WIDTH))
-      cloudParticle->pos.x -= virtual_width;
-    while (cloudParticle->pos.y < cam.get_translation().y - static_cast<float>(cloudParticle->texture->get_height()))
-      cloudParticle->pos.y += virtual_height;
-    while (cloudParticle->pos.y > cam.get_translation().y + static_cast<float>(SCREEN_HEIGHT))
-      cloudParticle->pos.y -= virtual_height;
 
     // Update alpha
-    if (cloudParticle->target_time_remaining > 0.f) {
-      if (dt_sec >= cloudParticle->target_time_remaining) {
-        cloudParticle->alpha = cloudParticle->target_alpha;
-        cloudParticle->target_time_remaining = 0.f;
-        if (cloudParticle->alpha == 0.f) {
-          // Remove this particle
-          // But not right here, else it'd mess with the iterator
-        }
+    if (target_time_remaining[i] > 0.f) {
+      if (dt_sec >= target_time_remaining[i]) {
+        particles.alpha[i] = target_alpha[i];
+        target_time_remaining[i] = 0.f;
       } else {
-        float amount = dt_sec / cloudParticle->target_time_remaining;
-        cloudParticle->alpha += (cloudParticle->target_alpha - cloudParticle->alpha) * amount;
-        cloudParticle->target_time_remaining -= dt_sec;
+        float amount = dt_sec / target_time_remaining[i];
+        particles.alpha[i] += (target_alpha[i] - particles.alpha[i]) * amount;
+        target_time_remaining[i] -= dt_sec;
       }
     }
-  }
 
-  // Clear dead clouds
-  // Scroll through the vector backwards, because removing an element affects
-  //   the index of all elements after it (prevents buggy behavior)
-  for (int i = static_cast<int>(particles.size()) - 1; i >= 0; --i) {
-    auto particle = dynamic_cast<CloudParticle*>(particles.at(i).get());
-    
-    if (particle->target_alpha == 0.f && particle->target_time_remaining == 0.f)
-      particles.erase(particles.begin()+i);
+    // Clear dead clouds; their slot gets reused by the next add_clouds()
+    if (target_alpha[i] == 0.f && target_time_remaining[i] == 0.f)
+      particles.release(i);
   }
 }
 
@@ -155,18 +143,21 @@ int CloudParticleSystem::add_clouds(int amount, float fade_time)
   int amount_to_add = target_amount - m_current_real_amount;
 
   for (int i = 0; i < amount_to_add; ++i) {
-    auto particle = std::make_unique<CloudParticle>();
+    const size_t index = particles.allocate();
+    if (index >= target_alpha.size()) {
+      target_alpha.resize(index + 1);
+      target_time_remaining.resize(index + 1);
+    }
+
     // Don't consider the camera, because the Sector might not exist yet
     // Instead, rely on update() to correct this when it will be called
-    particle->pos.x = graphicsRandom.randf(virtual_width);
-    particle->pos.y = graphicsRandom.randf(virtual_height);
-    particle->texture = cloudimage;
-    particle->speed = -graphicsRandom.randf(25.0, 54.0);
-    particle->alpha = (fade_time == 0.f) ? 1.f : 0.f;
-    particle->target_alpha = 1.f;
-    particle->target_time_remaining = fade_time;
-
-    particles.push_back(std::move(particle));
+    particles.pos_x[index] = graphicsRandom.randf(virtual_width);
+    particles.pos_y[index] = graphicsRandom.randf(virtual_height);
+    particles.texture[index] = cloudimage;
+    particles.vel_x[index] = -graphicsRandom.randf(25.0, 54.0);
+    particles.alpha[index] = (fade_time == 0.f) ? 1.f : 0.f;
+    target_alpha[index] = 1.f;
+    target_time_remaining[index] = fade_time;
   }
 
   m_current_real_amount = target_amount;
@@ -183,16 +174,15 @@ int CloudParticleSystem::remove_clouds(int amount, float fade_time)
   int amount_to_remove = m_current_real_amount - target_amount;
 
   int i = 0;
-  for (; i < amount_to_remove && i < static_cast<int>(particles.size()); ++i) {
-  
-    auto particle = dynamic_cast<CloudParticle*>(particles.at(i).get());
-    if (particle->target_alpha != 1.f || particle->target_time_remaining != 0.f) {
-      // Skip that one, it doesn't count
-      --i;
-    } else {
-      particle->target_alpha = 0.f;
-      particle->target_time_remaining = fade_time;
-    }
+  for (size_t index = 0; i < amount_to_remove && index < particles.get_slot_count(); ++index) {
+    // Skip clouds that are already fading, they don't count
+    if (!particles.is_alive(index) ||
+        target_alpha[index] != 1.f || target_time_remaining[index] != 0.f)
+      continue;
+
+    target_alpha[index] = 0.f;
+    target_time_remaining[index] = fade_time;
+    ++i;
   }
 
   return i;
@@ -236,37 +226,20 @@ void CloudParticleSystem::draw(DrawingContext& context)
 
   context.push_transform();
 
-  std::unordered_map<SurfacePtr, SurfaceBatch> batches;
-  for (const auto& particle : particles) {
-    if (particle->alpha != 1.f) {
-      const auto& batch_it = batches.emplace(
-          particle->texture->clone(),
-          SurfaceBatch(
-              particle->texture,
-              Color(1.f, 1.f, 1.f, particle->alpha)
-          ));
-      batch_it.first->second.draw(particle->pos, particle->angle);
-    } else {
-      auto it = batches.find(particle->texture);
-      if (it == batches.end()) {
-        const auto& batch_it = batches.emplace(particle->texture,
-          SurfaceBatch(particle->texture));
-        batch_it.first->second.draw(particle->pos, particle->angle);
-      } else {
-        it->second.draw(particle->pos, particle->angle);
-      }
-    }
-  }
+  for (size_t i = 0; i < particles.get_slot_count(); ++i) {
+    if (!particles.is_alive(i))
+      continue;
 
-  for(auto& it : batches) {
-    auto& surface = it.first;
-    auto& batch = it.second;
-    // FIXME: What is the colour used for?
-    // RESOLVED : That's the tint and the alpha
-    context.color().draw_surface_batch(surface, batch.move_srcrects(),
-      batch.move_dstrects(), batch.move_angles(), batch.get_color(), z_pos);
+    const SurfacePtr& texture = particles.texture[i];
+    const Vector pos(particles.pos_x[i], particles.pos_y[i]);
+
+    // fading clouds are batched by their alpha
+    m_batches.get(texture, Color(1.f, 1.f, 1.f, particles.alpha[i]))
+      .draw(pos, particles.angle[i]);
   }
 
+  m_batches.draw(context.color(), z_pos);
+
   context.pop_transform();
 }
 
@@ -68,22 +68,12 @@ private:
   int remove_clouds(int amount, float fade_time);
 
 private:
-  class CloudParticle : public Particle
-  {
-  public:
-    float speed;
-    float target_alpha;
-    float target_time_remaining;
-
-    CloudParticle() :
-      speed(),
-      target_alpha(),
-      target_time_remaining()
-    {}
-  };
-
   SurfacePtr cloudimage;
 
+  // Per-cloud fading state, indexed like the slots of the particle pool
+  std::vector<float> target_alpha;
+  std::vector<float> target_time_remaining;
+
   float m_current_speed;
   float m_target_speed;
   float m_speed_fade_time_remaining;
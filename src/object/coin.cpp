@@ -227,7 +227,7 @@ HeavyCoin::collision_solid(const CollisionHit& hit)
 
   if (hit.bottom) {
     if (m_physic.get_velocity_y() > clink_threshold && !m_last_hit.bottom)
-        SoundManager::current()->play("sounds/coin2.ogg");
+        SoundManager::current()->play("sounds/coin2.ogg", 0.5f, SoundManager::PRIORITY_LOW);
     if (m_physic.get_velocity_y() > 200) {// lets some coins bounce
       m_physic.set_velocity_y(-99);
     } else {
@@ -239,12 +239,12 @@ HeavyCoin::collision_solid(const CollisionHit& hit)
     if ((m_physic.get_velocity_x() > clink_threshold ||
          m_physic.get_velocity_x()< -clink_threshold) &&
          hit.right != m_last_hit.right && hit.left != m_last_hit.left)
-      SoundManager::current()->play("sounds/coin2.ogg");
+      SoundManager::current()->play("sounds/coin2.ogg", 0.5f, SoundManager::PRIORITY_LOW);
     m_physic.set_velocity_x(-m_physic.get_velocity_x());
   }
   if (hit.top) {
     if (m_physic.get_velocity_y() < -clink_threshold && !m_last_hit.top)
-      SoundManager::current()->play("sounds/coin2.ogg");
+      SoundManager::current()->play("sounds/coin2.ogg", 0.5f, SoundManager::PRIORITY_LOW);
     m_physic.set_velocity_y(-m_physic.get_velocity_y());
   }
 
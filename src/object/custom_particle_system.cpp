@@ -559,112 +559,114 @@ CustomParticleSystem::update(float dt_sec)
   }
 
   // Update existing particles
-  for (auto& it : custom_particles) {
-    auto particle = dynamic_cast<CustomParticle*>(it.get());
-    assert(particle);
+  for (size_t i = 0; i < particles.get_slot_count(); ++i) {
+    if (!particles.is_alive(i))
+      continue;
 
-    if (particle->birth_time > dt_sec) {
-      switch(particle->birth_mode) {
+    auto& particle = custom_particles[i];
+
+    if (particle.birth_time > dt_sec) {
+      switch(particle.birth_mode) {
       case FadeMode::Shrink:
-        particle->scale = static_cast<float>(
-                          getEasingByName(particle->birth_easing)(
+        particles.scale[i] = static_cast<float>(
+                          getEasingByName(particle.birth_easing)(
                             static_cast<double>(
-                              1.f - (particle->birth_time / particle->total_birth)
+                              1.f - (particle.birth_time / particle.total_birth)
                             )
                           ));
         break;
       case FadeMode::Fade:
-        particle->props = SpriteProperties(particle->original_props,
-                                           1.f - (particle->birth_time /
-                                                  particle->total_birth));
+        particle.props = SpriteProperties(particle.original_props,
+                                           1.f - (particle.birth_time /
+                                                  particle.total_birth));
         break;
       default:
         break;
       }
-      particle->birth_time -= dt_sec;
-    } else if (particle->birth_time > 0.f) {
-      particle->birth_time = 0.f;
-      switch(particle->birth_mode) {
+      particle.birth_time -= dt_sec;
+    } else if (particle.birth_time > 0.f) {
+      particle.birth_time = 0.f;
+      switch(particle.birth_mode) {
       case FadeMode::Shrink:
-        particle->scale = 1.f;
+        particles.scale[i] = 1.f;
         break;
       case FadeMode::Fade:
-        particle->props = particle->original_props;
+        particle.props = particle.original_props;
         break;
       default:
         break;
       }
     }
 
-    particle->lifetime -= dt_sec;
-    if (particle->lifetime < 0.f) {
-      particle->lifetime = 0.f;
+    particle.lifetime -= dt_sec;
+    if (particle.lifetime < 0.f) {
+      particle.lifetime = 0.f;
     }
 
-    if (particle->birth_time <= 0.f && particle->lifetime <= 0.f) {
-      if (particle->death_time > dt_sec) {
-        switch(particle->death_mode) {
+    if (particle.birth_time <= 0.f && particle.lifetime <= 0.f) {
+      if (particle.death_time > dt_sec) {
+        switch(particle.death_mode) {
         case FadeMode::Shrink:
-          particle->scale = 1.f - static_cast<float>(
-                            getEasingByName(particle->death_easing)(
+          particles.scale[i] = 1.f - static_cast<float>(
+                            getEasingByName(particle.death_easing)(
                               static_cast<double>(
-                                1.f - (particle->death_time / particle->total_death)
+                                1.f - (particle.death_time / particle.total_death)
                               )
                             ));
           break;
         case FadeMode::Fade:
-          particle->props = SpriteProperties(particle->original_props,
-                                                   (particle->death_time /
-                                                    particle->total_death));
+          particle.props = SpriteProperties(particle.original_props,
+                                                   (particle.death_time /
+                                                    particle.total_death));
           break;
         default:
           break;
         }
-        particle->death_time -= dt_sec;
+        particle.death_time -= dt_sec;
       } else {
-        particle->death_time = 0.f;
-        switch(particle->death_mode) {
+        particle.death_time = 0.f;
+        switch(particle.death_mode) {
         case FadeMode::Shrink:
-          particle->scale = 0.f;
+          particles.scale[i] = 0.f;
           break;
         case FadeMode::Fade:
-          particle->props = SpriteProperties(particle->original_props, 0.f);
+          particle.props = SpriteProperties(particle.original_props, 0.f);
           break;
         default:
           break;
         }
-        particle->ready_for_deletion = true;
+        particle.ready_for_deletion = true;
       }
     }
 
     float abs_x = get_abs_x();
     float abs_y = get_abs_y();
 
-    if (!particle->has_been_on_screen) {
-      if (particle->pos.y <= static_cast<float>(SCREEN_HEIGHT) + abs_y
-          && particle->pos.y >= abs_y
-          && particle->pos.x <= static_cast<float>(SCREEN_WIDTH) + abs_x
-          && particle->pos.x >= abs_x) {
-        particle->has_been_on_screen = true;
+    if (!particle.has_been_on_screen) {
+      if (particles.pos_y[i] <= static_cast<float>(SCREEN_HEIGHT) + abs_y
+          && particles.pos_y[i] >= abs_y
+          && particles.pos_x[i] <= static_cast<float>(SCREEN_WIDTH) + abs_x
+          && particles.pos_x[i] >= abs_x) {
+        particle.has_been_on_screen = true;
       }
     }
 
-    switch(particle->offscreen_mode) {
+    switch(particle.offscreen_mode) {
     case OffscreenMode::Always:
-      if (particle->pos.y > static_cast<float>(SCREEN_HEIGHT) + abs_y
-          || particle->pos.y < abs_y
-          || particle->pos.x > static_cast<float>(SCREEN_WIDTH) + abs_x
-          || particle->pos.x < abs_x) {
-        particle->ready_for_deletion = true;
+      if (particles.pos_y[i] > static_cast<float>(SCREEN_HEIGHT) + abs_y
+          || particles.pos_y[i] < abs_y
+          || particles.pos_x[i] > static_cast<float>(SCREEN_WIDTH) + abs_x
+          || particles.pos_x[i] < abs_x) {
+        particle.ready_for_deletion = true;
       }
       break;
     case OffscreenMode::OnlyOnExit:
-      if ((particle->pos.y > static_cast<float>(SCREEN_HEIGHT) + abs_y
-          || particle->pos.y < abs_y
-          || particle->pos.x > static_cast<float>(SCREEN_WIDTH) + abs_x
-          || particle->pos.x < abs_x)
-          && particle->has_been_on_screen) {
-        particle->ready_for_deletion = true;
+      if ((particles.pos_y[i] > static_cast<float>(SCREEN_HEIGHT) + abs_y
+          || particles.pos_y[i] < abs_y
+          || particles.pos_x[i] > static_cast<float>(SCREEN_WIDTH) + abs_x
+          || particles.pos_x[i] < abs_x)
+          && particle.has_been_on_screen) {
+        particle.ready_for_deletion = true;
       }
       break;
     case OffscreenMode::Never:
@@ -673,26 +675,26 @@ CustomParticleSystem::update(float dt_sec)
 
     bool is_in_life_zone = false;
     for (auto& zone : get_zones()) {
-      if (zone.get_rect().contains(particle->pos) && zone.get_particle_name() == m_name) {
+      if (zone.get_rect().contains(Vector(particles.pos_x[i], particles.pos_y[i])) && zone.get_particle_name() == m_name) {
         switch(zone.get_type()) {
         case ParticleZone::ParticleZoneType::Killer:
-          particle->lifetime = 0.f;
-          particle->birth_time = 0.f;
+          particle.lifetime = 0.f;
+          particle.birth_time = 0.f;
           break;
 
         case ParticleZone::ParticleZoneType::Destroyer:
-          particle->ready_for_deletion = true;
+          particle.ready_for_deletion = true;
           break;
 
         case ParticleZone::ParticleZoneType::LifeClear:
-          particle->last_life_zone_required_instakill = true;
-          particle->has_been_in_life_zone = true;
+          particle.last_life_zone_required_instakill = true;
+          particle.has_been_in_life_zone = true;
           is_in_life_zone = true;
           break;
 
         case ParticleZone::ParticleZoneType::Life:
-          particle->last_life_zone_required_instakill = false;
-          particle->has_been_in_life_zone = true;
+          particle.last_life_zone_required_instakill = false;
+          particle.has_been_in_life_zone = true;
           is_in_life_zone = true;
           break;
 
@@ -703,120 +705,116 @@ CustomParticleSystem::update(float dt_sec)
       }
     } // For each ParticleZone object
 
-    if (!is_in_life_zone && particle->has_been_in_life_zone) {
-      if (particle->last_life_zone_required_instakill) {
-        particle->ready_for_deletion = true;
+    if (!is_in_life_zone && particle.has_been_in_life_zone) {
+      if (particle.last_life_zone_required_instakill) {
+        particle.ready_for_deletion = true;
       } else {
-        particle->lifetime = 0.f;
-        particle->birth_time = 0.f;
+        particle.lifetime = 0.f;
+        particle.birth_time = 0.f;
       }
     }
 
-    if (!particle->stuck) {
-      particle->speedX += graphicsRandom.randf(-particle->feather_factor,
-                                      particle->feather_factor) * dt_sec * 1000.f;
-      particle->speedY += graphicsRandom.randf(-particle->feather_factor,
-                                      particle->feather_factor) * dt_sec * 1000.f;
-      particle->speedX += particle->accX * dt_sec;
-      particle->speedY += particle->accY * dt_sec;
-      particle->speedX *= 1.f - particle->frictionX * dt_sec;
-      particle->speedY *= 1.f - particle->frictionY * dt_sec;
-
-      if (Sector::current() && collision(particle,
-                    Vector(particle->speedX,particle->speedY) * dt_sec) > 0) {
-        switch(particle->collision_mode) {
+    if (!particle.stuck) {
+      particles.vel_x[i] += graphicsRandom.randf(-particle.feather_factor,
+                                      particle.feather_factor) * dt_sec * 1000.f;
+      particles.vel_y[i] += graphicsRandom.randf(-particle.feather_factor,
+                                      particle.feather_factor) * dt_sec * 1000.f;
+      particles.vel_x[i] += particle.accX * dt_sec;
+      particles.vel_y[i] += particle.accY * dt_sec;
+      particles.vel_x[i] *= 1.f - particle.frictionX * dt_sec;
+      particles.vel_y[i] *= 1.f - particle.frictionY * dt_sec;
+
+      if (Sector::current() && collision(i,
+                    Vector(particles.vel_x[i],particles.vel_y[i]) * dt_sec) > 0) {
+        switch(particle.collision_mode) {
         case CollisionMode::Ignore:
-          particle->pos.x += particle->speedX * dt_sec;
-          particle->pos.y += particle->speedY * dt_sec;
+          particles.pos_x[i] += particles.vel_x[i] * dt_sec;
+          particles.pos_y[i] += particles.vel_y[i] * dt_sec;
           break;
         case CollisionMode::Stick:
           // Just don't move
           break;
         case CollisionMode::StickForever:
-          particle->stuck = true;
+          particle.stuck = true;
           break;
         case CollisionMode::BounceHeavy:
         case CollisionMode::BounceLight:
           {
-            auto c = get_collision(particle, Vector(particle->speedX, particle->speedY) * dt_sec);
+            auto c = get_collision(i, Vector(particles.vel_x[i], particles.vel_y[i]) * dt_sec);
 
-            float speed_angle = atanf(-particle->speedY / particle->speedX);
+            float speed_angle = atanf(-particles.vel_y[i] / particles.vel_x[i]);
             float face_angle = atanf(c.slope_normal.y / c.slope_normal.x);
             if (c.slope_normal.x == 0.f && c.slope_normal.y == 0.f) {
-              auto cX = get_collision(particle, Vector(particle->speedX, 0) * dt_sec);
+              auto cX = get_collision(i, Vector(particles.vel_x[i], 0) * dt_sec);
               if (cX.left != cX.right)
-                particle->speedX *= -1;
-              auto cY = get_collision(particle, Vector(0, particle->speedY) * dt_sec);
+                particles.vel_x[i] *= -1;
+              auto cY = get_collision(i, Vector(0, particles.vel_y[i]) * dt_sec);
               if (cY.top != cY.bottom)
-                particle->speedY *= -1;
+                particles.vel_y[i] *= -1;
             } else {
               float dest_angle = face_angle * 2.f - speed_angle; // Reflect the angle around face_angle
               float dX = cosf(dest_angle),
                     dY = sinf(dest_angle);
 
-              float true_speed = static_cast<float>(sqrt(pow(particle->speedY, 2)
-                                                      + pow(particle->speedX, 2)));
+              float true_speed = static_cast<float>(sqrt(pow(particles.vel_y[i], 2)
+                                                      + pow(particles.vel_x[i], 2)));
 
-              particle->speedX = dX * true_speed;
-              particle->speedY = dY * true_speed;
+              particles.vel_x[i] = dX * true_speed;
+              particles.vel_y[i] = dY * true_speed;
             }
 
-            switch(particle->collision_mode) {
+            switch(particle.collision_mode) {
               case CollisionMode::BounceHeavy:
-                particle->speedX *= .2f;
-                particle->speedY *= .2f;
+                particles.vel_x[i] *= .2f;
+                particles.vel_y[i] *= .2f;
                 break;
               case CollisionMode::BounceLight:
-                particle->speedX *= .7f;
-                particle->speedY *= .7f;
+                particles.vel_x[i] *= .7f;
+                particles.vel_y[i] *= .7f;
                 break;
               default:
                 assert(false);
             }
 
-            particle->pos.x += particle->speedX * dt_sec;
-            particle->pos.y += particle->speedY * dt_sec;
+            particles.pos_x[i] += particles.vel_x[i] * dt_sec;
+            particles.pos_y[i] += particles.vel_y[i] * dt_sec;
           }
           break;
         case CollisionMode::Destroy:
-          particle->ready_for_deletion = true;
+          particle.ready_for_deletion = true;
           break;
         case CollisionMode::FadeOut:
-          particle->lifetime = 0.f;
+          particle.lifetime = 0.f;
           break;
         }
       } else {
-        particle->pos.x += particle->speedX * dt_sec;
-        particle->pos.y += particle->speedY * dt_sec;
+        particles.pos_x[i] += particles.vel_x[i] * dt_sec;
+        particles.pos_y[i] += particles.vel_y[i] * dt_sec;
       }
 
-      switch(particle->angle_mode) {
+      switch(particle.angle_mode) {
       case RotationMode::Facing:
-        particle->angle = atanf(particle->speedY / particle->speedX) * 180.f / math::PI;
+        particles.angle[i] = atanf(particles.vel_y[i] / particles.vel_x[i]) * 180.f / math::PI;
         break;
       case RotationMode::Wiggling:
-        particle->angle += graphicsRandom.randf(-particle->angle_speed / 2.f,
-                                            particle->angle_speed / 2.f) * dt_sec;
+        particles.angle[i] += graphicsRandom.randf(-particle.angle_speed / 2.f,
+                                            particle.angle_speed / 2.f) * dt_sec;
         break;
       case RotationMode::Fixed:
       default:
-        particle->angle_speed += particle->angle_acc * dt_sec;
-        particle->angle_speed *= 1.f - particle->angle_decc * dt_sec;
-        particle->angle += particle->angle_speed * dt_sec;
+        particle.angle_speed += particle.angle_acc * dt_sec;
+        particle.angle_speed *= 1.f - particle.angle_decc * dt_sec;
+        particles.angle[i] += particle.angle_speed * dt_sec;
       }
     }
 
   } // For each particle
 
 
-  // Clear dead particles
-  // Scroll through the vector backwards, because removing an element affects
-  //   the index of all elements after it (prevents buggy behavior)
-  for (int i = static_cast<int>(custom_particles.size()) - 1; i >= 0; --i) {
-    auto particle = dynamic_cast<CustomParticle*>(custom_particles.at(i).get());
-
-    if (particle->ready_for_deletion) {
-      custom_particles.erase(custom_particles.begin()+i);
+  // Clear dead particles; their slots get reused by the next spawns
+  for (size_t i = 0; i < particles.get_slot_count(); ++i) {
+    if (particles.is_alive(i) && custom_particles[i].ready_for_deletion) {
+      particles.release(i);
     }
   }
 
@@ -834,7 +832,7 @@ CustomParticleSystem::update(float dt_sec)
       }
       real_max *= i;
     }
-    while (remaining > m_delay && int(custom_particles.size()) < real_max)
+    while (remaining > m_delay && int(particles.get_count()) < real_max)
     {
       spawn_particles(remaining);
       remaining -= m_delay;
@@ -858,55 +856,55 @@ CustomParticleSystem::draw(DrawingContext& context)
 
   context.push_transform();
 
-  std::unordered_map<SpriteProperties*, SurfaceBatch> batches;
-  for (const auto& particle : custom_particles) {
-    auto it = batches.find(&(particle->props));
-    if (it == batches.end()) {
-      const auto& batch_it = batches.emplace(&(particle->props),
-        SurfaceBatch(particle->props.texture, particle->props.color));
-      batch_it.first->second.draw(Rectf(Vector(
-                                               particle->pos.x - particle->scale
+  for (size_t i = 0; i < particles.get_slot_count(); ++i) {
+    if (!particles.is_alive(i))
+      continue;
+
+    auto& particle = custom_particles[i];
+    const float pos_x = particles.pos_x[i];
+    const float pos_y = particles.pos_y[i];
+    const float scale = particles.scale[i];
+
+    auto& batch = m_batches.get(particle.props.texture, particle.props.color);
+    if (batch.empty()) {
+      batch.draw(Rectf(Vector(
+                                               pos_x - scale
                                                  * static_cast<float>(
-                                                 particle->props.texture->get_width()
-                                               ) * particle->props.scale.x / 2,
-                                               particle->pos.y - particle->scale
+                                                 particle.props.texture->get_width()
+                                               ) * particle.props.scale.x / 2,
+                                               pos_y - scale
                                                  * static_cast<float>(
-                                                 particle->props.texture->get_height()
-                                               ) * particle->props.scale.y / 2
+                                                 particle.props.texture->get_height()
+                                               ) * particle.props.scale.y / 2
                                         ),
                                         Vector(
-                                               particle->pos.x + particle->scale
+                                               pos_x + scale
                                                  * static_cast<float>(
-                                                 particle->props.texture->get_width()
-                                               ) * particle->props.scale.x / 2,
-                                               particle->pos.y + particle->scale
+                                                 particle.props.texture->get_width()
+                                               ) * particle.props.scale.x / 2,
+                                               pos_y + scale
                                                  * static_cast<float>(
-                                                 particle->props.texture->get_height()
-                                               ) * particle->props.scale.y / 2
+                                                 particle.props.texture->get_height()
+                                               ) * particle.props.scale.y / 2
                                         )
-                                 ), particle->angle);
+                                 ), particles.angle[i]);
     } else {
-      it->second.draw(Rectf(particle->pos,
+      batch.draw(Rectf(Vector(pos_x, pos_y),
                                         Vector(
-                                               particle->pos.x + particle->scale
+                                               pos_x + scale
                                                  * static_cast<float>(
-                                                 particle->texture->get_width()
-                                               ) * particle->props.scale.x,
-                                               particle->pos.y + particle->scale
+                                                 particle.props.texture->get_width()
+                                               ) * particle.props.scale.x,
+                                               pos_y + scale
                                                  * static_cast<float>(
-                                                 particle->texture->get_height()
-                                               ) * particle->props.scale.y
+                                                 particle.props.texture->get_height()
+                                               ) * particle.props.scale.y
                                         )
-                                 ), particle->angle);
+                                 ), particles.angle[i]);
     }
   }
 
-  for(auto& it : batches) {
-    auto& surface = it.first->texture;
-    auto& batch = it.second;
-    context.color().draw_surface_batch(surface, batch.move_srcrects(),
-      batch.move_dstrects(), batch.move_angles(), it.first->color, z_pos);
-  }
+  m_batches.draw(context.color(), z_pos);
 
   context.pop_transform();
 }
@@ -914,29 +912,28 @@ CustomParticleSystem::draw(DrawingContext& context)
 // Duplicated from ParticleSystem_Interactive because I intend to bring edits
 // sometime in the future, for even more flexibility with particles. (Semphris)
 int
-CustomParticleSystem::collision(Particle* object, const Vector& movement)
+CustomParticleSystem::collision(size_t index, const Vector& movement)
 {
   using namespace collision;
 
-  CustomParticle* particle = dynamic_cast<CustomParticle*>(object);
-  assert(particle);
+  const CustomParticle& particle = custom_particles[index];
 
   // calculate rectangle where the object will move
   float x1, x2;
   float y1, y2;
 
-  x1 = object->pos.x - particle->props.hb_scale.x * static_cast<float>(particle->props.texture->get_width()) / 2
-          + particle->props.hb_offset.x * static_cast<float>(particle->props.texture->get_width());
-  x2 = x1 + particle->props.hb_scale.x * static_cast<float>(particle->props.texture->get_width()) + movement.x;
+  x1 = particles.pos_x[index] - particle.props.hb_scale.x * static_cast<float>(particle.props.texture->get_width()) / 2
+          + particle.props.hb_offset.x * static_cast<float>(particle.props.texture->get_width());
+  x2 = x1 + particle.props.hb_scale.x * static_cast<float>(particle.props.texture->get_width()) + movement.x;
   if (x2 < x1) {
     float temp_x = x1;
     x1 = x2;
     x2 = temp_x;
   }
 
-  y1 = object->pos.y - particle->props.hb_scale.y * static_cast<float>(particle->props.texture->get_height()) / 2
-          + particle->props.hb_offset.y * static_cast<float>(particle->props.texture->get_height());
-  y2 = y1 + particle->props.hb_scale.y * static_cast<float>(particle->props.texture->get_height()) + movement.y;
+  y1 = particles.pos_y[index] - particle.props.hb_scale.y * static_cast<float>(particle.props.texture->get_height()) / 2
+          + particle.props.hb_offset.y * static_cast<float>(particle.props.texture->get_height());
+  y2 = y1 + particle.props.hb_scale.y * static_cast<float>(particle.props.texture->get_height()) + movement.y;
   if (y2 < y1) {
     float temp_y = y1;
     y1 = y2;
@@ -1003,27 +1000,26 @@ CustomParticleSystem::collision(Particle* object, const Vector& movement)
 }
 
 CollisionHit
-CustomParticleSystem::get_collision(Particle* object, const Vector& movement)
+CustomParticleSystem::get_collision(size_t index, const Vector& movement)
 {
   using namespace collision;
 
-  CustomParticle* particle = dynamic_cast<CustomParticle*>(object);
-  assert(particle);
+  const CustomParticle& particle = custom_particles[index];
 
   // calculate rectangle where the object will move
   float x1, x2;
   float y1, y2;
 
-  x1 = object->pos.x - particle->props.scale.x * static_cast<float>(particle->props.texture->get_width()) / 2;
-  x2 = x1 + particle->props.scale.x * static_cast<float>(particle->props.texture->get_width()) + movement.x;
+  x1 = particles.pos_x[index] - particle.props.scale.x * static_cast<float>(particle.props.texture->get_width()) / 2;
+  x2 = x1 + particle.props.scale.x * static_cast<float>(particle.props.texture->get_width()) + movement.x;
   if (x2 < x1) {
     float temp_x = x1;
     x1 = x2;
     x2 = temp_x;
   }
 
-  y1 = object->pos.y - particle->props.scale.y * static_cast<float>(particle->props.texture->get_height()) / 2;
-  y2 = y1 + particle->props.scale.y * static_cast<float>(particle->props.texture->get_height()) + movement.y;
+  y1 = particles.pos_y[index] - particle.props.scale.y * static_cast<float>(particle.props.texture->get_height()) / 2;
+  y2 = y1 + particle.props.scale.y * static_cast<float>(particle.props.texture->get_height()) + movement.y;
   if (y2 < y1) {
     float temp_y = y1;
     y1 = y2;
@@ -1134,73 +1130,79 @@ CustomParticleSystem::get_abs_y()
 void
 CustomParticleSystem::add_particle(float lifetime, float x, float y)
 {
-  auto particle = std::make_unique<CustomParticle>();
-  particle->original_props = get_random_texture();
-  particle->props = particle->original_props;
+  const size_t i = particles.allocate();
+  if (i < custom_particles.size()) {
+    custom_particles[i] = CustomParticle();
+  } else {
+    assert(i == custom_particles.size());
+    custom_particles.emplace_back();
+  }
 
-  particle->pos.x = x;
-  particle->pos.y = y;
+  auto& particle = custom_particles[i];
+  particle.original_props = get_random_texture();
+  particle.props = particle.original_props;
+
+  particles.pos_x[i] = x;
+  particles.pos_y[i] = y;
 
   float life_elapsed = lifetime;
   float birth_delta = m_particle_birth_time_variation / 2;
-  particle->total_birth = m_particle_birth_time + graphicsRandom.randf(-birth_delta, birth_delta);
-  particle->birth_time = particle->total_birth - life_elapsed;
-  if (particle->birth_time < 0.f) {
-    life_elapsed = -particle->birth_time;
-    particle->birth_time = 0.f;
+  particle.total_birth = m_particle_birth_time + graphicsRandom.randf(-birth_delta, birth_delta);
+  particle.birth_time = particle.total_birth - life_elapsed;
+  if (particle.birth_time < 0.f) {
+    life_elapsed = -particle.birth_time;
+    particle.birth_time = 0.f;
   } else {
     life_elapsed = 0.f;
   }
   float life_delta = m_particle_lifetime_variation / 2;
-  particle->lifetime = m_particle_lifetime - life_elapsed + graphicsRandom.randf(-life_delta, life_delta);
-  if (particle->lifetime < 0.f) {
-    life_elapsed = -particle->lifetime;
-    particle->lifetime = 0.f;
+  particle.lifetime = m_particle_lifetime - life_elapsed + graphicsRandom.randf(-life_delta, life_delta);
+  if (particle.lifetime < 0.f) {
+    life_elapsed = -particle.lifetime;
+    particle.lifetime = 0.f;
   } else {
     life_elapsed = 0.f;
   }
   float death_delta = m_particle_death_time_variation / 2;
-  particle->total_death = m_particle_death_time + graphicsRandom.randf(-death_delta, death_delta);
-  particle->death_time = particle->total_death - life_elapsed;
+  particle.total_death = m_particle_death_time + graphicsRandom.randf(-death_delta, death_delta);
+  particle.death_time = particle.total_death - life_elapsed;
 
-  particle->birth_mode = m_particle_birth_mode;
-  particle->death_mode = m_particle_death_mode;
+  particle.birth_mode = m_particle_birth_mode;
+  particle.death_mode = m_particle_death_mode;
 
-  particle->birth_easing = m_particle_birth_easing;
-  particle->death_easing = m_particle_death_easing;
+  particle.birth_easing = m_particle_birth_easing;
+  particle.death_easing = m_particle_death_easing;
 
-  switch(particle->birth_mode) {
+  switch(particle.birth_mode) {
   case FadeMode::Shrink:
-    particle->scale = 0.f;
+    particles.scale[i] = 0.f;
     break;
   default:
     break;
   }
 
   float speedx_delta = m_particle_speed_variation_x / 2;
-  particle->speedX = m_particle_speed_x + graphicsRandom.randf(-speedx_delta, speedx_delta);
+  particles.vel_x[i] = m_particle_speed_x + graphicsRandom.randf(-speedx_delta, speedx_delta);
   float speedy_delta = m_particle_speed_variation_y / 2;
-  particle->speedY = m_particle_speed_y + graphicsRandom.randf(-speedy_delta, speedy_delta);
-  particle->accX = m_particle_acceleration_x;
-  particle->accY = m_particle_acceleration_y;
-  particle->frictionX = m_particle_friction_x;
-  particle->frictionY = m_particle_friction_y;
+  particles.vel_y[i] = m_particle_speed_y + graphicsRandom.randf(-speedy_delta, speedy_delta);
+  particle.accX = m_particle_acceleration_x;
+  particle.accY = m_particle_acceleration_y;
+  particle.frictionX = m_particle_friction_x;
+  particle.frictionY = m_particle_friction_y;
 
-  particle->feather_factor = m_particle_feather_factor;
+  particle.feather_factor = m_particle_feather_factor;
 
   float angle_delta = m_particle_rotation_variation / 2;
-  particle->angle = m_particle_rotation + graphicsRandom.randf(-angle_delta, angle_delta);
+  particles.angle[i] = m_particle_rotation + graphicsRandom.randf(-angle_delta, angle_delta);
   float angle_speed_delta = m_particle_rotation_speed_variation / 2;
-  particle->angle_speed = m_particle_rotation_speed + graphicsRandom.randf(-angle_speed_delta, angle_speed_delta);
-  particle->angle_acc = m_particle_rotation_acceleration;
-  particle->angle_decc = m_particle_rotation_decceleration;
-  particle->angle_mode = m_particle_rotation_mode;
-
-  particle->collision_mode = m_particle_collision_mode;
+  particle.angle_speed = m_particle_rotation_speed + graphicsRandom.randf(-angle_speed_delta, angle_speed_delta);
+  particle.angle_acc = m_particle_rotation_acceleration;
+  particle.angle_decc = m_particle_rotation_decceleration;
+  particle.angle_mode = m_particle_rotation_mode;
 
-  particle->offscreen_mode = m_particle_offscreen_mode;
+  particle.collision_mode = m_particle_collision_mode;
 
-  custom_particles.push_back(std::move(particle));
+  particle.offscreen_mode = m_particle_offscreen_mode;
 }
 
 void
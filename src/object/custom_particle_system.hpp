@@ -60,8 +60,8 @@ public:
 
   //void fade_amount(int new_amount, float fade_time);
 protected:
-  virtual int collision(Particle* particle, const Vector& movement) override;
-  CollisionHit get_collision(Particle* particle, const Vector& movement);
+  virtual int collision(size_t index, const Vector& movement) override;
+  CollisionHit get_collision(size_t index, const Vector& movement);
 
 private:
   struct ease_request
@@ -88,7 +88,7 @@ private:
 
 public:
   // Scripting
-  void clear() { custom_particles.clear(); }
+  void clear() { particles.clear(); }
   void ease_value(float* value, float target, float time, easing func);
 
 private:
@@ -179,7 +179,9 @@ private:
 
   SpriteProperties get_random_texture();
 
-  class CustomParticle : public Particle
+  /** Per-particle state that isn't shared with the other particle systems.
+      Position, velocity, angle and scale live in the pool. */
+  class CustomParticle final
   {
   public:
     SpriteProperties original_props, props;
@@ -188,8 +190,7 @@ private:
     FadeMode birth_mode, death_mode;
     EasingMode birth_easing, death_easing;
     bool ready_for_deletion;
-    float speedX, speedY,
-          accX, accY,
+    float accX, accY,
           frictionX, frictionY;
     float feather_factor;
     float angle_speed, angle_acc,
@@ -202,9 +203,11 @@ private:
     bool last_life_zone_required_instakill;
     bool stuck;
 
+    // The sprite properties are always assigned when the particle spawns,
+    // so don't have them load the default texture here
     CustomParticle() :
-      original_props(),
-      props(),
+      original_props(SurfacePtr()),
+      props(SurfacePtr()),
       lifetime(),
       birth_time(),
       death_time(),
@@ -215,8 +218,6 @@ private:
       birth_easing(),
       death_easing(),
       ready_for_deletion(false),
-      speedX(),
-      speedY(),
       accX(),
       accY(),
       frictionX(),
@@ -236,7 +237,8 @@ private:
   };
 
   std::vector<SpriteProperties> m_textures;
-  std::vector<std::unique_ptr<CustomParticle> > custom_particles;
+  // Indexed like the slots of the particle pool
+  std::vector<CustomParticle> custom_particles;
 
   std::string m_particle_main_texture;
   int m_max_amount;
@@ -68,9 +68,9 @@ Explosion::explode()
   m_sprite->set_animation_loops(1); //TODO: this is necessary because set_action will not set "loops" when "action" is the default action
   m_sprite->set_angle(graphicsRandom.randf(0, 360)); // a random rotation on the sprite to make explosions appear more random
   if (hurt)
-    SoundManager::current()->play("sounds/explosion.wav", get_pos(), 0.98f);
+    SoundManager::current()->play("sounds/explosion.wav", get_pos(), 0.98f, SoundManager::PRIORITY_LOW);
   else
-    SoundManager::current()->play("sounds/firecracker.ogg", get_pos(), 0.7f);
+    SoundManager::current()->play("sounds/firecracker.ogg", get_pos(), 0.7f, SoundManager::PRIORITY_LOW);
   bool does_push = push_strength > 0;
 
   // spawn some particles
@@ -53,14 +53,15 @@ GhostParticleSystem::init()
   // create two ghosts
   size_t ghostcount = 2;
   for (size_t i=0; i<ghostcount; ++i) {
-    auto particle = std::make_unique<GhostParticle>();
-    particle->pos.x = graphicsRandom.randf(virtual_width);
-    particle->pos.y = graphicsRandom.randf(static_cast<float>(SCREEN_HEIGHT));
+    const size_t index = particles.allocate();
+    particles.pos_x[index] = graphicsRandom.randf(virtual_width);
+    particles.pos_y[index] = graphicsRandom.randf(static_cast<float>(SCREEN_HEIGHT));
     int size = graphicsRandom.rand(2);
-    particle->texture = ghosts[size];
-    particle->speed = graphicsRandom.randf(std::max(50.0f, static_cast<float>(size) * 10.0f),
-                                           180.0f + static_cast<float>(size) * 10.0f);
-    particles.push_back(std::move(particle));
+    particles.texture[index] = ghosts[size];
+    float speed = graphicsRandom.randf(std::max(50.0f, static_cast<float>(size) * 10.0f),
+                                       180.0f + static_cast<float>(size) * 10.0f);
+    particles.vel_x[index] = -speed;
+    particles.vel_y[index] = -speed;
   }
 }
 
@@ -70,13 +71,12 @@ GhostParticleSystem::update(float dt_sec)
   if (!enabled)
     return;
 
-  for (const auto& part : particles) {
-    const auto& particle = dynamic_cast<GhostParticle*>(part.get());
-    particle->pos.y -= particle->speed * dt_sec;
-    particle->pos.x -= particle->speed * dt_sec;
-    if (particle->pos.y > static_cast<float>(SCREEN_HEIGHT)) {
-      particle->pos.y = fmodf(particle->pos.y , virtual_height);
-      particle->pos.x = graphicsRandom.randf(virtual_width);
+  particles.integrate(dt_sec);
+
+  for (size_t i = 0; i < particles.get_slot_count(); ++i) {
+    if (particles.pos_y[i] > static_cast<float>(SCREEN_HEIGHT)) {
+      particles.pos_y[i] = fmodf(particles.pos_y[i], virtual_height);
+      particles.pos_x[i] = graphicsRandom.randf(virtual_width);
     }
   }
 }
@@ -40,16 +40,6 @@ public:
   }
 
 private:
-  class GhostParticle : public Particle
-  {
-  public:
-    float speed;
-
-    GhostParticle() :
-      speed()
-    {}
-  };
-
   SurfacePtr ghosts[2];
 
 private:
@@ -145,7 +145,7 @@ IceCrusher::collision(GameObject& other, const CollisionHit& hit)
   // If the other object is the player, and the collision is at the
   // bottom of the ice crusher, hurt the player.
   if (player && hit.bottom && state == CRUSHING) {
-    SoundManager::current()->play("sounds/brick.wav");
+    SoundManager::current()->play("sounds/brick.wav", 0.5f, SoundManager::PRIORITY_LOW);
     set_state(RECOVERING);
     if (player->is_invincible()) {
       return ABORT_MOVE;
@@ -177,7 +177,7 @@ IceCrusher::collision_solid(const CollisionHit& hit)
         if (ic_size == LARGE) {
           cooldown_timer = PAUSE_TIME_LARGE;
           Sector::get().get_camera().shake (0.125f, 0.0f, 16.0f);
-          SoundManager::current()->play("sounds/brick.wav");
+          SoundManager::current()->play("sounds/brick.wav", 0.5f, SoundManager::PRIORITY_LOW);
           // throw some particles, bigger and more for large icecrusher
           for (int j = 0; j < 9; j++)
           {
@@ -201,7 +201,7 @@ IceCrusher::collision_solid(const CollisionHit& hit)
           }
           else
           {
-            SoundManager::current()->play("sounds/brick.wav");
+            SoundManager::current()->play("sounds/brick.wav", 0.5f, SoundManager::PRIORITY_LOW);
           }
           // throw some particles
           for (int j = 0; j < 5; j++)
@@ -228,7 +228,7 @@ IceCrusher::collision_solid(const CollisionHit& hit)
     {
           cooldown_timer = PAUSE_TIME_LARGE;
           Sector::get().get_camera().shake (0.125f, 0.0f, 16.0f);
-          SoundManager::current()->play("sounds/brick.wav");
+          SoundManager::current()->play("sounds/brick.wav", 0.5f, SoundManager::PRIORITY_LOW);
         }
 		  else
     {
@@ -241,7 +241,7 @@ IceCrusher::collision_solid(const CollisionHit& hit)
           }
           else
           {
-            SoundManager::current()->play("sounds/brick.wav");
+            SoundManager::current()->play("sounds/brick.wav", 0.5f, SoundManager::PRIORITY_LOW);
           }
         }
 		set_state(RECOVERING_RIGHT);
@@ -254,7 +254,7 @@ IceCrusher::collision_solid(const CollisionHit& hit)
     {
           cooldown_timer = PAUSE_TIME_LARGE;
           Sector::get().get_camera().shake (0.125f, 0.0f, 16.0f);
-          SoundManager::current()->play("sounds/brick.wav");
+          SoundManager::current()->play("sounds/brick.wav", 0.5f, SoundManager::PRIORITY_LOW);
         }
 		  else
     {
@@ -267,7 +267,7 @@ IceCrusher::collision_solid(const CollisionHit& hit)
           }
           else
           {
-            SoundManager::current()->play("sounds/brick.wav");
+            SoundManager::current()->play("sounds/brick.wav", 0.5f, SoundManager::PRIORITY_LOW);
           }
         }
 		set_state(RECOVERING_LEFT);
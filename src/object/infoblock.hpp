@@ -31,6 +31,7 @@ public:
 
   virtual void update(float dt_sec) override;
   virtual void draw(DrawingContext& context) override;
+  virtual bool draws_outside_bbox() const override { return m_shown_pct > 0; }
 
   virtual std::string get_class() const override { return "infoblock"; }
   virtual std::string get_display_name() const override { return _("Info Block"); }
@@ -51,7 +51,7 @@ InvisibleWall::get_settings()
 
 void
 InvisibleWall::after_editor_set() {
-  m_col.m_bbox.set_size(width, height);
+  m_col.set_size(width, height);
 }
 
 HitResponse
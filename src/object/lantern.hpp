@@ -27,6 +27,7 @@ public:
   Lantern(const ReaderMapping& reader);
 
   virtual void draw(DrawingContext& context) override;
+  virtual bool draws_outside_bbox() const override { return true; }
 
   virtual HitResponse collision(GameObject& other, const CollisionHit& hit) override;
 
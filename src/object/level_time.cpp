@@ -92,10 +92,10 @@ LevelTime::draw(DrawingContext& context)
                                    Vector((static_cast<float>(context.get_width()) - all_width) / 2.0f,
                                           BORDER_Y + 1),
                                    LAYER_FOREGROUND1);
-      context.color().draw_text(Resources::normal_font, time_text,
-                                Vector((static_cast<float>(context.get_width()) - all_width) / 2.0f + static_cast<float>(time_surface->get_width()),
-                                       BORDER_Y),
-                                ALIGN_LEFT, LAYER_FOREGROUND1, LevelTime::text_color);
+      context.color().draw_dynamic_text(Resources::normal_font, time_text,
+                                        Vector((static_cast<float>(context.get_width()) - all_width) / 2.0f + static_cast<float>(time_surface->get_width()),
+                                               BORDER_Y),
+                                        ALIGN_LEFT, LAYER_FOREGROUND1, LevelTime::text_color);
     }
   }
 
@@ -37,6 +37,7 @@ public:
   virtual HitResponse collision(GameObject& other, const CollisionHit& hit) override;
   virtual void update(float dt_sec) override;
   virtual void draw(DrawingContext& context) override;
+  virtual bool draws_outside_bbox() const override { return true; }
   virtual std::string get_class() const override { return "magicblock"; }
   virtual std::string get_display_name() const override { return _("Magic Tile"); }
 
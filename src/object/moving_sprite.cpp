@@ -16,6 +16,7 @@
 
 #include "object/moving_sprite.hpp"
 
+#include <algorithm>
 #include <math.h>
 #include <physfs.h>
 
@@ -103,6 +104,28 @@ MovingSprite::draw(DrawingContext& context)
   m_sprite->draw(context.color(), get_pos(), m_layer);
 }
 
+float
+MovingSprite::get_draw_margin() const
+{
+  if (m_sprite->get_frames() == 0)
+    return MovingObject::get_draw_margin();
+
+  // The sprite is drawn from the hitbox offset, it may overhang the bbox on
+  // every side
+  const float x_offset = m_sprite->get_current_hitbox_x_offset();
+  const float y_offset = m_sprite->get_current_hitbox_y_offset();
+  const float overhang = std::max({ x_offset, y_offset,
+                                    static_cast<float>(m_sprite->get_width()) - x_offset - m_col.m_bbox.get_width(),
+                                    static_cast<float>(m_sprite->get_height()) - y_offset - m_col.m_bbox.get_height() });
+  return std::max(overhang, 0.0f) + MovingObject::get_draw_margin();
+}
+
+void
+MovingSprite::skip_draw()
+{
+  m_sprite->update();
+}
+
 void
 MovingSprite::update(float )
 {
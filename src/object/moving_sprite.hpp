@@ -46,6 +46,8 @@ public:
                CollisionGroup collision_group = COLGROUP_MOVING);
 
   virtual void draw(DrawingContext& context) override;
+  virtual float get_draw_margin() const override;
+  virtual void skip_draw() override;
   virtual void update(float dt_sec) override;
   virtual std::string get_class() const override { return "moving-sprite"; }
   virtual std::string get_default_sprite_name() const { return m_default_sprite_name; }
@@ -0,0 +1,193 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "object/particle_pool.hpp"
+
+#include <assert.h>
+#include <math.h>
+
+#include "math/rectf.hpp"
+
+ParticlePool::ParticlePool() :
+  pos_x(),
+  pos_y(),
+  vel_x(),
+  vel_y(),
+  age(),
+  alpha(),
+  angle(),
+  scale(),
+  texture(),
+  m_alive(),
+  m_free_slots(),
+  m_count(0)
+{
+}
+
+size_t
+ParticlePool::allocate()
+{
+  size_t index;
+
+  if (m_free_slots.empty())
+  {
+    index = m_alive.size();
+
+    pos_x.push_back(0.0f);
+    pos_y.push_back(0.0f);
+    vel_x.push_back(0.0f);
+    vel_y.push_back(0.0f);
+    age.push_back(0.0f);
+    alpha.push_back(1.0f);
+    angle.push_back(0.0f);
+    scale.push_back(1.0f);
+    texture.push_back(SurfacePtr());
+    m_alive.push_back(1);
+  }
+  else
+  {
+    index = m_free_slots.back();
+    m_free_slots.pop_back();
+
+    pos_x[index] = 0.0f;
+    pos_y[index] = 0.0f;
+    vel_x[index] = 0.0f;
+    vel_y[index] = 0.0f;
+    age[index] = 0.0f;
+    alpha[index] = 1.0f;
+    angle[index] = 0.0f;
+    scale[index] = 1.0f;
+    m_alive[index] = 1;
+  }
+
+  m_count += 1;
+  return index;
+}
+
+void
+ParticlePool::release(size_t index)
+{
+  assert(index < m_alive.size());
+
+  if (!m_alive[index])
+    return;
+
+  m_alive[index] = 0;
+  // Don't keep the surface alive just because a dead particle used it
+  texture[index].reset();
+  m_free_slots.push_back(index);
+  m_count -= 1;
+}
+
+void
+ParticlePool::clear()
+{
+  pos_x.clear();
+  pos_y.clear();
+  vel_x.clear();
+  vel_y.clear();
+  age.clear();
+  alpha.clear();
+  angle.clear();
+  scale.clear();
+  texture.clear();
+  m_alive.clear();
+  m_free_slots.clear();
+  m_count = 0;
+}
+
+void
+ParticlePool::reserve(size_t capacity)
+{
+  pos_x.reserve(capacity);
+  pos_y.reserve(capacity);
+  vel_x.reserve(capacity);
+  vel_y.reserve(capacity);
+  age.reserve(capacity);
+  alpha.reserve(capacity);
+  angle.reserve(capacity);
+  scale.reserve(capacity);
+  texture.reserve(capacity);
+  m_alive.reserve(capacity);
+}
+
+void
+ParticlePool::integrate(float dt_sec, float velocity_scale, const Vector& acceleration)
+{
+  const size_t count = m_alive.size();
+  const float dvx = acceleration.x * dt_sec;
+  const float dvy = acceleration.y * dt_sec;
+  const float step = velocity_scale * dt_sec;
+
+  // Plain loops over separate arrays, so that the compiler can vectorize them
+  float* vx = vel_x.data();
+  float* vy = vel_y.data();
+  float* px = pos_x.data();
+  float* py = pos_y.data();
+  float* a = age.data();
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    vx[i] += dvx;
+    px[i] += vx[i] * step;
+  }
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    vy[i] += dvy;
+    py[i] += vy[i] * step;
+  }
+
+  for (size_t i = 0; i < count; ++i)
+    a[i] += dt_sec;
+}
+
+void
+ParticlePool::wrap(const Rectf& region)
+{
+  wrap_x(region.get_left(), region.get_width());
+  wrap_y(region.get_top(), region.get_height());
+}
+
+void
+ParticlePool::wrap_x(float left, float width)
+{
+  if (width <= 0.0f)
+    return;
+
+  const size_t count = m_alive.size();
+  const float inv_width = 1.0f / width;
+  float* px = pos_x.data();
+
+  for (size_t i = 0; i < count; ++i)
+    px[i] -= width * floorf((px[i] - left) * inv_width);
+}
+
+void
+ParticlePool::wrap_y(float top, float height)
+{
+  if (height <= 0.0f)
+    return;
+
+  const size_t count = m_alive.size();
+  const float inv_height = 1.0f / height;
+  float* py = pos_y.data();
+
+  for (size_t i = 0; i < count; ++i)
+    py[i] -= height * floorf((py[i] - top) * inv_height);
+}
+
+/* EOF */
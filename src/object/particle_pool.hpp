@@ -0,0 +1,113 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_OBJECT_PARTICLE_POOL_HPP
+#define HEADER_SUPERTUX_OBJECT_PARTICLE_POOL_HPP
+
+#include <stdint.h>
+#include <vector>
+
+#include "math/vector.hpp"
+#include "video/surface_ptr.hpp"
+
+class Rectf;
+
+/**
+  Contiguous storage for the particles of a particle system.
+
+  Every attribute lives in its own array ("structure of arrays"), so the
+  update loops walk linear memory instead of chasing one heap allocation
+  per particle. A particle is identified by its slot index, which stays
+  valid until the particle is released. Released slots are kept on a free
+  list and handed out again by allocate(), so a system that keeps a steady
+  amount of particles alive stops allocating once the pool has grown.
+
+  Systems that need extra per-particle data keep their own arrays indexed
+  by the same slot (see get_slot_count()).
+ */
+class ParticlePool final
+{
+public:
+  ParticlePool();
+
+  /** Returns the slot of a new particle with default values. Reuses the
+      slot of a released particle if there is one. */
+  size_t allocate();
+
+  /** Marks the slot as free; it may be returned by the next allocate(). */
+  void release(size_t index);
+
+  /** Releases every particle, keeping the allocated memory around. */
+  void clear();
+
+  void reserve(size_t capacity);
+
+  /** Number of slots, alive or not; loops over the pool go up to this. */
+  size_t get_slot_count() const { return m_alive.size(); }
+
+  /** Number of particles currently alive */
+  size_t get_count() const { return m_count; }
+
+  bool is_alive(size_t index) const { return m_alive[index] != 0; }
+
+  /** Moves all particles by their velocity (multiplied by
+      velocity_scale), after accelerating them by acceleration (gravity,
+      wind). Also advances the age of each particle. Free slots are
+      processed as well, which keeps the loop free of branches so that the
+      compiler can vectorize it. */
+  void integrate(float dt_sec, float velocity_scale = 1.0f,
+                 const Vector& acceleration = Vector(0.0f, 0.0f));
+
+  /** Wraps the position of all particles back into region, so that
+      particles leaving on one side reenter on the opposite side. */
+  void wrap(const Rectf& region);
+
+  /** Same as wrap(), for the horizontal axis only. */
+  void wrap_x(float left, float width);
+
+  /** Same as wrap(), for the vertical axis only. */
+  void wrap_y(float top, float height);
+
+public:
+  std::vector<float> pos_x;
+  std::vector<float> pos_y;
+  std::vector<float> vel_x;
+  std::vector<float> vel_y;
+
+  /** Seconds since the particle was allocated */
+  std::vector<float> age;
+
+  std::vector<float> alpha;
+
+  /** Angle at which to draw the particle, in degrees */
+  std::vector<float> angle;
+
+  std::vector<float> scale;
+  std::vector<SurfacePtr> texture;
+
+private:
+  std::vector<uint8_t> m_alive;
+  std::vector<size_t> m_free_slots;
+  size_t m_count;
+
+private:
+  ParticlePool(const ParticlePool&) = delete;
+  ParticlePool& operator=(const ParticlePool&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -36,7 +36,8 @@ ParticleSystem::ParticleSystem(const ReaderMapping& reader, float max_particle_s
   particles(),
   virtual_width(static_cast<float>(SCREEN_WIDTH) + max_particle_size * 2.0f),
   virtual_height(static_cast<float>(SCREEN_HEIGHT) + max_particle_size * 2.0f),
-  enabled(true)
+  enabled(true),
+  m_batches()
 {
   reader.get("enabled", enabled, true);
   z_pos = reader_get_layer(reader, LAYER_BACKGROUND1);
@@ -50,7 +51,8 @@ ParticleSystem::ParticleSystem(float max_particle_size_) :
   particles(),
   virtual_width(static_cast<float>(SCREEN_WIDTH) + max_particle_size * 2.0f),
   virtual_height(static_cast<float>(SCREEN_HEIGHT) + max_particle_size * 2.0f),
-  enabled(true)
+  enabled(true),
+  m_batches()
 {
 }
 
@@ -85,42 +87,31 @@ ParticleSystem::draw(DrawingContext& context)
   context.push_transform();
   context.set_translation(Vector(max_particle_size,max_particle_size));
 
-  std::unordered_map<SurfacePtr, SurfaceBatch> batches;
-  for (const auto& particle : particles)
+  for (size_t i = 0; i < particles.get_slot_count(); ++i)
   {
+    if (!particles.is_alive(i))
+      continue;
+
+    const SurfacePtr& texture = particles.texture[i];
+
     // remap x,y coordinates onto screencoordinates
     Vector pos(0.0f, 0.0f);
 
     // horizontal wrap when particle goes off screen to the left
-    const int particle_width = particle->texture->get_width();
-    pos.x = fmodf(particle->pos.x - scrollx, virtual_width);
+    const int particle_width = texture->get_width();
+    pos.x = fmodf(particles.pos_x[i] - scrollx, virtual_width);
     if ((pos.x + static_cast<float>(particle_width)) < 0) pos.x += virtual_width;
 
-    pos.y = fmodf(particle->pos.y - scrolly, virtual_height);
+    pos.y = fmodf(particles.pos_y[i] - scrolly, virtual_height);
     if (pos.y < 0) pos.y += virtual_height;
 
     //if(pos.x > virtual_width) pos.x -= virtual_width;
     //if(pos.y > virtual_height) pos.y -= virtual_height;
 
-    auto it = batches.find(particle->texture);
-    if (it == batches.end()) {
-      const auto& batch_it = batches.emplace(particle->texture, SurfaceBatch(particle->texture));
-      batch_it.first->second.draw(pos, particle->angle);
-    } else {
-      it->second.draw(pos, particle->angle);
-    }
+    m_batches.get(texture).draw(pos, particles.angle[i]);
   }
 
-  for(auto& it : batches) {
-    auto& surface = it.first;
-    auto& batch = it.second;
-    context.color().draw_surface_batch(surface,
-                                       batch.move_srcrects(),
-                                       batch.move_dstrects(),
-                                       batch.move_angles(),
-                                       batch.get_color(),
-                                       z_pos);
-  }
+  m_batches.draw(context.color(), z_pos);
 
   context.pop_transform();
 }
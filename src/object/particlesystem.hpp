@@ -17,12 +17,12 @@
 #ifndef HEADER_SUPERTUX_OBJECT_PARTICLESYSTEM_HPP
 #define HEADER_SUPERTUX_OBJECT_PARTICLESYSTEM_HPP
 
-#include <vector>
-
 #include "math/vector.hpp"
+#include "object/particle_pool.hpp"
 #include "squirrel/exposed_object.hpp"
 #include "scripting/particlesystem.hpp"
 #include "supertux/game_object.hpp"
+#include "video/surface_batch.hpp"
 #include "video/surface_ptr.hpp"
 
 class ReaderMapping;
@@ -39,6 +39,9 @@ class ReaderMapping;
   modulo on the particle coordinates, so when a particle leaves left,
   it'll reenter at the right side.
 
+  Particles are stored in a ParticlePool; subclasses that need more
+  per-particle data keep it in arrays indexed by the particle's slot.
+
   Classes that implement a particle system should subclass from this
   class, initialize particles in the constructor and move them in the
   simulate function.
@@ -62,41 +65,17 @@ public:
 
   int get_layer() const { return z_pos; }
 
-protected:
-  class Particle
-  {
-  public:
-    Particle() :
-      pos(0.0f, 0.0f),
-      angle(),
-      texture(),
-      alpha(),
-      scale(1.f) // This currently only works in the custom particle system
-    {}
-
-    virtual ~Particle()
-    {}
-
-    Vector pos;
-    // angle at which to draw particle
-    float angle;
-    SurfacePtr texture;
-    float alpha;
-    float scale; // see initializer
-
-  private:
-    Particle(const Particle&) = delete;
-    Particle& operator=(const Particle&) = delete;
-  };
-
 protected:
   float max_particle_size;
   int z_pos;
-  std::vector<std::unique_ptr<Particle> > particles;
+  ParticlePool particles;
   float virtual_width;
   float virtual_height;
   bool enabled;
 
+  /** Kept between frames by draw() */
+  SurfaceBatches m_batches;
+
 private:
   ParticleSystem(const ParticleSystem&) = delete;
   ParticleSystem& operator=(const ParticleSystem&) = delete;
@@ -63,31 +63,23 @@ ParticleSystem_Interactive::draw(DrawingContext& context)
 
   context.push_transform();
 
-  std::unordered_map<SurfacePtr, SurfaceBatch> batches;
-  for (const auto& particle : particles) {
-    auto it = batches.find(particle->texture);
-    if (it == batches.end()) {
-      const auto& batch_it = batches.emplace(particle->texture,
-        SurfaceBatch(particle->texture));
-      batch_it.first->second.draw(particle->pos, particle->angle);
-    } else {
-      it->second.draw(particle->pos, particle->angle);
-    }
-  }
+  for (size_t i = 0; i < particles.get_slot_count(); ++i) {
+    if (!particles.is_alive(i))
+      continue;
 
-  for(auto& it : batches) {
-    auto& surface = it.first;
-    auto& batch = it.second;
-    // FIXME: What is the colour used for?
-    context.color().draw_surface_batch(surface, batch.move_srcrects(),
-      batch.move_dstrects(), batch.move_angles(), Color::WHITE, z_pos);
+    const SurfacePtr& texture = particles.texture[i];
+    const Vector pos(particles.pos_x[i], particles.pos_y[i]);
+
+    m_batches.get(texture).draw(pos, particles.angle[i]);
   }
 
+  m_batches.draw(context.color(), z_pos);
+
   context.pop_transform();
 }
 
 int
-ParticleSystem_Interactive::collision(Particle* object, const Vector& movement)
+ParticleSystem_Interactive::collision(size_t index, const Vector& movement)
 {
   using namespace collision;
 
@@ -95,18 +87,18 @@ ParticleSystem_Interactive::collision(Particle* object, const Vector& movement)
   float x1, x2;
   float y1, y2;
 
-  x1 = object->pos.x;
+  x1 = particles.pos_x[index];
   x2 = x1 + 32 + movement.x;
   if (x2 < x1) {
     x1 = x2;
-    x2 = object->pos.x;
+    x2 = particles.pos_x[index];
   }
 
-  y1 = object->pos.y;
+  y1 = particles.pos_y[index];
   y2 = y1 + 32 + movement.y;
   if (y2 < y1) {
     y1 = y2;
-    y2 = object->pos.y;
+    y2 = particles.pos_y[index];
   }
   bool water = false;
 
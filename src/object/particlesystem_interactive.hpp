@@ -49,7 +49,9 @@ public:
   }
 
 protected:
-  virtual int collision(Particle* particle, const Vector& movement);
+  /** Checks the particle in the given slot of the pool against the solid
+      tilemaps of the current sector. */
+  virtual int collision(size_t index, const Vector& movement);
 
 private:
   ParticleSystem_Interactive(const ParticleSystem_Interactive&) = delete;
@@ -54,7 +54,7 @@ Platform::finish_construction()
     init_path_pos(m_col.m_bbox.p1(), false);
   }
 
-  m_col.m_bbox.set_pos(get_path()->get_base());
+  m_col.set_pos(get_path()->get_base());
 }
 
 ObjectSettings
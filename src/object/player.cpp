@@ -966,9 +966,9 @@ Player::do_jump(float yspeed) {
 
   // play sound
   if (is_big()) {
-    SoundManager::current()->play("sounds/bigjump.wav");
+    SoundManager::current()->play("sounds/bigjump.wav", 0.5f, SoundManager::PRIORITY_HIGH);
   } else {
-    SoundManager::current()->play("sounds/jump.wav");
+    SoundManager::current()->play("sounds/jump.wav", 0.5f, SoundManager::PRIORITY_HIGH);
   }
 }
 
@@ -1070,7 +1070,8 @@ Player::handle_vertical_input()
   //The real walljumping magic
   if (m_controller->pressed(Control::JUMP) && m_can_walljump && !m_backflipping)
   {
-    SoundManager::current()->play((is_big()) ? "sounds/bigjump.wav" : "sounds/jump.wav");
+    SoundManager::current()->play((is_big()) ? "sounds/bigjump.wav" : "sounds/jump.wav",
+      0.5f, SoundManager::PRIORITY_HIGH);
     m_physic.set_velocity_x(m_player_status.bonus == AIR_BONUS ?
       m_on_left_wall ? 480.f : -480.f : m_on_left_wall ? 380.f : -380.f);
     do_jump(-520.f);
@@ -1900,7 +1901,7 @@ Player::kill(bool completely)
   m_lightsprite->set_angle(0.0f);
 
   if (!completely && is_big()) {
-    SoundManager::current()->play("sounds/hurt.wav");
+    SoundManager::current()->play("sounds/hurt.wav", 0.5f, SoundManager::PRIORITY_HIGH);
 
     if (m_player_status.bonus == FIRE_BONUS
       || m_player_status.bonus == ICE_BONUS
@@ -1915,7 +1916,7 @@ Player::kill(bool completely)
       set_bonus(NO_BONUS, true);
     }
   } else {
-    SoundManager::current()->play("sounds/kill.wav");
+    SoundManager::current()->play("sounds/kill.wav", 0.5f, SoundManager::PRIORITY_HIGH);
 
     // do not die when in edit mode
     if (m_edit_mode) {
@@ -47,7 +47,8 @@ RainParticleSystem::RainParticleSystem() :
   m_current_amount(1.f),
   m_target_amount(1.f),
   m_amount_fade_time_remaining(0.f),
-  m_current_real_amount(0.f)
+  m_current_real_amount(0.f),
+  speed()
 {
   init();
 }
@@ -69,7 +70,8 @@ RainParticleSystem::RainParticleSystem(const ReaderMapping& reader) :
   m_current_amount(1.f),
   m_target_amount(1.f),
   m_amount_fade_time_remaining(0.f),
-  m_current_real_amount(0.f)
+  m_current_real_amount(0.f),
+  speed()
 {
   reader.get("intensity", m_current_amount, 1.f);
   reader.get("angle", m_current_angle, 1.f);
@@ -118,19 +120,28 @@ void RainParticleSystem::set_amount(float amount)
   
   if (delta > 0) {
     for (int i=0; i<delta; ++i) {
-      auto particle = std::make_unique<RainParticle>();
-      particle->pos.x = static_cast<float>(graphicsRandom.rand(int(virtual_width)));
-      particle->pos.y = static_cast<float>(graphicsRandom.rand(int(virtual_height)));
+      const size_t index = particles.allocate();
+      if (index >= speed.size())
+        speed.resize(index + 1);
+
+      particles.pos_x[index] = static_cast<float>(graphicsRandom.rand(int(virtual_width)));
+      particles.pos_y[index] = static_cast<float>(graphicsRandom.rand(int(virtual_height)));
       int rainsize = graphicsRandom.rand(2);
-      particle->texture = rainimages[rainsize];
+      particles.texture[index] = rainimages[rainsize];
       do {
-        particle->speed = ((static_cast<float>(rainsize) + 1.0f) * 45.0f + graphicsRandom.randf(3.6f));
-      } while(particle->speed < 1);
-      particles.push_back(std::move(particle));
+        speed[index] = ((static_cast<float>(rainsize) + 1.0f) * 45.0f + graphicsRandom.randf(3.6f));
+      } while(speed[index] < 1);
+      update_velocity(index);
     }
   } else if (delta < 0) {
-    for (int i=0; i>delta; --i) {
-      particles.pop_back();
+    // Drop the most recently added slots first
+    size_t index = particles.get_slot_count();
+    for (int i=0; i>delta && index > 0; ) {
+      --index;
+      if (particles.is_alive(index)) {
+        particles.release(index);
+        --i;
+      }
     }
   }
 
@@ -139,8 +150,17 @@ void RainParticleSystem::set_amount(float amount)
 
 void RainParticleSystem::set_angle(float angle)
 {
-  for (auto& particle : particles)
-    particle->angle = angle;
+  for (size_t i = 0; i < particles.get_slot_count(); ++i) {
+    particles.angle[i] = angle;
+    update_velocity(i);
+  }
+}
+
+void RainParticleSystem::update_velocity(size_t index)
+{
+  const float angle = (particles.angle[index] + 45.f) * 3.14159265f / 180.f;
+  particles.vel_x[index] = -speed[index] * sinf(angle);
+  particles.vel_y[index] = speed[index] * cosf(angle);
 }
 
 void RainParticleSystem::update(float dt_sec)
@@ -197,42 +217,43 @@ void RainParticleSystem::update(float dt_sec)
   }
 
   const auto& cam_translation = Sector::get().get_camera().get_translation();
-  float movement_multiplier = dt_sec * Sector::get().get_gravity() * m_current_speed * 1.41421353f;
+  float velocity_scale = Sector::get().get_gravity() * m_current_speed * 1.41421353f;
+  float movement_multiplier = dt_sec * velocity_scale;
   float abs_x = cam_translation.x;
   float abs_y = cam_translation.y;
 
-  for (auto& it : particles) {
-    auto particle = dynamic_cast<RainParticle*>(it.get());
-    assert(particle);
+  particles.integrate(dt_sec, velocity_scale);
+
+  for (size_t i = 0; i < particles.get_slot_count(); ++i) {
+    if (!particles.is_alive(i))
+      continue;
 
-    float movement = particle->speed * movement_multiplier;
-    particle->pos.y += movement * cosf((particle->angle + 45.f) * 3.14159265f / 180.f);
-    particle->pos.x -= movement * sinf((particle->angle + 45.f) * 3.14159265f / 180.f);
-    int col = collision(particle, Vector(-movement, movement));
-    if ((particle->pos.y > static_cast<float>(SCREEN_HEIGHT) + abs_y) || (col >= 0)) {
+    float movement = speed[i] * movement_multiplier;
+    int col = collision(i, Vector(-movement, movement));
+    if ((particles.pos_y[i] > static_cast<float>(SCREEN_HEIGHT) + abs_y) || (col >= 0)) {
       //Create rainsplash
-      if ((particle->pos.y <= static_cast<float>(SCREEN_HEIGHT) + abs_y) && (col >= 1)){
+      if ((particles.pos_y[i] <= static_cast<float>(SCREEN_HEIGHT) + abs_y) && (col >= 1)){
         bool vertical = (col == 2);
         if (!vertical) { //check if collision happened from above
           int splash_x, splash_y; // move outside if statement when
                                   // uncommenting the else statement below.
-          splash_x = int(particle->pos.x);
-          splash_y = int(particle->pos.y) - (int(particle->pos.y) % 32) + 32;
+          splash_x = int(particles.pos_x[i]);
+          splash_y = int(particles.pos_y[i]) - (int(particles.pos_y[i]) % 32) + 32;
           Sector::get().add<RainSplash>(Vector(static_cast<float>(splash_x), static_cast<float>(splash_y)),
                                              vertical);
         }
         // Uncomment the following to display vertical splashes, too
         /* else {
-           splash_x = int(particle->pos.x) - (int(particle->pos.x) % 32) + 32;
-           splash_y = int(particle->pos.y);
+           splash_x = int(particles.pos_x[i]) - (int(particles.pos_x[i]) % 32) + 32;
+           splash_y = int(particles.pos_y[i]);
            Sector::get().add<RainSplash>(Vector(splash_x, splash_y),vertical);
            } */
       }
       int new_x = graphicsRandom.rand(int(virtual_width)) + int(abs_x);
       int new_y = 0;
       //FIXME: Don't move particles over solid tiles
-      particle->pos.x = static_cast<float>(new_x);
-      particle->pos.y = static_cast<float>(new_y);
+      particles.pos_x[i] = static_cast<float>(new_x);
+      particles.pos_y[i] = static_cast<float>(new_y);
     }
   }
 }
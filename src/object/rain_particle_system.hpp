@@ -70,17 +70,10 @@ private:
   void set_amount(float amount);
   void set_angle(float angle);
 
-private:
-  class RainParticle : public Particle
-  {
-  public:
-    float speed;
-
-    RainParticle() :
-      speed()
-    {}
-  };
+  /** Points the velocity of the drop in the given slot along its angle */
+  void update_velocity(size_t index);
 
+private:
   SurfacePtr rainimages[2];
 
   float m_current_speed;
@@ -100,6 +93,9 @@ private:
   
   float m_current_real_amount;
 
+  // Falling speed of each drop, indexed like the slots of the particle pool
+  std::vector<float> speed;
+
 private:
   RainParticleSystem(const RainParticleSystem&) = delete;
   RainParticleSystem& operator=(const RainParticleSystem&) = delete;
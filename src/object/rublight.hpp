@@ -29,6 +29,7 @@ public:
   virtual HitResponse collision(GameObject& other, const CollisionHit& hit) override;
   virtual void update(float dt_sec) override;
   virtual void draw(DrawingContext& context) override;
+  virtual bool draws_outside_bbox() const override { return true; }
   virtual std::string get_class() const override { return "rublight"; }
   virtual std::string get_display_name() const override { return _("Rublight"); }
   virtual ObjectSettings get_settings() override;
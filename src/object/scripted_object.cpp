@@ -80,7 +80,7 @@ ScriptedObject::get_settings()
 void
 ScriptedObject::move(float x, float y)
 {
-  m_col.m_bbox.move(Vector(x, y));
+  m_col.set_pos(m_col.get_pos() + Vector(x, y));
 }
 
 float
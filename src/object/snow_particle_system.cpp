@@ -40,7 +40,12 @@ SnowParticleSystem::SnowParticleSystem() :
   state(RELEASING),
   timer(),
   gust_onset(0),
-  gust_current_velocity(0)
+  gust_current_velocity(0),
+  snowimages(),
+  anchorx(),
+  drift_speed(),
+  spin_speed(),
+  flake_size()
 {
   init();
 }
@@ -50,7 +55,12 @@ SnowParticleSystem::SnowParticleSystem(const ReaderMapping& reader) :
   state(RELEASING),
   timer(),
   gust_onset(0),
-  gust_current_velocity(0)
+  gust_current_velocity(0),
+  snowimages(),
+  anchorx(),
+  drift_speed(),
+  spin_speed(),
+  flake_size()
 {
   init();
 }
@@ -71,27 +81,27 @@ void SnowParticleSystem::init()
 
   // create some random snowflakes
   int snowflakecount = static_cast<int>(virtual_width / 10.0f);
+  particles.reserve(snowflakecount);
   for (int i = 0; i < snowflakecount; ++i) {
-    auto particle = std::make_unique<SnowParticle>();
+    const size_t index = particles.allocate();
+    assert(index == anchorx.size());
     int snowsize = graphicsRandom.rand(3);
 
-    particle->pos.x = graphicsRandom.randf(virtual_width);
-    particle->pos.y = graphicsRandom.randf(static_cast<float>(SCREEN_HEIGHT));
-    particle->anchorx = particle->pos.x + (graphicsRandom.randf(-0.5, 0.5) * 16);
+    particles.pos_x[index] = graphicsRandom.randf(virtual_width);
+    particles.pos_y[index] = graphicsRandom.randf(static_cast<float>(SCREEN_HEIGHT));
+    anchorx.push_back(particles.pos_x[index] + (graphicsRandom.randf(-0.5, 0.5) * 16));
     // drift will change with wind gusts
-    particle->drift_speed = graphicsRandom.randf(-0.5f, 0.5f) * 0.3f;
-    particle->wobble = 0.0;
+    drift_speed.push_back(graphicsRandom.randf(-0.5f, 0.5f) * 0.3f);
+    particles.vel_x[index] = 0.0; // wobble
 
-    particle->texture = snowimages[snowsize];
-    particle->flake_size = static_cast<int>(powf(static_cast<float>(snowsize) + 3.0f, 4.0f)); // since it ranges from 0 to 2
+    particles.texture[index] = snowimages[snowsize];
+    flake_size.push_back(powf(static_cast<float>(snowsize) + 3.0f, 4.0f)); // since it ranges from 0 to 2
 
-    particle->speed = 6.32f * (1.0f + (2.0f - static_cast<float>(snowsize)) / 2.0f + graphicsRandom.randf(1.8f));
+    particles.vel_y[index] = 6.32f * (1.0f + (2.0f - static_cast<float>(snowsize)) / 2.0f + graphicsRandom.randf(1.8f));
 
     // Spinning
-    particle->angle = graphicsRandom.randf(360.0);
-    particle->spin_speed = graphicsRandom.randf(-SNOW::SPIN_SPEED,SNOW::SPIN_SPEED);
-
-    particles.push_back(std::move(particle));
+    particles.angle[index] = graphicsRandom.randf(360.0);
+    spin_speed.push_back(graphicsRandom.randf(-SNOW::SPIN_SPEED,SNOW::SPIN_SPEED));
   }
 }
 
@@ -137,26 +147,22 @@ void SnowParticleSystem::update(float dt_sec)
 
   float sq_g = sqrtf(Sector::get().get_gravity());
 
-  for (auto& part : particles) {
-    auto particle = dynamic_cast<SnowParticle*>(part.get());
-    if (!particle)
-      continue;
+  // Falling and wobbling
+  particles.integrate(dt_sec, sq_g);
 
+  for (size_t i = 0; i < particles.get_slot_count(); ++i) {
     float anchor_delta;
 
-    // Falling
-    particle->pos.y += particle->speed * dt_sec * sq_g;
     // Drifting (speed approaches wind at a rate dependent on flake size)
-    particle->drift_speed += (gust_current_velocity - particle->drift_speed) / static_cast<float>(particle->flake_size) + graphicsRandom.randf(-SNOW::EPSILON, SNOW::EPSILON);
-    particle->anchorx += particle->drift_speed * dt_sec;
+    drift_speed[i] += (gust_current_velocity - drift_speed[i]) / flake_size[i] + graphicsRandom.randf(-SNOW::EPSILON, SNOW::EPSILON);
+    anchorx[i] += drift_speed[i] * dt_sec;
     // Wobbling (particle approaches anchorx)
-    particle->pos.x += particle->wobble * dt_sec * sq_g;
-    anchor_delta = (particle->anchorx - particle->pos.x);
-    particle->wobble += (SNOW::WOBBLE_FACTOR * anchor_delta) + graphicsRandom.randf(-SNOW::EPSILON, SNOW::EPSILON);
-    particle->wobble *= SNOW::WOBBLE_DECAY;
+    anchor_delta = (anchorx[i] - particles.pos_x[i]);
+    particles.vel_x[i] += (SNOW::WOBBLE_FACTOR * anchor_delta) + graphicsRandom.randf(-SNOW::EPSILON, SNOW::EPSILON);
+    particles.vel_x[i] *= SNOW::WOBBLE_DECAY;
     // Spinning
-    particle->angle += particle->spin_speed * dt_sec;
-    particle->angle = fmodf(particle->angle, 360.0);
+    particles.angle[i] += spin_speed[i] * dt_sec;
+    particles.angle[i] = fmodf(particles.angle[i], 360.0);
   }
 }
 
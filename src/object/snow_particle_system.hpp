@@ -41,30 +41,6 @@ public:
   void init();
 
 private:
-  class SnowParticle : public Particle
-  {
-  public:
-    float speed;
-    float wobble;
-    float anchorx;
-    float drift_speed;
-
-    // Turning speed
-    float spin_speed;
-
-    // for inertia
-    unsigned int flake_size;
-
-    SnowParticle() :
-      speed(),
-      wobble(),
-      anchorx(),
-      drift_speed(),
-      spin_speed(),
-      flake_size()
-    {}
-  };
-
   // Wind is simulated in discrete "gusts"
 
   // Gust state
@@ -91,6 +67,17 @@ private:
 
   SurfacePtr snowimages[3];
 
+  // Per-flake data, indexed like the slots of the particle pool. The pool
+  // holds the falling speed in vel_y and the wobble in vel_x.
+  std::vector<float> anchorx;
+  std::vector<float> drift_speed;
+
+  // Turning speed
+  std::vector<float> spin_speed;
+
+  // for inertia
+  std::vector<float> flake_size;
+
 private:
   SnowParticleSystem(const SnowParticleSystem&) = delete;
   SnowParticleSystem& operator=(const SnowParticleSystem&) = delete;
@@ -44,6 +44,7 @@ public:
 
   virtual void update(float dt_sec) override;
   virtual void draw(DrawingContext& context) override;
+  virtual bool draws_outside_bbox() const override { return true; }
 
   virtual HitResponse collision(GameObject& other, const CollisionHit& hit_) override;
 
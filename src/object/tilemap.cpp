@@ -16,7 +16,7 @@
 
 #include "object/tilemap.hpp"
 
-#include <tuple>
+#include <unordered_map>
 
 #include "editor/editor.hpp"
 #include "supertux/autotile.hpp"
@@ -35,6 +35,13 @@
 #include "video/surface.hpp"
 #include "worldmap/worldmap.hpp"
 
+namespace {
+
+/** Width and height of a draw chunk in tiles */
+const int CHUNK_SIZE = 16;
+
+} // namespace
+
 TileMap::TileMap(const TileSet *new_tileset) :
   ExposedObject<TileMap, scripting::TileMap>(this),
   PathObject(),
@@ -64,7 +71,10 @@ TileMap::TileMap(const TileSet *new_tileset) :
   m_new_size_y(0),
   m_new_offset_x(0),
   m_new_offset_y(0),
-  m_add_path(false)
+  m_add_path(false),
+  m_draw_chunks(),
+  m_draw_chunks_editor(false),
+  m_changes()
 {
 }
 
@@ -98,7 +108,10 @@ TileMap::TileMap(const TileSet *tileset_, const ReaderMapping& reader) :
   m_new_size_y(0),
   m_new_offset_x(0),
   m_new_offset_y(0),
-  m_add_path(false)
+  m_add_path(false),
+  m_draw_chunks(),
+  m_draw_chunks_editor(false),
+  m_changes()
 {
   assert(m_tileset);
 
@@ -370,48 +383,50 @@ TileMap::draw(DrawingContext& context)
 
   Rectf draw_rect = context.get_cliprect();
   Rect t_draw_rect = get_tiles_overlapping(draw_rect);
-  Vector start = get_tile_position(t_draw_rect.left, t_draw_rect.top);
 
-  Vector pos(0.0f, 0.0f);
-  int tx, ty;
+  if (g_debug.show_collision_rects) {
+    for (int tx = t_draw_rect.left; tx < t_draw_rect.right; ++tx) {
+      for (int ty = t_draw_rect.top; ty < t_draw_rect.bottom; ++ty) {
+        const uint32_t id = m_tiles[ty * m_width + tx];
+        if (id != 0) {
+          m_tileset->get(id).draw_debug(context.color(), get_tile_position(tx, ty), LAYER_FOREGROUND1);
+        }
+      }
+    }
+  }
 
-  std::unordered_map<SurfacePtr,
-                     std::tuple<std::vector<Rectf>,
-                                std::vector<Rectf>>> batches;
+  if (t_draw_rect.empty()) {
+    context.pop_transform();
+    return;
+  }
 
-  for (pos.x = start.x, tx = t_draw_rect.left; tx < t_draw_rect.right; pos.x += 32, ++tx) {
-    for (pos.y = start.y, ty = t_draw_rect.top; ty < t_draw_rect.bottom; pos.y += 32, ++ty) {
-      int index = ty*m_width + tx;
-      assert (index >= 0);
-      assert (index < (m_width * m_height));
+  const bool editor_surfaces = Editor::is_active();
+  const int chunks_x = (m_width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+  if (m_draw_chunks.empty() || m_draw_chunks_editor != editor_surfaces)
+  {
+    const int chunks_y = (m_height + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    m_draw_chunks.clear();
+    m_draw_chunks.resize(chunks_x * chunks_y);
+    m_draw_chunks_editor = editor_surfaces;
+  }
 
-      if (m_tiles[index] == 0) continue;
-      const Tile& tile = m_tileset->get(m_tiles[index]);
+  // the batches are stored relative to the tilemap, so the offset
+  // goes into the translation instead
+  context.set_translation(context.get_translation() - m_offset);
 
-      if (g_debug.show_collision_rects) {
-        tile.draw_debug(context.color(), pos, LAYER_FOREGROUND1);
-      }
+  Canvas& canvas = context.get_canvas(m_draw_target);
 
-      const SurfacePtr& surface = Editor::is_active() ? tile.get_current_editor_surface() : tile.get_current_surface();
-      if (surface) {
-        std::get<0>(batches[surface]).emplace_back(surface->get_region());
-        std::get<1>(batches[surface]).emplace_back(pos,
-                                                   Sizef(static_cast<float>(surface->get_width()),
-                                                         static_cast<float>(surface->get_height())));
+  for (int cy = t_draw_rect.top / CHUNK_SIZE; cy <= (t_draw_rect.bottom - 1) / CHUNK_SIZE; ++cy) {
+    for (int cx = t_draw_rect.left / CHUNK_SIZE; cx <= (t_draw_rect.right - 1) / CHUNK_SIZE; ++cx) {
+      DrawChunk& chunk = m_draw_chunks[cy * chunks_x + cx];
+      if (chunk.dirty || is_draw_chunk_animated(chunk, editor_surfaces)) {
+        rebuild_draw_chunk(chunk, cx, cy, editor_surfaces);
       }
-    }
-  }
-
-  Canvas& canvas = context.get_canvas(m_draw_target);
 
-  for (auto& it : batches)
-  {
-    const SurfacePtr& surface = it.first;
-    if (surface) {
-      canvas.draw_surface_batch(surface,
-                                std::move(std::get<0>(it.second)),
-                                std::move(std::get<1>(it.second)),
-                                m_current_tint, m_z_pos);
+      for (const auto& batch : chunk.batches) {
+        canvas.draw_surface_batch(batch.surface, batch.srcrects, batch.dstrects,
+                                  m_current_tint, m_z_pos);
+      }
     }
   }
 
@@ -459,6 +474,9 @@ TileMap::set(int newwidth, int newheight, const std::vector<unsigned int>&newt,
   m_real_solid  = newsolid;
   update_effective_solid ();
 
+  invalidate_draw_chunks();
+  m_changes.clear();
+
   // make sure all tiles are loaded
   for (const auto& tile : m_tiles)
     m_tileset->get(tile);
@@ -496,6 +514,10 @@ TileMap::resize(int new_width, int new_height, int fill_id,
   m_height = new_height;
   m_width = new_width;
 
+  invalidate_draw_chunks();
+  // indices of pending changes refer to the old size
+  m_changes.clear();
+
   //Apply offset
   if (xoffset || yoffset) {
     for (int y = 0; y < m_height; y++) {
@@ -599,7 +621,43 @@ void
 TileMap::change(int x, int y, uint32_t newtile)
 {
   assert(x >= 0 && x < m_width && y >= 0 && y < m_height);
-  m_tiles[y*m_width + x] = newtile;
+  set_tile(x, y, newtile);
+}
+
+void
+TileMap::set_tile(int x, int y, uint32_t newtile)
+{
+  const int index = y * m_width + x;
+  if (Editor::is_active() && m_tiles[index] != newtile) {
+    m_changes.push_back({ index, m_tiles[index], newtile });
+  }
+  m_tiles[index] = newtile;
+  invalidate_draw_chunk(x, y);
+}
+
+std::vector<TileMap::TileChange>
+TileMap::take_changes()
+{
+  std::vector<TileChange> changes;
+  std::unordered_map<int, size_t> positions;
+  for (const auto& change : m_changes)
+  {
+    auto it = positions.find(change.index);
+    if (it == positions.end()) {
+      positions[change.index] = changes.size();
+      changes.push_back(change);
+    } else {
+      changes[it->second].new_tile = change.new_tile;
+    }
+  }
+  m_changes.clear();
+
+  changes.erase(std::remove_if(changes.begin(), changes.end(),
+                               [](const TileChange& change) {
+                                 return change.old_tile == change.new_tile;
+                               }),
+                changes.end());
+  return changes;
 }
 
 void
@@ -666,7 +724,22 @@ TileMap::autotile(int x, int y, uint32_t tile)
     curr_set->is_solid(get_tile_id(x+1, y+1)),
     x, y);
 
-  m_tiles[y*m_width + x] = realtile;
+  set_tile(x, y, realtile);
+}
+
+void
+TileMap::autotile_region(const Rect& region, uint32_t tile)
+{
+  const int left = std::max(region.left, 0);
+  const int top = std::max(region.top, 0);
+  const int right = std::min(region.right, m_width);
+  const int bottom = std::min(region.bottom, m_height);
+
+  for (int y = top; y < bottom; ++y) {
+    for (int x = left; x < right; ++x) {
+      autotile(x, y, tile);
+    }
+  }
 }
 
 void
@@ -714,7 +787,7 @@ TileMap::autotile_corner(int x, int y, uint32_t tile, AutotileCornerOperation op
     (mask & 0x01) != 0,
     x, y);
 
-  m_tiles[y*m_width + x] = realtile;
+  set_tile(x, y, realtile);
 }
 
 bool
@@ -748,7 +821,7 @@ TileMap::autotile_erase(const Vector& pos, const Vector& corner_pos)
   else
   {
     int x = static_cast<int>(pos.x), y = static_cast<int>(pos.y);
-    m_tiles[y*m_width + x] = 0;
+    set_tile(x, y, 0);
 
     if (x - 1 >= 0 && y - 1 >= 0 && !is_corner(m_tiles[(y-1)*m_width + x-1])) {
       if (m_tiles[y*m_width + x] == 0)
@@ -869,6 +942,99 @@ void
 TileMap::set_tileset(const TileSet* new_tileset)
 {
   m_tileset = new_tileset;
+  invalidate_draw_chunks();
+}
+
+void
+TileMap::invalidate_draw_chunks()
+{
+  m_draw_chunks.clear();
+}
+
+void
+TileMap::invalidate_draw_chunk(int x, int y)
+{
+  if (m_draw_chunks.empty())
+    return;
+
+  const int chunks_x = (m_width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+  m_draw_chunks[(y / CHUNK_SIZE) * chunks_x + (x / CHUNK_SIZE)].dirty = true;
+}
+
+void
+TileMap::rebuild_draw_chunk(DrawChunk& chunk, int chunk_x, int chunk_y, bool editor_surfaces) const
+{
+  chunk.batches.clear();
+  chunk.animated_tiles.clear();
+
+  const int x_end = std::min(m_width, (chunk_x + 1) * CHUNK_SIZE);
+  const int y_end = std::min(m_height, (chunk_y + 1) * CHUNK_SIZE);
+
+  DrawChunk::Batch* batch = nullptr;
+  for (int ty = chunk_y * CHUNK_SIZE; ty < y_end; ++ty) {
+    for (int tx = chunk_x * CHUNK_SIZE; tx < x_end; ++tx) {
+      const uint32_t id = m_tiles[ty * m_width + tx];
+      if (id == 0) continue;
+
+      const Tile& tile = m_tileset->get(id);
+      SurfacePtr surface = editor_surfaces ? tile.get_current_editor_surface() : tile.get_current_surface();
+
+      if (tile.is_animated() &&
+          std::none_of(chunk.animated_tiles.begin(), chunk.animated_tiles.end(),
+                       [id](const std::pair<uint32_t, SurfacePtr>& animated) { return animated.first == id; }))
+      {
+        chunk.animated_tiles.emplace_back(id, surface);
+      }
+
+      if (!surface) continue;
+
+      // Tiles packed into the same atlas texture can go into one batch,
+      // unless flipping or displacement sets them apart
+      const bool shared = surface->get_flip() == NO_FLIP && !surface->get_displacement_texture();
+      const Texture* texture = shared ? surface->get_texture().get() : nullptr;
+      auto matches = [&surface, texture](const DrawChunk::Batch& b) {
+        return texture ? b.texture == texture : b.surface == surface;
+      };
+
+      // neighbouring tiles often share a surface, so check the last batch first
+      if (!batch || !matches(*batch))
+      {
+        auto it = std::find_if(chunk.batches.begin(), chunk.batches.end(), matches);
+        if (it == chunk.batches.end()) {
+          chunk.batches.push_back({texture ? Surface::from_texture(surface->get_texture()) : surface, texture, {}, {}});
+          batch = &chunk.batches.back();
+        } else {
+          batch = &*it;
+        }
+      }
+
+      // srcrects are relative to the batch surface
+      if (texture) {
+        batch->srcrects.emplace_back(surface->get_region());
+      } else {
+        batch->srcrects.emplace_back(0.0f, 0.0f,
+                                     static_cast<float>(surface->get_width()),
+                                     static_cast<float>(surface->get_height()));
+      }
+      batch->dstrects.emplace_back(Vector(static_cast<float>(tx * 32), static_cast<float>(ty * 32)),
+                                   Sizef(static_cast<float>(surface->get_width()),
+                                         static_cast<float>(surface->get_height())));
+    }
+  }
+
+  chunk.dirty = false;
+}
+
+bool
+TileMap::is_draw_chunk_animated(const DrawChunk& chunk, bool editor_surfaces) const
+{
+  for (const auto& animated : chunk.animated_tiles) {
+    const Tile& tile = m_tileset->get(animated.first);
+    if ((editor_surfaces ? tile.get_current_editor_surface() : tile.get_current_surface()) != animated.second) {
+      return true;
+    }
+  }
+  return false;
 }
 
 /* EOF */
@@ -32,12 +32,14 @@
 #include "video/color.hpp"
 #include "video/flip.hpp"
 #include "video/drawing_target.hpp"
+#include "video/surface_ptr.hpp"
 
 class DrawingContext;
 class CollisionObject;
 class CollisionGroundMovementManager;
 class Tile;
 class TileSet;
+class Texture;
 
 /** This class is responsible for drawing the level tiles */
 class TileMap final :
@@ -45,6 +47,35 @@ class TileMap final :
   public ExposedObject<TileMap, scripting::TileMap>,
   public PathObject
 {
+private:
+  /** Prebuilt draw batches for a square of CHUNK_SIZE x CHUNK_SIZE
+      tiles, so that static tiles don't need to be looked up and
+      sorted by surface every frame */
+  struct DrawChunk
+  {
+    struct Batch
+    {
+      SurfacePtr surface;
+
+      /** Set when the batch is shared by all the tiles on an atlas
+          texture, surface then covers the whole texture */
+      const Texture* texture;
+
+      std::vector<Rectf> srcrects;
+      std::vector<Rectf> dstrects;
+    };
+
+    DrawChunk() : batches(), animated_tiles(), dirty(true) {}
+
+    std::vector<Batch> batches;
+
+    /** Animated tiles of this chunk along with the surface they were
+        batched with, the chunk is rebuilt once one of them changes */
+    std::vector<std::pair<uint32_t, SurfacePtr> > animated_tiles;
+
+    bool dirty;
+  };
+
 public:
   TileMap(const TileSet *tileset);
   TileMap(const TileSet *tileset, const ReaderMapping& reader);
@@ -157,6 +188,10 @@ public:
 
   /** Puts the correct autotile block at the given position */
   void autotile(int x, int y, uint32_t tile);
+
+  /** Autotiles every tile of the region (clipped to the tilemap) once, as
+      autotile() would; empty tiles use the autotileset of the given tile */
+  void autotile_region(const Rect& region, uint32_t tile);
   
   enum class AutotileCornerOperation {
     ADD_TOP_LEFT,
@@ -201,13 +236,35 @@ public:
   void set_tileset(const TileSet* new_tileset);
 
   const std::vector<uint32_t>& get_tiles() const { return m_tiles; }
+
+  /** A tile that was changed in the editor, @c index is y * width + x */
+  struct TileChange
+  {
+    int index;
+    uint32_t old_tile;
+    uint32_t new_tile;
+  };
+
+  /** Returns the tiles changed in the editor since the last call and
+      forgets them, repeated changes of the same tile are merged */
+  std::vector<TileChange> take_changes();
   
 private:
+  /** Sets a tile and remembers the change for take_changes() */
+  void set_tile(int x, int y, uint32_t newtile);
+
   void update_effective_solid();
   void float_channel(float target, float &current, float remaining_time, float dt_sec);
 
   bool is_corner(uint32_t tile);
 
+  /** Drops all draw batches, needed whenever the size or the tileset
+      of the tilemap changes */
+  void invalidate_draw_chunks();
+  void invalidate_draw_chunk(int x, int y);
+  void rebuild_draw_chunk(DrawChunk& chunk, int chunk_x, int chunk_y, bool editor_surfaces) const;
+  bool is_draw_chunk_animated(const DrawChunk& chunk, bool editor_surfaces) const;
+
 public:
   bool m_editor_active;
 
@@ -257,6 +314,11 @@ private:
   int m_new_offset_y;
   bool m_add_path;
 
+  std::vector<DrawChunk> m_draw_chunks;
+  bool m_draw_chunks_editor;
+
+  std::vector<TileChange> m_changes;
+
 private:
   TileMap(const TileMap&) = delete;
   TileMap& operator=(const TileMap&) = delete;
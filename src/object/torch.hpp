@@ -33,6 +33,7 @@ public:
   Torch(const ReaderMapping& reader);
 
   virtual void draw(DrawingContext& context) override;
+  virtual bool draws_outside_bbox() const override { return true; }
   virtual void update(float) override;
 
   virtual HitResponse collision(GameObject& other, const CollisionHit& ) override;
@@ -31,6 +31,7 @@ public:
   virtual HitResponse collision(GameObject& other, const CollisionHit& hit) override;
   virtual void update(float dt_sec) override;
   virtual void draw(DrawingContext& context) override;
+  virtual bool draws_outside_bbox() const override { return linked && state != STATE_NORMAL; }
   virtual std::string get_class() const override { return "weak_block"; }
   virtual std::string get_display_name() const override { return _("Weak Tile"); }
 
@@ -0,0 +1,101 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "physfs/file_stamp.hpp"
+
+#include <physfs.h>
+#include <stdexcept>
+
+#include "util/log.hpp"
+#include "util/reader_collection.hpp"
+#include "util/reader_document.hpp"
+#include "util/reader_mapping.hpp"
+#include "util/writer.hpp"
+
+FileStamp::FileStamp() :
+  size(0),
+  mtime(0)
+{
+}
+
+FileStamp::FileStamp(int64_t size_, int64_t mtime_) :
+  size(size_),
+  mtime(mtime_)
+{
+}
+
+bool
+FileStamp::stat(const std::string& filename, FileStamp& stamp)
+{
+  PHYSFS_Stat statbuf;
+  if (!PHYSFS_stat(filename.c_str(), &statbuf))
+    return false;
+
+  stamp.size = statbuf.filesize;
+  stamp.mtime = statbuf.modtime;
+  return true;
+}
+
+bool
+FileStamp::read_cache(const std::string& filename, const std::string& root_name,
+                      const ReadEntryFunc& read_entry)
+{
+  if (!PHYSFS_exists(filename.c_str()))
+    return true;
+
+  try
+  {
+    auto doc = ReaderDocument::from_file(filename);
+    auto root = doc.get_root();
+    if (root.get_name() != root_name)
+      throw std::runtime_error("file is not a " + root_name + " file");
+
+    for (const auto& entry_node : root.get_collection().get_objects())
+    {
+      auto entry = entry_node.get_mapping();
+
+      std::string file;
+      std::string size;
+      std::string mtime;
+      if (!entry.get("file", file) ||
+          !entry.get("size", size) ||
+          !entry.get("mtime", mtime))
+        continue;
+
+      read_entry(file, FileStamp(std::stoll(size), std::stoll(mtime)), entry);
+    }
+  }
+  catch(const std::exception& err)
+  {
+    log_warning << "Couldn't read '" << filename << "', rebuilding it: " << err.what() << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+void
+FileStamp::start_cache_entry(Writer& writer, const std::string& entry_name,
+                             const std::string& file, const FileStamp& stamp)
+{
+  writer.start_list(entry_name);
+  writer.write("file", file);
+  // stored as strings as the reader has no 64 bit integers
+  writer.write("size", std::to_string(stamp.size));
+  writer.write("mtime", std::to_string(stamp.mtime));
+}
+
+/* EOF */
@@ -0,0 +1,71 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_PHYSFS_FILE_STAMP_HPP
+#define HEADER_SUPERTUX_PHYSFS_FILE_STAMP_HPP
+
+#include <functional>
+#include <stdint.h>
+#include <string>
+
+class ReaderMapping;
+class Writer;
+
+/** Size and modification time of a file of the PhysFS search path.
+    Caches that are kept across runs of the game store it with each
+    entry, an entry is used as long as the stamp of its file stays the
+    same. */
+struct FileStamp
+{
+  typedef std::function<void (const std::string& file, const FileStamp& stamp,
+                              const ReaderMapping& entry)> ReadEntryFunc;
+
+  FileStamp();
+  FileStamp(int64_t size_, int64_t mtime_);
+
+  /** Fills in the stamp of a file, returns false if it doesn't exist */
+  static bool stat(const std::string& filename, FileStamp& stamp);
+
+  /** Reads a cache file of the form
+      (root_name (entry (file "...") (size "...") (mtime "...") ...) ...)
+      and passes every entry with a file name and stamp to read_entry.
+      If the file is broken, a warning is logged and false is returned,
+      the entries read so far should then be dropped. */
+  static bool read_cache(const std::string& filename, const std::string& root_name,
+                         const ReadEntryFunc& read_entry);
+
+  /** Starts an entry of a cache file with the file name and stamp, the
+      caller writes the remaining fields and ends the list */
+  static void start_cache_entry(Writer& writer, const std::string& entry_name,
+                                const std::string& file, const FileStamp& stamp);
+
+  bool operator==(const FileStamp& other) const
+  {
+    return size == other.size && mtime == other.mtime;
+  }
+
+  bool operator!=(const FileStamp& other) const
+  {
+    return !(*this == other);
+  }
+
+  int64_t size;
+  int64_t mtime;
+};
+
+#endif
+
+/* EOF */
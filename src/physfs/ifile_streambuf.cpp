@@ -17,58 +17,36 @@
 #include "physfs/ifile_streambuf.hpp"
 
 #include <assert.h>
-#include <physfs.h>
-#include <sstream>
-#include <stdexcept>
 
 IFileStreambuf::IFileStreambuf(const std::string& filename) :
-  file(),
-  buf()
+  m_file(filename)
 {
-  // check this as PHYSFS seems to be buggy and still returns a
-  // valid pointer in this case
-  if (filename.empty()) {
-    throw std::runtime_error("Couldn't open file: empty filename");
-  }
-  file = PHYSFS_openRead(filename.c_str());
-  if (file == nullptr) {
-    std::stringstream msg;
-    msg << "Couldn't open file '" << filename << "': "
-        << PHYSFS_getErrorByCode(PHYSFS_getLastErrorCode());
-    throw std::runtime_error(msg.str());
-  }
+  // the get area is never written to, streambuf only wants non-const
+  // pointers
+  char* data = const_cast<char*>(m_file.get_data());
+  setg(data, data, data + m_file.get_size());
 }
 
 IFileStreambuf::~IFileStreambuf()
 {
-  PHYSFS_close(file);
 }
 
 int
 IFileStreambuf::underflow()
 {
-  if (PHYSFS_eof(file)) {
-    return traits_type::eof();
-  }
-
-  PHYSFS_sint64 bytesread = PHYSFS_readBytes(file, buf, sizeof(buf));
-  if (bytesread <= 0) {
-    return traits_type::eof();
-  }
-  setg(buf, buf, buf + bytesread);
-
-  return static_cast<unsigned char>(buf[0]);
+  // the get area always holds the whole file
+  return traits_type::eof();
 }
 
 IFileStreambuf::pos_type
 IFileStreambuf::seekpos(pos_type pos, std::ios_base::openmode)
 {
-  if (PHYSFS_seek(file, static_cast<PHYSFS_uint64> (pos)) == 0) {
+  const off_type offset = static_cast<off_type>(pos);
+  if (offset < 0 || offset > static_cast<off_type>(m_file.get_size())) {
     return pos_type(off_type(-1));
   }
 
-  // the seek invalidated the buffer
-  setg(buf, buf, buf);
+  setg(eback(), eback() + offset, egptr());
   return pos;
 }
 
@@ -77,18 +55,15 @@ IFileStreambuf::seekoff(off_type off, std::ios_base::seekdir dir,
                         std::ios_base::openmode mode)
 {
   off_type pos = off;
-  PHYSFS_sint64 ptell = PHYSFS_tell(file);
 
   switch (dir) {
     case std::ios_base::beg:
       break;
     case std::ios_base::cur:
-      if (off == 0)
-        return static_cast<pos_type> (ptell) - static_cast<pos_type> (egptr() - gptr());
-      pos += static_cast<off_type> (ptell) - static_cast<off_type> (egptr() - gptr());
+      pos += static_cast<off_type>(gptr() - eback());
       break;
     case std::ios_base::end:
-      pos += static_cast<off_type> (PHYSFS_fileLength(file));
+      pos += static_cast<off_type>(m_file.get_size());
       break;
     default:
       assert(false);
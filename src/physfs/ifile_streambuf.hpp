@@ -19,10 +19,13 @@
 
 #include <streambuf>
 
-struct PHYSFS_File;
+#include "physfs/mapped_file.hpp"
 
 /** This class implements a C++ streambuf object for physfs files.
  * So that you can use normal istream operations on them
+ *
+ * The whole file is made available at once through a MappedFile, so
+ * reads are served from memory and never call underflow().
  */
 class IFileStreambuf final : public std::streambuf
 {
@@ -30,6 +33,9 @@ public:
   IFileStreambuf(const std::string& filename);
   ~IFileStreambuf() override;
 
+  const char* get_data() const { return m_file.get_data(); }
+  size_t get_size() const { return m_file.get_size(); }
+
 protected:
   virtual int underflow() override;
   virtual pos_type seekoff(off_type pos, std::ios_base::seekdir,
@@ -37,8 +43,7 @@ protected:
   virtual pos_type seekpos(pos_type pos, std::ios_base::openmode) override;
 
 private:
-  PHYSFS_File* file;
-  char buf[1024];
+  MappedFile m_file;
 
 private:
   IFileStreambuf(const IFileStreambuf&) = delete;
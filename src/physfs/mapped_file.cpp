@@ -0,0 +1,133 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "physfs/mapped_file.hpp"
+
+#include <physfs.h>
+#include <sstream>
+#include <stdexcept>
+#include <string.h>
+
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+#  define SUPERTUX_USE_MMAP
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+#include "util/file_system.hpp"
+
+MappedFile::MappedFile(const std::string& filename) :
+  m_data(),
+  m_size(),
+  m_mapping(),
+  m_buffer()
+{
+  // check this as PHYSFS seems to be buggy and still returns a
+  // valid pointer in this case
+  if (filename.empty()) {
+    throw std::runtime_error("Couldn't open file: empty filename");
+  }
+
+  if (!map(filename)) {
+    read(filename);
+  }
+}
+
+MappedFile::~MappedFile()
+{
+#ifdef SUPERTUX_USE_MMAP
+  if (m_mapping) {
+    munmap(m_mapping, m_size);
+  }
+#endif
+}
+
+bool
+MappedFile::map(const std::string& filename)
+{
+#ifdef SUPERTUX_USE_MMAP
+  const char* realdir = PHYSFS_getRealDir(filename.c_str());
+  if (realdir == nullptr || !FileSystem::is_directory(realdir))
+    return false;
+
+  // Only directories mounted at the root map 1:1 to the real filesystem
+  const char* mount_point = PHYSFS_getMountPoint(realdir);
+  if (mount_point != nullptr && strcmp(mount_point, "/") != 0)
+    return false;
+
+  const std::string realname = FileSystem::join(realdir, filename);
+  const int fd = open(realname.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat statbuf;
+  if (fstat(fd, &statbuf) != 0 || !S_ISREG(statbuf.st_mode) || statbuf.st_size == 0) {
+    close(fd);
+    return false;
+  }
+
+  void* mapping = mmap(nullptr, static_cast<size_t>(statbuf.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED)
+    return false;
+
+  m_mapping = mapping;
+  m_data = static_cast<const char*>(mapping);
+  m_size = static_cast<size_t>(statbuf.st_size);
+  return true;
+#else
+  return false;
+#endif
+}
+
+void
+MappedFile::read(const std::string& filename)
+{
+  PHYSFS_File* file = PHYSFS_openRead(filename.c_str());
+  if (file == nullptr) {
+    std::stringstream msg;
+    msg << "Couldn't open file '" << filename << "': "
+        << PHYSFS_getErrorByCode(PHYSFS_getLastErrorCode());
+    throw std::runtime_error(msg.str());
+  }
+
+  const PHYSFS_sint64 length = PHYSFS_fileLength(file);
+  if (length < 0) {
+    PHYSFS_close(file);
+    std::stringstream msg;
+    msg << "Couldn't determine the size of '" << filename << "': "
+        << PHYSFS_getErrorByCode(PHYSFS_getLastErrorCode());
+    throw std::runtime_error(msg.str());
+  }
+
+  m_size = static_cast<size_t>(length);
+  m_buffer.reset(new char[m_size > 0 ? m_size : 1]);
+  const PHYSFS_sint64 bytesread = PHYSFS_readBytes(file, m_buffer.get(), m_size);
+  PHYSFS_close(file);
+
+  if (bytesread != length) {
+    std::stringstream msg;
+    msg << "Couldn't read '" << filename << "': "
+        << PHYSFS_getErrorByCode(PHYSFS_getLastErrorCode());
+    throw std::runtime_error(msg.str());
+  }
+
+  m_data = m_buffer.get();
+}
+
+/* EOF */
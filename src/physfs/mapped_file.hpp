@@ -0,0 +1,56 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_PHYSFS_MAPPED_FILE_HPP
+#define HEADER_SUPERTUX_PHYSFS_MAPPED_FILE_HPP
+
+#include <memory>
+#include <string>
+
+/** The whole content of a file of the PhysFS search path as one
+    contiguous, read-only block of memory. Files that come from a mounted
+    directory are memory-mapped, files in archives are read with a
+    single call. */
+class MappedFile final
+{
+public:
+  /** Throws std::runtime_error if the file can't be opened */
+  MappedFile(const std::string& filename);
+  ~MappedFile();
+
+  const char* get_data() const { return m_data; }
+  size_t get_size() const { return m_size; }
+
+private:
+  bool map(const std::string& filename);
+  void read(const std::string& filename);
+
+private:
+  const char* m_data;
+  size_t m_size;
+
+  /** Set when the file is mapped, else the file is in m_buffer */
+  void* m_mapping;
+  std::unique_ptr<char[]> m_buffer;
+
+private:
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+};
+
+#endif
+
+/* EOF */
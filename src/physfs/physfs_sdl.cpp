@@ -16,12 +16,16 @@
 
 #include "physfs/physfs_sdl.hpp"
 
+#include <algorithm>
+#include <memory>
 #include <physfs.h>
 #include <sstream>
 #include <stdexcept>
 #include <assert.h>
 #include <stdio.h>
+#include <string.h>
 
+#include "physfs/mapped_file.hpp"
 #include "util/log.hpp"
 
 #include <iostream>
@@ -103,32 +107,95 @@ int funcClose(struct SDL_RWops* context)
   return 0;
 }
 
-} // namespace
+/** Read-only files are served from memory, so that image and font
+    loaders, which do many small reads, don't go through PhysFS for each */
+struct MappedRWops
+{
+  MappedRWops(const std::string& filename) :
+    file(filename),
+    pos(0)
+  {
+  }
 
-SDL_RWops* get_physfs_SDLRWops(const std::string& filename)
+  MappedFile file;
+  size_t pos;
+};
+
+Sint64 funcMappedSize(struct SDL_RWops* context)
 {
-  // check this as PHYSFS seems to be buggy and still returns a
-  // valid pointer in this case
-  if (filename.empty()) {
-    throw std::runtime_error("Couldn't open file: empty filename");
+  auto mapped = static_cast<MappedRWops*>(context->hidden.unknown.data1);
+  return static_cast<Sint64>(mapped->file.get_size());
+}
+
+Sint64 funcMappedSeek(struct SDL_RWops* context, Sint64 offset, int whence)
+{
+  auto mapped = static_cast<MappedRWops*>(context->hidden.unknown.data1);
+  Sint64 pos;
+  switch (whence) {
+    case SEEK_SET:
+      pos = offset;
+      break;
+    case SEEK_CUR:
+      pos = static_cast<Sint64>(mapped->pos) + offset;
+      break;
+    case SEEK_END:
+      pos = static_cast<Sint64>(mapped->file.get_size()) + offset;
+      break;
+    default:
+      assert(false);
+      return -1;
   }
 
-  PHYSFS_file* file = static_cast<PHYSFS_file*>(PHYSFS_openRead(filename.c_str()));
-  if (!file) {
-    std::stringstream msg;
-    msg << "Couldn't open '" << filename << "': "
-        << PHYSFS_getLastErrorCode();
-    throw std::runtime_error(msg.str());
+  if (pos < 0 || pos > static_cast<Sint64>(mapped->file.get_size())) {
+    log_warning << "Error seeking in file: offset " << pos << " out of range" << std::endl;
+    return -1;
   }
 
+  mapped->pos = static_cast<size_t>(pos);
+  return pos;
+}
+
+size_t funcMappedRead(struct SDL_RWops* context, void* ptr, size_t size, size_t maxnum)
+{
+  auto mapped = static_cast<MappedRWops*>(context->hidden.unknown.data1);
+  if (size == 0)
+    return 0;
+
+  const size_t available = mapped->file.get_size() - mapped->pos;
+  const size_t num = std::min(maxnum, available / size);
+  memcpy(ptr, mapped->file.get_data() + mapped->pos, num * size);
+  mapped->pos += num * size;
+  return num;
+}
+
+size_t funcMappedWrite(struct SDL_RWops* context, const void* ptr, size_t size, size_t num)
+{
+  return 0;
+}
+
+int funcMappedClose(struct SDL_RWops* context)
+{
+  delete static_cast<MappedRWops*>(context->hidden.unknown.data1);
+  delete context;
+
+  return 0;
+}
+
+} // namespace
+
+SDL_RWops* get_physfs_SDLRWops(const std::string& filename)
+{
+  // throws if the file can't be opened
+  auto mapped = std::make_unique<MappedRWops>(filename);
+
   SDL_RWops* ops = new SDL_RWops;
-  ops->size = funcSize;
-  ops->seek = funcSeek;
-  ops->read = funcRead;
-  ops->write = funcWrite;
-  ops->close = funcClose;
+  ops->size = funcMappedSize;
+  ops->seek = funcMappedSeek;
+  ops->read = funcMappedRead;
+  ops->write = funcMappedWrite;
+  ops->close = funcMappedClose;
   ops->type = SDL_RWOPS_UNKNOWN;
-  ops->hidden.unknown.data1 = file;
+  ops->hidden.unknown.data1 = mapped.release();
 
   return ops;
 }
@@ -34,6 +34,10 @@ public:
   void draw(Canvas& canvas, const Vector& pos, int layer,
             Flip flip = NO_FLIP);
 
+  /** Advance the animation to the current game time, draw() does this
+      automatically */
+  void update();
+
   /** Set action (or state) */
   void set_action(const std::string& name, int loops = -1);
 
@@ -100,8 +104,6 @@ public:
   bool has_action (const std::string& name) const { return (m_data.get_action(name) != nullptr); }
 
 private:
-  void update();
-
   SpriteData& m_data;
 
   // between 0 and 1
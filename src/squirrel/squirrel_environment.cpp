@@ -27,11 +27,20 @@
 #include "supertux/globals.hpp"
 #include "util/log.hpp"
 
+namespace {
+
+/** Scripts can be generated at runtime, so the cache is dropped once
+    it gets this large */
+const size_t MAX_COMPILED_SCRIPTS = 256;
+
+} // namespace
+
 SquirrelEnvironment::SquirrelEnvironment(SquirrelVM& vm, const std::string& name) :
   m_vm(vm),
   m_table(),
   m_name(name),
   m_scripts(),
+  m_compiled_scripts(),
   m_scheduler(std::make_unique<SquirrelScheduler>(m_vm))
 {
   // garbage collector has to be invoked manually
@@ -58,6 +67,7 @@ SquirrelEnvironment::~SquirrelEnvironment()
     sq_release(m_vm.get_vm(), &script);
   }
   m_scripts.clear();
+  clear_compiled_scripts();
   sq_release(m_vm.get_vm(), &m_table);
 
   sq_collectgarbage(m_vm.get_vm());
@@ -124,8 +134,18 @@ SquirrelEnvironment::run_script(const std::string& script, const std::string& so
 {
   if (script.empty()) return;
 
-  std::istringstream stream(script);
-  run_script(stream, sourcename);
+  garbage_collect();
+
+  try
+  {
+    HSQUIRRELVM vm = create_script_thread();
+    push_compiled_script(vm, script, sourcename);
+    run_closure(vm);
+  }
+  catch(const std::exception& e)
+  {
+    log_warning << "Error running script: " << e.what() << std::endl;
+  }
 }
 
 void
@@ -153,23 +173,71 @@ SquirrelEnvironment::run_script(std::istream& in, const std::string& sourcename)
 
   try
   {
-    HSQOBJECT object = m_vm.create_thread();
-    m_scripts.push_back(object);
+    HSQUIRRELVM vm = create_script_thread();
+    compile_and_run(vm, in, sourcename);
+  }
+  catch(const std::exception& e)
+  {
+    log_warning << "Error running script: " << e.what() << std::endl;
+  }
+}
 
-    HSQUIRRELVM vm = object_to_vm(object);
+HSQUIRRELVM
+SquirrelEnvironment::create_script_thread()
+{
+  HSQOBJECT object = m_vm.create_thread();
+  m_scripts.push_back(object);
 
-    sq_setforeignptr(vm, this);
+  HSQUIRRELVM vm = object_to_vm(object);
 
-    // set root table
-    sq_pushobject(vm, m_table);
-    sq_setroottable(vm);
+  sq_setforeignptr(vm, this);
 
-    compile_and_run(vm, in, sourcename);
+  // set root table
+  sq_pushobject(vm, m_table);
+  sq_setroottable(vm);
+
+  return vm;
+}
+
+void
+SquirrelEnvironment::push_compiled_script(HSQUIRRELVM vm, const std::string& script, const std::string& sourcename)
+{
+  std::string key = sourcename;
+  key += '\0';
+  key += script;
+
+  auto it = m_compiled_scripts.find(key);
+  if (it != m_compiled_scripts.end())
+  {
+    sq_pushobject(vm, it->second);
+    return;
   }
-  catch(const std::exception& e)
+
+  // The closure is compiled with m_table as root table, which is
+  // the same for every script of this environment
+  compile_script(vm, script, sourcename);
+
+  HSQOBJECT closure;
+  sq_resetobject(&closure);
+  if (SQ_FAILED(sq_getstackobj(vm, -1, &closure)))
+    throw SquirrelError(vm, "Couldn't get compiled script");
+
+  if (m_compiled_scripts.size() >= MAX_COMPILED_SCRIPTS) {
+    clear_compiled_scripts();
+  }
+
+  sq_addref(m_vm.get_vm(), &closure);
+  m_compiled_scripts[key] = closure;
+}
+
+void
+SquirrelEnvironment::clear_compiled_scripts()
+{
+  for (auto& script : m_compiled_scripts)
   {
-    log_warning << "Error running script: " << e.what() << std::endl;
+    sq_release(m_vm.get_vm(), &script.second);
   }
+  m_compiled_scripts.clear();
 }
 
 void
@@ -19,6 +19,7 @@
 #define HEADER_SUPERTUX_SQUIRREL_SQUIRREL_ENVIRONMENT_HPP
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <squirrel.h>
@@ -62,7 +63,8 @@ public:
   void unexpose(const std::string& name);
 
   /** Convenience function that takes an std::string instead of an
-      std::istream& */
+      std::istream&. The compiled script is cached, so running the
+      same script again (e.g. from a trigger) doesn't recompile it. */
   void run_script(const std::string& script, const std::string& sourcename);
 
   /** Runs a script in the context of the SquirrelEnvironment (m_table will
@@ -78,11 +80,24 @@ public:
 private:
   void garbage_collect();
 
+  /** Creates a thread with m_table as root table to run a script in */
+  HSQUIRRELVM create_script_thread();
+
+  /** Pushes the compiled script onto the stack of vm, compiling it
+      if it isn't cached yet */
+  void push_compiled_script(HSQUIRRELVM vm, const std::string& script, const std::string& sourcename);
+  void clear_compiled_scripts();
+
 private:
   SquirrelVM& m_vm;
   HSQOBJECT m_table;
   std::string m_name;
   std::vector<HSQOBJECT> m_scripts;
+
+  /** Closures of scripts run by run_script(), keyed by the sourcename
+      and the script text */
+  std::unordered_map<std::string, HSQOBJECT> m_compiled_scripts;
+
   std::unique_ptr<SquirrelScheduler> m_scheduler;
 
 private:
@@ -22,6 +22,7 @@
 #include "squirrel/squirrel_util.hpp"
 #include "supertux/level.hpp"
 #include "util/log.hpp"
+#include "util/profiler.hpp"
 
 SquirrelScheduler::SquirrelScheduler(SquirrelVM& vm) :
   m_vm(vm),
@@ -32,6 +33,8 @@ SquirrelScheduler::SquirrelScheduler(SquirrelVM& vm) :
 void
 SquirrelScheduler::update(float time)
 {
+  ProfileZone profile_zone("SquirrelScheduler::update");
+
   while (!schedule.empty() && (schedule.front().wakeup_time < time ||
         (schedule.front().skippable &&
         Level::current() != nullptr &&
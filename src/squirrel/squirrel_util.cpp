@@ -18,6 +18,7 @@
 
 #include <config.h>
 
+#include <iterator>
 #include <stdio.h>
 #include <sqstdaux.h>
 #include <sqstdblob.h>
@@ -223,15 +224,20 @@ SQInteger squirrel_read_char(SQUserPointer file)
 
 void compile_script(HSQUIRRELVM vm, std::istream& in, const std::string& sourcename)
 {
-  if (SQ_FAILED(sq_compile(vm, squirrel_read_char, &in, sourcename.c_str(), true)))
-    throw SquirrelError(vm, "Couldn't parse script");
+  // Compiling from a buffer avoids a virtual call per character
+  std::string script{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+  compile_script(vm, script, sourcename);
 }
 
-void compile_and_run(HSQUIRRELVM vm, std::istream& in,
-                     const std::string& sourcename)
+void compile_script(HSQUIRRELVM vm, const std::string& script, const std::string& sourcename)
 {
-  compile_script(vm, in, sourcename);
+  if (SQ_FAILED(sq_compilebuffer(vm, script.c_str(), static_cast<SQInteger>(script.size()),
+                                 sourcename.c_str(), true)))
+    throw SquirrelError(vm, "Couldn't parse script");
+}
 
+void run_closure(HSQUIRRELVM vm)
+{
   SQInteger oldtop = sq_gettop(vm);
 
   try {
@@ -249,6 +255,13 @@ void compile_and_run(HSQUIRRELVM vm, std::istream& in,
   }
 }
 
+void compile_and_run(HSQUIRRELVM vm, std::istream& in,
+                     const std::string& sourcename)
+{
+  compile_script(vm, in, sourcename);
+  run_closure(vm);
+}
+
 HSQUIRRELVM object_to_vm(HSQOBJECT object)
 {
   if (object._type != OT_THREAD)
@@ -36,8 +36,16 @@ SQInteger squirrel_read_char(SQUserPointer file);
 
 HSQUIRRELVM object_to_vm(HSQOBJECT object);
 
+/** Compile a script and push the resulting closure onto the stack */
 void compile_script(HSQUIRRELVM vm, std::istream& in,
                     const std::string& sourcename);
+void compile_script(HSQUIRRELVM vm, const std::string& script,
+                    const std::string& sourcename);
+
+/** Call the closure on top of the stack with the root table as 'this',
+    the closure is popped unless the script got suspended */
+void run_closure(HSQUIRRELVM vm);
+
 void compile_and_run(HSQUIRRELVM vm, std::istream& in,
                      const std::string& sourcename);
 
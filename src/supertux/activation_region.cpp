@@ -0,0 +1,163 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "supertux/activation_region.hpp"
+
+#include <algorithm>
+#include <math.h>
+
+#include "badguy/badguy.hpp"
+#include "object/camera.hpp"
+#include "object/player.hpp"
+#include "supertux/sector.hpp"
+
+const float ActivationRegion::X_OFFSCREEN_DISTANCE = 1280;
+const float ActivationRegion::Y_OFFSCREEN_DISTANCE = 800;
+const float ActivationRegion::CELL_SIZE = 512;
+
+ActivationRegion::ActivationRegion() :
+  m_rects(),
+  m_has_player(false),
+  m_cells(),
+  m_sleeper_cells()
+{
+}
+
+void
+ActivationRegion::update(const Sector& sector)
+{
+  const Vector distance(X_OFFSCREEN_DISTANCE, Y_OFFSCREEN_DISTANCE);
+
+  m_rects.clear();
+  m_has_player = false;
+  for (auto player_ptr : sector.get_objects_by_type_index(typeid(Player)))
+  {
+    const Player& player = *static_cast<Player*>(player_ptr);
+    if (player.is_dying() || player.is_dead())
+      continue;
+
+    const Vector middle = player.get_bbox().get_middle();
+    m_rects.push_back(Rectf(middle - distance, middle + distance));
+    m_has_player = true;
+  }
+
+  const Vector center = sector.get_camera().get_center();
+  m_rects.push_back(Rectf(center - distance, center + distance));
+
+  // Badguys don't activate without a player, let them sleep
+  if (!m_has_player || m_sleeper_cells.empty())
+    return;
+
+  for (const auto& rect : m_rects)
+  {
+    const int x1 = static_cast<int>(floorf(rect.get_left() / CELL_SIZE));
+    const int y1 = static_cast<int>(floorf(rect.get_top() / CELL_SIZE));
+    const int x2 = static_cast<int>(floorf(rect.get_right() / CELL_SIZE));
+    const int y2 = static_cast<int>(floorf(rect.get_bottom() / CELL_SIZE));
+
+    for (int y = y1; y <= y2; ++y)
+    {
+      for (int x = x1; x <= x2; ++x)
+      {
+        auto it = m_cells.find(get_cell(x, y));
+        if (it == m_cells.end())
+          continue;
+
+        auto& sleepers = it->second;
+        for (size_t i = 0; i < sleepers.size(); )
+        {
+          BadGuy* badguy = sleepers[i];
+          if (contains(badguy->get_bbox().get_middle()))
+          {
+            badguy->m_sleeping = false;
+            m_sleeper_cells.erase(badguy);
+            sleepers[i] = sleepers.back();
+            sleepers.pop_back();
+          }
+          else
+          {
+            ++i;
+          }
+        }
+
+        if (sleepers.empty())
+          m_cells.erase(it);
+      }
+    }
+  }
+}
+
+bool
+ActivationRegion::contains(const Vector& pos) const
+{
+  if (!m_has_player)
+    return true;
+
+  return std::any_of(m_rects.begin(), m_rects.end(),
+                     [&pos](const Rectf& rect) {
+                       return pos.x >= rect.get_left() && pos.x <= rect.get_right() &&
+                              pos.y >= rect.get_top() && pos.y <= rect.get_bottom();
+                     });
+}
+
+void
+ActivationRegion::put_to_sleep(BadGuy& badguy)
+{
+  if (badguy.m_sleeping)
+    return;
+
+  const uint64_t cell = get_cell(badguy.get_bbox().get_middle());
+  m_cells[cell].push_back(&badguy);
+  m_sleeper_cells[&badguy] = cell;
+  badguy.m_sleeping = true;
+}
+
+void
+ActivationRegion::remove(BadGuy& badguy)
+{
+  if (!badguy.m_sleeping)
+    return;
+
+  auto it = m_sleeper_cells.find(&badguy);
+  if (it != m_sleeper_cells.end())
+  {
+    auto cell = m_cells.find(it->second);
+    if (cell != m_cells.end())
+    {
+      auto& sleepers = cell->second;
+      sleepers.erase(std::remove(sleepers.begin(), sleepers.end(), &badguy), sleepers.end());
+      if (sleepers.empty())
+        m_cells.erase(cell);
+    }
+    m_sleeper_cells.erase(it);
+  }
+  badguy.m_sleeping = false;
+}
+
+uint64_t
+ActivationRegion::get_cell(int x, int y) const
+{
+  return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+uint64_t
+ActivationRegion::get_cell(const Vector& pos) const
+{
+  return get_cell(static_cast<int>(floorf(pos.x / CELL_SIZE)),
+                  static_cast<int>(floorf(pos.y / CELL_SIZE)));
+}
+
+/* EOF */
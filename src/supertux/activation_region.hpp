@@ -0,0 +1,86 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_SUPERTUX_ACTIVATION_REGION_HPP
+#define HEADER_SUPERTUX_SUPERTUX_ACTIVATION_REGION_HPP
+
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+#include "math/rectf.hpp"
+
+class BadGuy;
+class Sector;
+
+/** The part of a sector in which badguys are active, i.e. the area around
+    the living players and the camera. It is computed once per frame by the
+    sector. Inactive badguys are put to sleep in a coarse grid and are not
+    updated at all until the region reaches them. */
+class ActivationRegion final
+{
+public:
+  /** In SuperTux 0.1.x, Badguys were activated when Tux<->Badguy center
+      distance was approx. <= ~668px. This doesn't work for wide-screen
+      monitors which give us a virt. res. of approx. 1066px x 600px */
+  static const float X_OFFSCREEN_DISTANCE;
+  static const float Y_OFFSCREEN_DISTANCE;
+
+private:
+  static const float CELL_SIZE;
+
+public:
+  ActivationRegion();
+
+  /** Recomputes the region around the players and the camera of the sector,
+      then wakes up the sleeping badguys that are inside of it */
+  void update(const Sector& sector);
+
+  /** True if a badguy centered at pos should be active. When no player is
+      alive, every position counts as inside. */
+  bool contains(const Vector& pos) const;
+
+  /** Whether a living player exists that can activate badguys */
+  bool has_player() const { return m_has_player; }
+
+  /** Stops updating the badguy until the region reaches its position */
+  void put_to_sleep(BadGuy& badguy);
+
+  /** Forgets a sleeping badguy, e.g. because it gets removed */
+  void remove(BadGuy& badguy);
+
+  size_t get_sleeper_count() const { return m_sleeper_cells.size(); }
+
+private:
+  uint64_t get_cell(int x, int y) const;
+  uint64_t get_cell(const Vector& pos) const;
+
+private:
+  std::vector<Rectf> m_rects;
+  bool m_has_player;
+
+  /** Sleeping badguys, by cell */
+  std::unordered_map<uint64_t, std::vector<BadGuy*> > m_cells;
+  std::unordered_map<const BadGuy*, uint64_t> m_sleeper_cells;
+
+private:
+  ActivationRegion(const ActivationRegion&) = delete;
+  ActivationRegion& operator=(const ActivationRegion&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -141,8 +141,40 @@ AutotileSet::AutotileSet(std::vector<Autotile*> tiles, uint32_t default_tile, st
   m_autotiles(std::move(tiles)),
   m_default(default_tile),
   m_name(std::move(name)),
-  m_corner(corner)
+  m_corner(corner),
+  m_solid_lookup(),
+  m_empty_lookup(),
+  m_tile_lookup()
 {
+  build_lookup_tables();
+}
+
+void
+AutotileSet::build_lookup_tables()
+{
+  const int mask_count = m_corner ? 16 : 256;
+  m_solid_lookup.assign(mask_count, nullptr);
+  m_empty_lookup.assign(mask_count, nullptr);
+
+  for (int mask = 0; mask < mask_count; mask++)
+  {
+    const uint8_t num_mask = static_cast<uint8_t>(mask);
+    for (const auto& autotile : m_autotiles)
+    {
+      if (!m_solid_lookup[mask] && autotile->matches(num_mask, true))
+        m_solid_lookup[mask] = autotile;
+      if (!m_empty_lookup[mask] && autotile->matches(num_mask, false))
+        m_empty_lookup[mask] = autotile;
+    }
+  }
+
+  // emplace() keeps the first autotile for tiles used more than once
+  for (const auto& autotile : m_autotiles)
+  {
+    m_tile_lookup.emplace(autotile->get_tile_id(), autotile);
+    for (const auto& pair : autotile->get_all_tile_ids())
+      m_tile_lookup.emplace(pair.first, autotile);
+  }
 }
 
 /*
@@ -210,12 +242,10 @@ AutotileSet::get_autotile(uint32_t tile_id,
     if (top_left)     num_mask = static_cast<uint8_t>(num_mask + 0x80);
   }
 
-  for (auto& autotile : m_autotiles)
+  const Autotile* autotile = (center ? m_solid_lookup : m_empty_lookup)[num_mask];
+  if (autotile)
   {
-    if (autotile->matches(num_mask, center))
-    {
-      return autotile->pick_tile(x, y);
-    }
+    return autotile->pick_tile(x, y);
   }
 
   return center ? get_default_tile() : 0;
@@ -232,22 +262,9 @@ AutotileSet::get_default_tile() const
 bool
 AutotileSet::is_member(uint32_t tile_id) const
 {
-  for (auto& tile : m_autotiles)
+  if (m_tile_lookup.find(tile_id) != m_tile_lookup.end())
   {
-    if (tile->get_tile_id() == tile_id)
-    {
-      return true;
-    }
-    else
-    {
-      for (auto& pair : tile->get_all_tile_ids())
-      {
-        if (pair.first == tile_id)
-        {
-          return true;
-        }
-      }
-    }
+    return true;
   }
   // m_default should *never* be 0 (always a valid solid tile,
   //   even if said tile isn't part of the tileset)
@@ -257,29 +274,12 @@ AutotileSet::is_member(uint32_t tile_id) const
 bool
 AutotileSet::is_solid(uint32_t tile_id) const
 {
-  if (!is_member(tile_id))
-    return false;
-
-  for (auto& tile : m_autotiles)
+  auto it = m_tile_lookup.find(tile_id);
+  if (it != m_tile_lookup.end())
   {
-    if (tile->get_tile_id() == tile_id)
-    {
-      return tile->is_solid();
-    }
-    else
-    {
-      for (auto& pair : tile->get_all_tile_ids())
-      {
-        if (pair.first == tile_id)
-        {
-          return tile->is_solid();
-        }
-      }
-    }
+    return it->second->is_solid();
   }
 
-  //log_warning << "Called AutotileSet::is_solid() with a tile_id that isn't in the Autotileset, yet that returns is_member() = true." << std::endl;
-
   // m_default should *never* be 0 (always a valid solid tile,
   //   even if said tile isn't part of the tileset)
   return tile_id == m_default && m_default != 0;
@@ -288,15 +288,30 @@ AutotileSet::is_solid(uint32_t tile_id) const
 uint8_t
 AutotileSet::get_mask_from_tile(uint32_t tile) const
 {
-  for (auto& autotile : m_autotiles)
+  auto it = m_tile_lookup.find(tile);
+  if (it != m_tile_lookup.end())
   {
-    if (autotile->is_amongst(tile)) {
-      return autotile->get_first_mask();
-    }
+    return it->second->get_first_mask();
   }
   return static_cast<uint8_t>(0);
 }
 
+std::vector<uint32_t>
+AutotileSet::get_member_tiles() const
+{
+  std::vector<uint32_t> tiles;
+  tiles.reserve(m_tile_lookup.size() + 1);
+  for (const auto& pair : m_tile_lookup)
+  {
+    tiles.push_back(pair.first);
+  }
+  if (m_default != 0)
+  {
+    tiles.push_back(m_default);
+  }
+  return tiles;
+}
+
 void
 AutotileSet::validate() const
 {
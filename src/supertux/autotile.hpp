@@ -21,6 +21,8 @@
 #include <stdint.h>
 #include <string>
 #include <algorithm>
+#include <unordered_map>
+#include <vector>
 
 #include "math/rect.hpp"
 #include "math/rectf.hpp"
@@ -128,10 +130,18 @@ public:
    */
   uint8_t get_mask_from_tile(uint32_t tile) const;
 
+  /** Returns the ids of all the tiles for which is_member() is true */
+  std::vector<uint32_t> get_member_tiles() const;
+
   // TODO : Validate autotile config files by checking if each mask has
   //        one and only one corresponding tile.
   void validate() const;
 
+private:
+  /** Fills the lookup tables, so that get_autotile() and the membership
+      tests don't have to go through every autotile and every mask */
+  void build_lookup_tables();
+
 public:
   static std::vector<AutotileSet*>* m_autotilesets;
 
@@ -141,6 +151,14 @@ private:
   std::string m_name;
   bool m_corner;
 
+  /** First autotile matching each mask (256 entries, or 16 for corner-based
+      sets), for a solid and a non-solid center */
+  std::vector<const Autotile*> m_solid_lookup;
+  std::vector<const Autotile*> m_empty_lookup;
+
+  /** First autotile having each tile id as its base or alternative tile */
+  std::unordered_map<uint32_t, const Autotile*> m_tile_lookup;
+
 private:
   AutotileSet(const AutotileSet&) = delete;
   AutotileSet& operator=(const AutotileSet&) = delete;
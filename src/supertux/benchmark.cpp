@@ -0,0 +1,165 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "supertux/benchmark.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <math.h>
+#include <sstream>
+
+#include "collision/collision_system.hpp"
+#include "supertux/game_session.hpp"
+#include "supertux/sector.hpp"
+
+namespace {
+
+std::string
+json_escape(const std::string& text)
+{
+  std::ostringstream out;
+  for (const char c : text)
+  {
+    switch (c)
+    {
+      case '"': out << "\\\""; break;
+      case '\\': out << "\\\\"; break;
+      case '\n': out << "\\n"; break;
+      case '\t': out << "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+          out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+        else
+          out << c;
+        break;
+    }
+  }
+  return out.str();
+}
+
+/** Nearest-rank percentile of an already sorted list */
+double
+percentile(const std::vector<double>& sorted, double p)
+{
+  if (sorted.empty())
+    return 0.0;
+
+  size_t rank = static_cast<size_t>(ceil(p / 100.0 * static_cast<double>(sorted.size())));
+  if (rank > 0)
+    rank -= 1;
+  return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+void
+write_stats(std::ostream& out, std::vector<double> values)
+{
+  std::sort(values.begin(), values.end());
+
+  double sum = 0.0;
+  for (const double value : values)
+    sum += value;
+
+  out << "{ \"mean\": " << (values.empty() ? 0.0 : sum / static_cast<double>(values.size()))
+      << ", \"min\": " << (values.empty() ? 0.0 : values.front())
+      << ", \"p50\": " << percentile(values, 50.0)
+      << ", \"p90\": " << percentile(values, 90.0)
+      << ", \"p99\": " << percentile(values, 99.0)
+      << ", \"max\": " << (values.empty() ? 0.0 : values.back())
+      << " }";
+}
+
+} // namespace
+
+Benchmark::Benchmark(const std::string& level_filename, const std::string& demo_filename) :
+  m_level_filename(level_filename),
+  m_demo_filename(demo_filename),
+  m_frames(),
+  m_start_time(std::chrono::steady_clock::now())
+{
+}
+
+void
+Benchmark::add_frame(double update_ms, double draw_ms)
+{
+  Frame frame;
+  frame.update_ms = update_ms;
+  frame.draw_ms = draw_ms;
+  frame.objects = 0;
+  frame.collision_pairs = 0;
+
+  if (Sector::current())
+  {
+    frame.objects = Sector::get().get_objects().size();
+    frame.collision_pairs = Sector::get().get_collision_system().get_pair_check_count();
+  }
+
+  m_frames.push_back(frame);
+}
+
+bool
+Benchmark::is_finished() const
+{
+  const GameSession* session = GameSession::current();
+  return !session || session->is_demo_finished();
+}
+
+void
+Benchmark::write_report(std::ostream& out) const
+{
+  const double total_seconds = std::chrono::duration<double>(
+    std::chrono::steady_clock::now() - m_start_time).count();
+
+  std::vector<double> update_ms;
+  std::vector<double> draw_ms;
+  std::vector<double> objects;
+  std::vector<double> collision_pairs;
+  for (const auto& frame : m_frames)
+  {
+    update_ms.push_back(frame.update_ms);
+    draw_ms.push_back(frame.draw_ms);
+    objects.push_back(static_cast<double>(frame.objects));
+    collision_pairs.push_back(static_cast<double>(frame.collision_pairs));
+  }
+
+  out << std::fixed << std::setprecision(4);
+  out << "{\n"
+      << "  \"level\": \"" << json_escape(m_level_filename) << "\",\n"
+      << "  \"demo\": \"" << json_escape(m_demo_filename) << "\",\n"
+      << "  \"frames\": " << m_frames.size() << ",\n"
+      << "  \"total_seconds\": " << total_seconds << ",\n";
+  out << "  \"update_ms\": ";
+  write_stats(out, update_ms);
+  out << ",\n  \"draw_ms\": ";
+  write_stats(out, draw_ms);
+  out << ",\n  \"objects\": ";
+  write_stats(out, objects);
+  out << ",\n  \"collision_pairs\": ";
+  write_stats(out, collision_pairs);
+  out << ",\n  \"per_frame\": [";
+  for (size_t i = 0; i < m_frames.size(); ++i)
+  {
+    const auto& frame = m_frames[i];
+    out << (i == 0 ? "\n" : ",\n")
+        << "    { \"update_ms\": " << frame.update_ms
+        << ", \"draw_ms\": " << frame.draw_ms
+        << ", \"objects\": " << frame.objects
+        << ", \"collision_pairs\": " << frame.collision_pairs << " }";
+  }
+  out << "\n  ]\n"
+      << "}\n";
+}
+
+/* EOF */
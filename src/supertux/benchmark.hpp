@@ -0,0 +1,69 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_SUPERTUX_BENCHMARK_HPP
+#define HEADER_SUPERTUX_SUPERTUX_BENCHMARK_HPP
+
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "util/currenton.hpp"
+
+/** Collects per-frame statistics while a demo gets replayed with
+    --benchmark. While a Benchmark exists, the ScreenManager runs one
+    logical step and one frame per iteration, as fast as possible,
+    instead of waiting for the clock. */
+class Benchmark final : public Currenton<Benchmark>
+{
+public:
+  struct Frame
+  {
+    double update_ms;
+    double draw_ms;
+    size_t objects;
+    size_t collision_pairs;
+  };
+
+public:
+  Benchmark(const std::string& level_filename, const std::string& demo_filename);
+
+  /** Records the timings of one step and frame, together with the state
+      of the current sector */
+  void add_frame(double update_ms, double draw_ms);
+
+  /** True once the demo has been replayed completely */
+  bool is_finished() const;
+
+  const std::vector<Frame>& get_frames() const { return m_frames; }
+
+  void write_report(std::ostream& out) const;
+
+private:
+  std::string m_level_filename;
+  std::string m_demo_filename;
+  std::vector<Frame> m_frames;
+  std::chrono::steady_clock::time_point m_start_time;
+
+private:
+  Benchmark(const Benchmark&) = delete;
+  Benchmark& operator=(const Benchmark&) = delete;
+};
+
+#endif
+
+/* EOF */
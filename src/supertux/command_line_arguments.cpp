@@ -45,6 +45,8 @@ CommandLineArguments::CommandLineArguments() :
   enable_script_debugger(),
   start_demo(),
   record_demo(),
+  benchmark_demo(),
+  benchmark_report(),
   tux_spawn_pos(),
   sector(),
   spawnpoint(),
@@ -52,7 +54,8 @@ CommandLineArguments::CommandLineArguments() :
   christmas_mode(),
   repository_url(),
   editor(),
-  resave()
+  resave(),
+  compile_level()
 {
 }
 
@@ -115,6 +118,7 @@ CommandLineArguments::print_help(const char* arg0) const
     << _("Game Options:") << "\n"
     << _("  --edit-level                 Open given level in editor") << "\n"
     << _("  --resave                     Loads given level and saves it") << "\n"
+    << _("  --compile-level              Writes the binary .stlc form of given level") << "\n"
     << _("  --show-fps                   Display framerate in levels") << "\n"
     << _("  --no-show-fps                Do not display framerate in levels") << "\n"
     << _("  --show-pos                   Display player's current position") << "\n"
@@ -128,6 +132,8 @@ CommandLineArguments::print_help(const char* arg0) const
     << _("Demo Recording Options:") << "\n"
     << _("  --record-demo FILE LEVEL     Record a demo to FILE") << "\n"
     << _("  --play-demo FILE LEVEL       Play a recorded demo") << "\n"
+    << _("  --benchmark FILE LEVEL       Replay a demo without video and audio as fast as possible and report timings") << "\n"
+    << _("  --benchmark-report FILE      Write the benchmark report to FILE instead of stdout") << "\n"
     << "\n"
     << _("Directory Options:") << "\n"
     << _("  --datadir DIR                Set the directory for the games datafiles") << "\n"
@@ -347,6 +353,28 @@ CommandLineArguments::parse_args(int argc, char** argv)
         record_demo = argv[++i];
       }
     }
+    else if (arg == "--benchmark")
+    {
+      if (i + 1 >= argc)
+      {
+        throw std::runtime_error("Need to specify a demo filename");
+      }
+      else
+      {
+        benchmark_demo = argv[++i];
+      }
+    }
+    else if (arg == "--benchmark-report")
+    {
+      if (i + 1 >= argc)
+      {
+        throw std::runtime_error("Need to specify a report filename");
+      }
+      else
+      {
+        benchmark_report = argv[++i];
+      }
+    }
     else if (arg == "--spawn-pos")
     {
       Vector spawn_pos(0.0f, 0.0f);
@@ -401,6 +429,10 @@ CommandLineArguments::parse_args(int argc, char** argv)
     {
       resave = true;
     }
+    else if (arg == "--compile-level")
+    {
+      compile_level = true;
+    }
     else if (arg[0] != '-')
     {
       filenames.push_back(arg);
@@ -412,9 +444,13 @@ CommandLineArguments::parse_args(int argc, char** argv)
   }
 
   // some final checks
-  if (filenames.size() > 1 && !(resave && *resave)) {
+  if (filenames.size() > 1 && !(resave && *resave) && !(compile_level && *compile_level)) {
     throw std::runtime_error("Only one filename allowed for the given options");
   }
+
+  if (benchmark_demo && filenames.empty()) {
+    throw std::runtime_error("--benchmark needs a level to play the demo in");
+  }
 }
 
 void
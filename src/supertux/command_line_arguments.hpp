@@ -69,6 +69,8 @@ public:
   boost::optional<bool> enable_script_debugger;
   boost::optional<std::string> start_demo;
   boost::optional<std::string> record_demo;
+  boost::optional<std::string> benchmark_demo;
+  boost::optional<std::string> benchmark_report;
   boost::optional<Vector> tux_spawn_pos;
   boost::optional<std::string> sector;
   boost::optional<std::string> spawnpoint;
@@ -81,6 +83,7 @@ public:
 
   boost::optional<bool> editor;
   boost::optional<bool> resave;
+  boost::optional<bool> compile_level;
 
   // boost::optional<std::string> locale;
 
@@ -0,0 +1,286 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "supertux/compiled_level.hpp"
+
+#include <algorithm>
+#include <stdint.h>
+#include <string.h>
+
+#include "addon/md5.hpp"
+#include "physfs/ifile_stream.hpp"
+#include "physfs/mapped_file.hpp"
+#include "supertux/level.hpp"
+#include "supertux/sector.hpp"
+#include "util/binary_sexp.hpp"
+#include "util/log.hpp"
+#include "util/reader_document.hpp"
+#include "util/reader_iterator.hpp"
+#include "util/reader_mapping.hpp"
+#include "util/string_util.hpp"
+
+namespace {
+
+const char MAGIC[4] = { 'S', 'T', 'L', 'C' };
+
+/** Bumped when the layout of the file or of binary_sexp changes, older
+    files are then ignored in favor of the text level */
+const uint32_t FORMAT_VERSION = 2;
+
+void write_u32(std::ostream& out, uint32_t value)
+{
+  const char bytes[4] = {
+    static_cast<char>(value & 0xff),
+    static_cast<char>((value >> 8) & 0xff),
+    static_cast<char>((value >> 16) & 0xff),
+    static_cast<char>((value >> 24) & 0xff)
+  };
+  out.write(bytes, 4);
+}
+
+void write_i64(std::ostream& out, int64_t value)
+{
+  write_u32(out, static_cast<uint32_t>(static_cast<uint64_t>(value) & 0xffffffff));
+  write_u32(out, static_cast<uint32_t>(static_cast<uint64_t>(value) >> 32));
+}
+
+void write_blob(std::ostream& out, const std::string& data)
+{
+  write_u32(out, static_cast<uint32_t>(data.size()));
+  out.write(data.data(), data.size());
+}
+
+uint32_t read_u32(std::istream& in)
+{
+  unsigned char bytes[4];
+  if (!in.read(reinterpret_cast<char*>(bytes), 4))
+    throw std::runtime_error("unexpected end of compiled level");
+
+  return static_cast<uint32_t>(bytes[0]) |
+    (static_cast<uint32_t>(bytes[1]) << 8) |
+    (static_cast<uint32_t>(bytes[2]) << 16) |
+    (static_cast<uint32_t>(bytes[3]) << 24);
+}
+
+int64_t read_i64(std::istream& in)
+{
+  const uint64_t low = read_u32(in);
+  const uint64_t high = read_u32(in);
+  return static_cast<int64_t>(low | (high << 32));
+}
+
+std::string read_blob(std::istream& in)
+{
+  const uint32_t size = read_u32(in);
+  std::string data;
+  // grow in steps so that a broken size can't allocate gigabytes upfront
+  const uint32_t CHUNK_SIZE = 1 << 20;
+  while (data.size() < size) {
+    const size_t offset = data.size();
+    const size_t chunk = std::min(static_cast<size_t>(CHUNK_SIZE), size - offset);
+    data.resize(offset + chunk);
+    if (!in.read(&data[offset], chunk))
+      throw std::runtime_error("unexpected end of compiled level");
+  }
+  return data;
+}
+
+} // namespace
+
+std::string
+CompiledLevel::get_filename(const std::string& filename)
+{
+  return filename + "c";
+}
+
+std::string
+CompiledLevel::find(const std::string& filename)
+{
+  if (StringUtil::has_suffix(filename, ".stlc"))
+    return filename;
+
+  if (!StringUtil::has_suffix(filename, ".stl"))
+    return {};
+
+  const std::string compiled_filename = get_filename(filename);
+  FileStamp compiled_stamp;
+  if (!FileStamp::stat(compiled_filename, compiled_stamp))
+    return {};
+
+  CompiledLevel compiled;
+  try
+  {
+    IFileStream in(compiled_filename);
+    read_header(in, compiled);
+  }
+  catch(const std::exception& err)
+  {
+    log_debug << "[" << compiled_filename << "] ignored: " << err.what() << std::endl;
+    return {};
+  }
+
+  FileStamp stamp;
+  if (!FileStamp::stat(filename, stamp))
+    return compiled_filename;
+
+  if (stamp == compiled.m_source_stamp)
+    return compiled_filename;
+
+  // a level saved in the editor after compiling takes precedence, but
+  // copying the levels only changes their modification time
+  if (stamp.size != compiled.m_source_stamp.size)
+    return {};
+
+  MappedFile file(filename);
+  if (hash_source(file.get_data(), file.get_size()) != compiled.m_source_hash)
+    return {};
+
+  return compiled_filename;
+}
+
+std::string
+CompiledLevel::hash_source(const char* data, size_t size)
+{
+  MD5 md5;
+  md5.update(data, size);
+  return md5.hex_digest();
+}
+
+void
+CompiledLevel::read_header(std::istream& in, CompiledLevel& compiled)
+{
+  char magic[sizeof(MAGIC)];
+  if (!in.read(magic, sizeof(magic)) || memcmp(magic, MAGIC, sizeof(MAGIC)) != 0)
+    throw std::runtime_error("not a compiled level");
+
+  const uint32_t version = read_u32(in);
+  if (version != FORMAT_VERSION)
+    throw std::runtime_error("compiled level format version " + std::to_string(version) + " is not supported");
+
+  compiled.m_source_stamp.size = read_i64(in);
+  compiled.m_source_stamp.mtime = read_i64(in);
+  compiled.m_source_hash = read_blob(in);
+}
+
+CompiledLevel
+CompiledLevel::from_stream(std::istream& in)
+{
+  CompiledLevel compiled;
+  read_header(in, compiled);
+  compiled.m_header = binary_sexp::read(read_blob(in));
+
+  const uint32_t sector_count = read_u32(in);
+  for (uint32_t i = 0; i < sector_count; ++i)
+  {
+    SectorData sector;
+    sector.name = read_blob(in);
+    sector.coins = static_cast<int>(read_u32(in));
+    sector.badguys = static_cast<int>(read_u32(in));
+    sector.secrets = static_cast<int>(read_u32(in));
+    sector.data = read_blob(in);
+    compiled.m_sectors.push_back(std::move(sector));
+  }
+
+  return compiled;
+}
+
+CompiledLevel
+CompiledLevel::from_document(const ReaderDocument& doc, const Level& level)
+{
+  const auto& root = doc.get_sexp();
+  if (!root.is_array() || root.as_array().empty())
+    throw std::runtime_error("file is not a supertux-level file.");
+
+  int version = 1;
+  doc.get_root().get_mapping().get("version", version);
+  if (version < 2)
+    throw std::runtime_error("levels in the old format can't be compiled, resave them first");
+
+  std::vector<sexp::Value> header;
+  header.push_back(root.as_array()[0]);
+
+  CompiledLevel compiled;
+
+  auto iter = doc.get_root().get_mapping().get_iter();
+  while (iter.next())
+  {
+    if (iter.get_key() != "sector") {
+      header.push_back(iter.get_sexp());
+      continue;
+    }
+
+    SectorData data;
+    iter.as_mapping().get("name", data.name);
+
+    const Sector* sector = nullptr;
+    for (const auto& candidate : level.m_sectors) {
+      if (candidate->get_name() == data.name)
+        sector = candidate.get();
+    }
+    if (!sector)
+      throw std::runtime_error("sector '" + data.name + "' wasn't loaded");
+
+    data.coins = Level::get_coin_count(*sector);
+    data.badguys = Level::get_badguy_count(*sector);
+    data.secrets = Level::get_secret_count(*sector);
+    data.data = binary_sexp::write(iter.get_sexp());
+    compiled.m_sectors.push_back(std::move(data));
+  }
+
+  compiled.m_header = sexp::Value::array(std::move(header));
+  return compiled;
+}
+
+CompiledLevel::CompiledLevel() :
+  m_source_stamp(),
+  m_source_hash(),
+  m_header(),
+  m_sectors()
+{
+}
+
+void
+CompiledLevel::write(std::ostream& out) const
+{
+  out.write(MAGIC, sizeof(MAGIC));
+  write_u32(out, FORMAT_VERSION);
+  write_i64(out, m_source_stamp.size);
+  write_i64(out, m_source_stamp.mtime);
+  write_blob(out, m_source_hash);
+  write_blob(out, binary_sexp::write(m_header));
+
+  write_u32(out, static_cast<uint32_t>(m_sectors.size()));
+  for (const auto& sector : m_sectors)
+  {
+    write_blob(out, sector.name);
+    write_u32(out, static_cast<uint32_t>(sector.coins));
+    write_u32(out, static_cast<uint32_t>(sector.badguys));
+    write_u32(out, static_cast<uint32_t>(sector.secrets));
+    write_blob(out, sector.data);
+  }
+}
+
+sexp::Value
+CompiledLevel::to_sexp() const
+{
+  std::vector<sexp::Value> level = m_header.as_array();
+  for (const auto& sector : m_sectors) {
+    level.push_back(binary_sexp::read(sector.data));
+  }
+  return sexp::Value::array(std::move(level));
+}
+
+/* EOF */
@@ -0,0 +1,95 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_SUPERTUX_COMPILED_LEVEL_HPP
+#define HEADER_SUPERTUX_SUPERTUX_COMPILED_LEVEL_HPP
+
+#include <istream>
+#include <sexp/value.hpp>
+#include <string>
+#include <vector>
+
+#include "physfs/file_stamp.hpp"
+
+class Level;
+class ReaderDocument;
+
+/** Binary form of a level, written by --compile-level next to the .stl
+    it was made from. The level properties and each sector are stored as
+    separate binary_sexp blobs, so that LevelParser can skip the text
+    parser and leave the sectors unparsed until they are entered. The
+    statistics totals of each sector are precomputed so that they are
+    known before the sector is loaded. */
+class CompiledLevel final
+{
+public:
+  struct SectorData
+  {
+    std::string name;
+    int coins;
+    int badguys;
+    int secrets;
+
+    /** binary_sexp encoding of the (sector ...) entry */
+    std::string data;
+  };
+
+public:
+  /** Returns the filename of the compiled level made from filename */
+  static std::string get_filename(const std::string& filename);
+
+  /** Returns the file a non-editable load of filename should use
+      instead, or an empty string if there is no compiled level for it or
+      if it was compiled from a different version of the text file */
+  static std::string find(const std::string& filename);
+
+  static CompiledLevel from_stream(std::istream& in);
+
+  /** Returns the MD5 digest of the text of a level */
+  static std::string hash_source(const char* data, size_t size);
+
+  /** Compiles the text document of a level, level must have been loaded
+      from the same document. The source stamp and hash are left for the
+      caller to fill in. */
+  static CompiledLevel from_document(const ReaderDocument& doc, const Level& level);
+
+public:
+  CompiledLevel();
+
+  void write(std::ostream& out) const;
+
+  /** Decodes all the sectors and returns the complete level */
+  sexp::Value to_sexp() const;
+
+private:
+  /** Reads the magic, format version and source of a compiled level */
+  static void read_header(std::istream& in, CompiledLevel& compiled);
+
+public:
+  /** The text file the level was compiled from, find() only uses the
+      compiled level while the stamp of the text file is the same or,
+      if only its modification time changed, while its hash is */
+  FileStamp m_source_stamp;
+  std::string m_source_hash;
+
+  /** The (supertux-level ...) root without its sectors */
+  sexp::Value m_header;
+  std::vector<SectorData> m_sectors;
+};
+
+#endif
+
+/* EOF */
@@ -555,7 +555,7 @@ Console::draw(DrawingContext& context) const
     lineNo++;
     float py = m_height-4-1 * m_font->get_height();
     std::string line = "> " + m_inputBuffer;
-    context.color().draw_text(m_font, line, Vector(4, py), ALIGN_LEFT, layer);
+    context.color().draw_dynamic_text(m_font, line, Vector(4, py), ALIGN_LEFT, layer);
 
     if (SDL_GetTicks() % 500 < 250) {
       std::string::size_type p = 2 + m_inputBufferPosition;
@@ -581,7 +581,7 @@ Console::draw(DrawingContext& context) const
     lineNo++;
     float py = static_cast<float>(m_height - 4.0f - static_cast<float>(lineNo) * m_font->get_height());
     if (py < -m_font->get_height()) break;
-    context.color().draw_text(m_font, *i, Vector(4.0f, py), ALIGN_LEFT, layer);
+    context.color().draw_dynamic_text(m_font, *i, Vector(4.0f, py), ALIGN_LEFT, layer);
   }
   context.pop_transform();
 }
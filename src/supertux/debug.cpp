@@ -25,6 +25,7 @@ Debug::Debug() :
   show_collision_rects(false),
   show_worldmap_path(false),
   draw_redundant_frames(false),
+  use_collision_broadphase(true),
   m_use_bitmap_fonts(false),
   m_game_speed_multiplier(1.0f)
 {
@@ -39,6 +39,11 @@ public:
   // vaguely measure the impact of code changes which should increase the FPS
   bool draw_redundant_frames;
 
+  /** Use the collision grid instead of testing every object against
+      every other one, can be turned off to compare results and frame
+      times against the brute-force path */
+  bool use_collision_broadphase;
+
 private:
   /** Use old bitmap fonts instead of TTF */
   bool m_use_bitmap_fonts;
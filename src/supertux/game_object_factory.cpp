@@ -131,7 +131,6 @@
 #include "trigger/secretarea_trigger.hpp"
 #include "trigger/sequence_trigger.hpp"
 #include "trigger/switch.hpp"
-#include "util/reader_document.hpp"
 #include "util/reader_mapping.hpp"
 
 GameObjectFactory&
@@ -286,21 +285,4 @@ GameObjectFactory::init_factories()
     });
 }
 
-std::unique_ptr<GameObject>
-GameObjectFactory::create(const std::string& name, const Vector& pos, const Direction& dir, const std::string& data) const
-{
-  std::stringstream lisptext;
-  lisptext << "(" << name << "\n"
-           << " (x " << pos.x << ")"
-           << " (y " << pos.y << ")" << data;
-  if (dir != Direction::AUTO) {
-    lisptext << " (direction \"" << dir << "\"))";
-  } else {
-    lisptext << ")";
-  }
-
-  auto doc = ReaderDocument::from_stream(lisptext);
-  return create(name, doc.get_root().get_mapping());
-}
-
 /* EOF */
@@ -27,11 +27,6 @@ public:
   static GameObjectFactory& instance();
 
 public:
-  using ObjectFactory::create;
-  std::unique_ptr<GameObject> create(const std::string& name,
-                                     const Vector& pos, const Direction& dir = Direction::AUTO,
-                                     const std::string& data = {}) const;
-
 private:
   GameObjectFactory();
 
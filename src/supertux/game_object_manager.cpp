@@ -20,8 +20,12 @@
 #include <algorithm>
 
 #include "object/tilemap.hpp"
+#include "supertux/moving_object.hpp"
+#include "util/profiler.hpp"
+#include "video/drawing_context.hpp"
 
 bool GameObjectManager::s_draw_solids_only = false;
+uint32_t GameObjectManager::s_change_count = 0;
 
 GameObjectManager::GameObjectManager() :
   m_uid_generator(),
@@ -31,7 +35,8 @@ GameObjectManager::GameObjectManager() :
   m_objects_by_name(),
   m_objects_by_uid(),
   m_objects_by_type_index(),
-  m_name_resolve_requests()
+  m_name_resolve_requests(),
+  m_change_count(++s_change_count)
 {
 }
 
@@ -131,11 +136,15 @@ GameObjectManager::clear_objects()
     before_object_remove(*obj);
   }
   m_gameobjects.clear();
+  m_change_count = ++s_change_count;
+  after_objects_removed();
 }
 
 void
 GameObjectManager::update(float dt_sec)
 {
+  ProfileZone profile_zone("GameObjectManager::update");
+
   for (const auto& object : m_gameobjects)
   {
     if (!object->is_valid())
@@ -148,11 +157,24 @@ GameObjectManager::update(float dt_sec)
 void
 GameObjectManager::draw(DrawingContext& context)
 {
+  ProfileZone profile_zone("GameObjectManager::draw");
+
+  const Rectf cliprect = context.get_cliprect();
+
   for (const auto& object : m_gameobjects)
   {
     if (!object->is_valid())
       continue;
 
+    // Don't bother drawing objects that are out of view
+    auto moving_object = dynamic_cast<MovingObject*>(object.get());
+    if (moving_object && !moving_object->draws_outside_bbox() &&
+        !cliprect.contains(moving_object->get_bbox().grown(moving_object->get_draw_margin())))
+    {
+      moving_object->skip_draw();
+      continue;
+    }
+
     if (s_draw_solids_only)
     {
       auto tm = dynamic_cast<TileMap*>(object.get());
@@ -181,6 +203,7 @@ GameObjectManager::flush_game_objects()
                        }
                      }),
       m_gameobjects.end());
+    after_objects_removed();
   }
 
   { // add newly created objects
@@ -225,6 +248,10 @@ GameObjectManager::update_solid(TileMap* tm) {
 void
 GameObjectManager::this_before_object_add(GameObject& object)
 {
+  if (object.is_saveable()) {
+    m_change_count = ++s_change_count;
+  }
+
   { // by_name
     if (!object.get_name().empty())
     {
@@ -246,6 +273,10 @@ GameObjectManager::this_before_object_add(GameObject& object)
 void
 GameObjectManager::this_before_object_remove(GameObject& object)
 {
+  if (object.is_saveable()) {
+    m_change_count = ++s_change_count;
+  }
+
   { // by_name
     const std::string& name = object.get_name();
     if (!name.empty())
@@ -69,6 +69,10 @@ public:
   /** Commit the queued up additions and deletions to the object list */
   void flush_game_objects();
 
+  /** Changes whenever a saveable object is added or removed, lets the
+      editor tell cheaply whether the list of saved objects is the same */
+  uint32_t get_change_count() const { return m_change_count; }
+
   float get_width() const;
   float get_height() const;
 
@@ -84,6 +88,11 @@ public:
   /** Hook that is called before an object is removed from the vector */
   virtual void before_object_remove(GameObject& object) = 0;
 
+  /** Hook that is called once the objects passed to
+      before_object_remove() are gone from the vector, before new objects
+      are added */
+  virtual void after_objects_removed() {}
+
   template<class T>
   GameObjectRange<T> get_objects_by_type() const
   {
@@ -220,6 +229,11 @@ private:
 
   std::vector<NameResolveRequest> m_name_resolve_requests;
 
+  /** Shared by all managers, so that a new sector never repeats the
+      change count of a deleted one */
+  static uint32_t s_change_count;
+  uint32_t m_change_count;
+
 private:
   GameObjectManager(const GameObjectManager&) = delete;
   GameObjectManager& operator=(const GameObjectManager&) = delete;
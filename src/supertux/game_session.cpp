@@ -17,6 +17,7 @@
 #include "supertux/game_session.hpp"
 
 #include <cfloat>
+#include <chrono>
 
 #include "audio/sound_manager.hpp"
 #include "control/input_manager.hpp"
@@ -31,7 +32,10 @@
 #include "object/music_object.hpp"
 #include "object/player.hpp"
 #include "sdk/integration.hpp"
+#include "supertux/benchmark.hpp"
+#include "supertux/compiled_level.hpp"
 #include "supertux/fadetoblack.hpp"
+#include "supertux/game_object_factory.hpp"
 #include "supertux/gameconfig.hpp"
 #include "supertux/level.hpp"
 #include "supertux/level_parser.hpp"
@@ -47,12 +51,15 @@
 #include "video/surface.hpp"
 #include "worldmap/worldmap.hpp"
 
-GameSession::GameSession(const std::string& levelfile_, Savegame& savegame, Statistics* statistics) :
+GameSession::GameSession(const std::string& levelfile_, Savegame& savegame, Statistics* statistics,
+                         std::unique_ptr<ReaderDocument> level_document) :
   GameSessionRecorder(),
   reset_button(false),
   reset_checkpoint_button(false),
   m_level(),
   m_old_level(),
+  m_level_document(std::move(level_document)),
+  m_level_prototype(),
   m_statistics_backdrop(Surface::from_file("images/engine/menu/score-backdrop.png")),
   m_scripts(),
   m_currentsector(nullptr),
@@ -82,7 +89,14 @@ GameSession::GameSession(const std::string& levelfile_, Savegame& savegame, Stat
   m_end_seq_started(false),
   m_current_cutscene_text()
 {
-  if (restart_level() != 0)
+  // the objects spawned in the previous level don't matter anymore
+  GameObjectFactory::instance().clear_prototypes();
+
+  const int result = restart_level();
+  if (m_level_prototype) {
+    m_level_document.reset();
+  }
+  if (result != 0)
     throw std::runtime_error ("Initializing the level failed.");
 }
 
@@ -124,9 +138,17 @@ GameSession::restart_level(bool after_death)
     m_levelfile = FileSystem::basename(m_levelfile);
   }
 
+  const auto start_time = std::chrono::steady_clock::now();
   try {
     m_old_level = std::move(m_level);
-    m_level = LevelParser::from_file(m_levelfile, false, false);
+    if (m_level_prototype)
+      m_level = LevelParser::from_prototype(*m_level_prototype, m_levelfile);
+    else if (!m_old_level)
+      m_level = LevelParser::from_file_with_prototype(m_levelfile, m_level_document.get(), m_level_prototype);
+    else if (m_level_document)
+      m_level = LevelParser::from_document(*m_level_document, false, false);
+    else
+      m_level = LevelParser::from_file(m_levelfile, false, false);
 
     if (!m_reset_sector.empty()) {
       m_currentsector = m_level->get_sector(m_reset_sector);
@@ -153,6 +175,10 @@ GameSession::restart_level(bool after_death)
     return (-1);
   }
 
+  log_info << "level '" << m_levelfile << "' " << (m_old_level ? "restarted" : "loaded") << " in "
+           << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count()
+           << " ms" << std::endl;
+
   auto& music_object = m_currentsector->get_singleton_by_type<MusicObject>();
   if (after_death == true) {
     music_object.resume_music();
@@ -304,7 +330,8 @@ GameSession::setup()
   m_currentsector->get_singleton_by_type<MusicObject>().play_music(LEVEL_MUSIC);
 
   int total_stats_to_be_collected = m_level->m_stats.m_total_coins + m_level->m_stats.m_total_badguys + m_level->m_stats.m_total_secrets;
-  if ((!m_levelintro_shown) && (total_stats_to_be_collected > 0)) {
+  // The intro waits for a key press, which never comes in a headless benchmark
+  if ((!m_levelintro_shown) && (total_stats_to_be_collected > 0) && !Benchmark::current()) {
     m_levelintro_shown = true;
     m_active = false;
     ScreenManager::current()->push_screen(std::make_unique<LevelIntro>(*m_level, m_best_level_statistics, m_savegame.get_player_status()));
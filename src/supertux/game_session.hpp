@@ -29,9 +29,11 @@
 #include "supertux/screen.hpp"
 #include "supertux/sequence.hpp"
 #include "util/currenton.hpp"
+#include "util/reader_document.hpp"
 #include "video/surface_ptr.hpp"
 
 class CodeController;
+class CompiledLevel;
 class DrawingContext;
 class EndSequence;
 class Level;
@@ -45,7 +47,10 @@ class GameSession final : public Screen,
                           public Currenton<GameSession>
 {
 public:
-  GameSession(const std::string& levelfile, Savegame& savegame, Statistics* statistics = nullptr);
+  /** If level_document is given, the level is built from it instead
+      of reading levelfile again. It is only used by the constructor. */
+  GameSession(const std::string& levelfile, Savegame& savegame, Statistics* statistics = nullptr,
+              std::unique_ptr<ReaderDocument> level_document = {});
 
   virtual void draw(Compositor& compositor) override;
   virtual void update(float dt_sec, const Controller& controller) override;
@@ -105,6 +110,17 @@ private:
 private:
   std::unique_ptr<Level> m_level;
   std::unique_ptr<Level> m_old_level;
+
+  /** The document the level was loaded from, if it was passed in, kept
+      for restarts if no prototype could be made from it */
+  std::unique_ptr<ReaderDocument> m_level_document;
+
+  /** The level as it was loaded, restart_level() rebuilds it from this
+      instead of reading and parsing the level file again. Null for levels
+      that can't be compiled, those are rebuilt from m_level_document or
+      read again. */
+  std::unique_ptr<CompiledLevel> m_level_prototype;
+
   SurfacePtr m_statistics_backdrop;
 
   // scripts
@@ -124,6 +124,12 @@ GameSessionRecorder::play_demo(const std::string& filename)
   m_playing = false;
 }
 
+bool
+GameSessionRecorder::is_demo_finished() const
+{
+  return m_playback_demo_stream != nullptr && !m_playback_demo_stream->good();
+}
+
 void
 GameSessionRecorder::reset_demo_controller()
 {
@@ -21,13 +21,16 @@
 #include "object/coin.hpp"
 #include "physfs/util.hpp"
 #include "supertux/sector.hpp"
+#include "supertux/sector_parser.hpp"
 #include "trigger/secretarea_trigger.hpp"
+#include "util/binary_sexp.hpp"
 #include "util/file_system.hpp"
 #include "util/log.hpp"
+#include "util/reader_document.hpp"
+#include "util/reader_mapping.hpp"
 #include "util/writer.hpp"
 
 #include <physfs.h>
-#include <numeric>
 
 #include <boost/algorithm/string/predicate.hpp>
 
@@ -42,6 +45,7 @@ Level::Level(bool worldmap) :
   m_filename(),
   m_note(),
   m_sectors(),
+  m_deferred_sectors(),
   m_stats(),
   m_target_time(),
   m_tileset("images/tiles.strf"),
@@ -120,6 +124,8 @@ Level::save(const std::string& filepath, bool retry)
 void
 Level::save(Writer& writer)
 {
+  load_deferred_sectors();
+
   writer.start_list("supertux-level");
   // Starts writing to supertux level file. Keep this at the very beginning.
 
@@ -165,58 +171,111 @@ Level::add_sector(std::unique_ptr<Sector> sector)
 }
 
 Sector*
-Level::get_sector(const std::string& name_) const
+Level::get_sector(const std::string& name_)
 {
   auto _sector = std::find_if(m_sectors.begin(), m_sectors.end(), [name_] (const std::unique_ptr<Sector>& sector) {
     return sector->get_name() == name_;
   });
-  if(_sector == m_sectors.end())
-    return nullptr;
-  return _sector->get();
+  if (_sector != m_sectors.end())
+    return _sector->get();
+
+  for (size_t i = 0; i < m_deferred_sectors.size(); ++i) {
+    if (m_deferred_sectors[i].name == name_)
+      return load_deferred_sector(i);
+  }
+  return nullptr;
 }
 
 size_t
 Level::get_sector_count() const
 {
-  return m_sectors.size();
+  return m_sectors.size() + m_deferred_sectors.size();
 }
 
 Sector*
-Level::get_sector(size_t num) const
+Level::get_sector(size_t num)
 {
+  load_deferred_sectors();
   return m_sectors.at(num).get();
 }
 
+Sector*
+Level::load_deferred_sector(size_t index)
+{
+  auto data = std::move(m_deferred_sectors[index]);
+  m_deferred_sectors.erase(m_deferred_sectors.begin() + index);
+
+  log_debug << "loading deferred sector '" << data.name << "' of " << m_filename << std::endl;
+
+  ReaderDocument doc(m_filename, binary_sexp::read(data.data));
+  auto sector = SectorParser::from_reader(*this, doc.get_root().get_mapping(), false);
+  m_sectors.push_back(std::move(sector));
+  return m_sectors.back().get();
+}
+
+void
+Level::load_deferred_sectors()
+{
+  while (!m_deferred_sectors.empty()) {
+    load_deferred_sector(0);
+  }
+}
+
 int
-Level::get_total_coins() const
+Level::get_coin_count(const Sector& sector)
 {
   int total_coins = 0;
-  for (auto const& sector : m_sectors) {
-    for (const auto& o: sector->get_objects()) {
-      auto coin = dynamic_cast<Coin*>(o.get());
-      if (coin)
+  for (const auto& o: sector.get_objects()) {
+    auto coin = dynamic_cast<Coin*>(o.get());
+    if (coin)
+    {
+      total_coins++;
+      continue;
+    }
+    auto block = dynamic_cast<BonusBlock*>(o.get());
+    if (block)
+    {
+      if (block->get_contents() == BonusBlock::Content::COIN)
       {
-        total_coins++;
+        total_coins += block->get_hit_counter();
         continue;
-      }
-      auto block = dynamic_cast<BonusBlock*>(o.get());
-      if (block)
+      } else if (block->get_contents() == BonusBlock::Content::RAIN ||
+                 block->get_contents() == BonusBlock::Content::EXPLODE)
       {
-        if (block->get_contents() == BonusBlock::Content::COIN)
-        {
-          total_coins += block->get_hit_counter();
-          continue;
-        } else if (block->get_contents() == BonusBlock::Content::RAIN ||
-                   block->get_contents() == BonusBlock::Content::EXPLODE)
-        {
-          total_coins += 10;
-          continue;
-        }
-      }
-      auto goldbomb = dynamic_cast<GoldBomb*>(o.get());
-      if (goldbomb)
         total_coins += 10;
+        continue;
+      }
     }
+    auto goldbomb = dynamic_cast<GoldBomb*>(o.get());
+    if (goldbomb)
+      total_coins += 10;
+  }
+  return total_coins;
+}
+
+int
+Level::get_badguy_count(const Sector& sector)
+{
+  return sector.get_object_count<BadGuy>([] (const BadGuy& badguy) {
+    return badguy.m_countMe;
+  });
+}
+
+int
+Level::get_secret_count(const Sector& sector)
+{
+  return sector.get_object_count<SecretAreaTrigger>();
+}
+
+int
+Level::get_total_coins() const
+{
+  int total_coins = 0;
+  for (auto const& sector : m_sectors) {
+    total_coins += get_coin_count(*sector);
+  }
+  for (auto const& deferred : m_deferred_sectors) {
+    total_coins += deferred.coins;
   }
   return total_coins;
 }
@@ -226,9 +285,10 @@ Level::get_total_badguys() const
 {
   int total_badguys = 0;
   for (auto const& sector : m_sectors) {
-    total_badguys += sector->get_object_count<BadGuy>([] (const BadGuy& badguy) {
-      return badguy.m_countMe;
-    });
+    total_badguys += get_badguy_count(*sector);
+  }
+  for (auto const& deferred : m_deferred_sectors) {
+    total_badguys += deferred.badguys;
   }
   return total_badguys;
 }
@@ -236,10 +296,14 @@ Level::get_total_badguys() const
 int
 Level::get_total_secrets() const
 {
-  auto get_secret_count = [](int accumulator, const std::unique_ptr<Sector>& sector) {
-    return accumulator + sector->get_object_count<SecretAreaTrigger>();
-  };
-  return std::accumulate(m_sectors.begin(), m_sectors.end(), 0, get_secret_count);
+  int total_secrets = 0;
+  for (auto const& sector : m_sectors) {
+    total_secrets += get_secret_count(*sector);
+  }
+  for (auto const& deferred : m_deferred_sectors) {
+    total_secrets += deferred.secrets;
+  }
+  return total_secrets;
 }
 
 void
@@ -17,6 +17,7 @@
 #ifndef HEADER_SUPERTUX_SUPERTUX_LEVEL_HPP
 #define HEADER_SUPERTUX_SUPERTUX_LEVEL_HPP
 
+#include "supertux/compiled_level.hpp"
 #include "supertux/statistics.hpp"
 
 class ReaderMapping;
@@ -36,6 +37,13 @@ public:
 private:
   static Level* s_current;
 
+public:
+  /** Amount of coins, counted badguys and secret areas in a sector,
+      used for the statistics totals */
+  static int get_coin_count(const Sector& sector);
+  static int get_badguy_count(const Sector& sector);
+  static int get_secret_count(const Sector& sector);
+
 public:
   Level(bool m_is_worldmap);
   ~Level();
@@ -48,10 +56,12 @@ public:
   const std::string& get_name() const { return m_name; }
   const std::string& get_author() const { return m_author; }
 
-  Sector* get_sector(const std::string& name) const;
+  /** Returns the sector with the given name, parsing it first if it is
+      a deferred sector of a compiled level */
+  Sector* get_sector(const std::string& name);
 
   size_t get_sector_count() const;
-  Sector* get_sector(size_t num) const;
+  Sector* get_sector(size_t num);
 
   std::string get_tileset() const { return m_tileset; }
 
@@ -67,6 +77,9 @@ private:
   void save(Writer& writer);
   void load_old_format(const ReaderMapping& reader);
 
+  Sector* load_deferred_sector(size_t index);
+  void load_deferred_sectors();
+
 public:
   bool m_is_worldmap;
   std::string m_name;
@@ -76,6 +89,9 @@ public:
   std::string m_filename;
   std::string m_note;
   std::vector<std::unique_ptr<Sector> > m_sectors;
+
+  /** Sectors of a compiled level that weren't entered yet */
+  std::vector<CompiledLevel::SectorData> m_deferred_sectors;
   Statistics m_stats;
   float m_target_time;
   std::string m_tileset;
@@ -0,0 +1,296 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "supertux/level_loader.hpp"
+
+#include <algorithm>
+#include <assert.h>
+#include <physfs.h>
+#include <sexp/value.hpp>
+
+#include "physfs/ifile_stream.hpp"
+#include "supertux/compiled_level.hpp"
+#include "supertux/tile_manager.hpp"
+#include "util/file_system.hpp"
+#include "util/reader_document.hpp"
+#include "util/reader_mapping.hpp"
+#include "util/string_util.hpp"
+#include "video/texture_manager.hpp"
+
+namespace {
+
+/** Share of the progress bar taken by parsing, before the images are
+    known */
+const float PARSE_PROGRESS = 0.1f;
+
+const unsigned int MAX_DECODE_THREADS = 4;
+
+bool
+is_image_file(const std::string& filename)
+{
+  return StringUtil::has_suffix(filename, ".png") ||
+         StringUtil::has_suffix(filename, ".jpg");
+}
+
+/** Collects every string of the document that looks like an image or
+    a sprite, which doesn't need to know about the object types */
+void
+collect_files(const sexp::Value& sx, std::vector<std::string>& images, std::vector<std::string>& sprites)
+{
+  if (sx.is_array())
+  {
+    for (const auto& item : sx.as_array())
+      collect_files(item, images, sprites);
+  }
+  else if (sx.is_string())
+  {
+    const std::string& text = sx.as_string();
+    if (is_image_file(text))
+      images.push_back(text);
+    else if (StringUtil::has_suffix(text, ".sprite"))
+      sprites.push_back(text);
+  }
+}
+
+/** Levels mostly refer to files relative to the data directory, but
+    add-on levels sometimes refer to files next to themselves */
+std::string
+resolve_level_file(const std::string& directory, const std::string& filename)
+{
+  if (PHYSFS_exists(filename.c_str()))
+    return filename;
+  else
+    return FileSystem::join(directory, filename);
+}
+
+} // namespace
+
+LevelLoader::LevelLoader(const std::string& filename) :
+  m_filename(filename),
+  m_stage(Stage::PARSING_LEVEL),
+  m_workers(),
+  m_running_workers(0),
+  m_error(),
+  m_document(),
+  m_tileset(),
+  m_sprite_files(),
+  m_images(),
+  m_next_image(0),
+  m_decoded_images(0)
+{
+  start_workers(1, [this]{ parse_level(); });
+}
+
+LevelLoader::~LevelLoader()
+{
+  // Let the decoders run out of work early, the other stages are
+  // short enough to be waited for
+  if (m_stage == Stage::DECODING)
+    m_next_image = m_images.size();
+  join_workers();
+}
+
+void
+LevelLoader::update()
+{
+  if (m_stage == Stage::FINISHED || m_running_workers > 0)
+    return;
+
+  join_workers();
+
+  switch (m_stage)
+  {
+    case Stage::PARSING_LEVEL:
+      if (m_error)
+      {
+        m_stage = Stage::FINISHED;
+        break;
+      }
+
+      // Tilesets stay loaded once used, typically only add-ons bring a
+      // new one
+      if (TileManager::current()->has_tileset(m_tileset))
+        m_tileset.clear();
+
+      m_stage = Stage::SCANNING;
+      start_workers(1, [this]{ scan_resources(); });
+      break;
+
+    case Stage::SCANNING:
+      if (m_images.empty())
+      {
+        m_stage = Stage::FINISHED;
+        break;
+      }
+
+      m_stage = Stage::DECODING;
+      {
+        const unsigned int threads = std::max(1u, std::min(MAX_DECODE_THREADS, std::thread::hardware_concurrency()));
+        start_workers(static_cast<int>(std::min(static_cast<size_t>(threads), m_images.size())),
+                      [this]{ decode_images(); });
+      }
+      break;
+
+    case Stage::DECODING:
+    case Stage::FINISHED:
+      m_stage = Stage::FINISHED;
+      break;
+  }
+}
+
+float
+LevelLoader::get_progress() const
+{
+  switch (m_stage)
+  {
+    case Stage::PARSING_LEVEL:
+      return 0.0f;
+
+    case Stage::SCANNING:
+      return PARSE_PROGRESS;
+
+    case Stage::DECODING:
+      return PARSE_PROGRESS + (1.0f - PARSE_PROGRESS) *
+        static_cast<float>(m_decoded_images) / static_cast<float>(m_images.size());
+
+    case Stage::FINISHED:
+    default:
+      return 1.0f;
+  }
+}
+
+std::unique_ptr<ReaderDocument>
+LevelLoader::release_document()
+{
+  assert(is_finished());
+
+  if (m_error)
+    std::rethrow_exception(m_error);
+
+  return std::move(m_document);
+}
+
+void
+LevelLoader::start_workers(int count, const std::function<void ()>& work)
+{
+  m_running_workers = count;
+  for (int i = 0; i < count; ++i)
+  {
+    m_workers.emplace_back([this, work]{
+      work();
+      m_running_workers -= 1;
+    });
+  }
+}
+
+void
+LevelLoader::join_workers()
+{
+  for (auto& worker : m_workers)
+    worker.join();
+  m_workers.clear();
+}
+
+void
+LevelLoader::parse_level()
+{
+  try
+  {
+    const std::string compiled_filename = CompiledLevel::find(m_filename);
+    if (compiled_filename.empty())
+    {
+      m_document = std::make_unique<ReaderDocument>(ReaderDocument::from_file(m_filename));
+      scan_level(*m_document);
+    }
+    else
+    {
+      // The GameSession reads the compiled level itself so that its sectors
+      // stay deferred, the decoded copy is only scanned for files here
+      IFileStream in(compiled_filename);
+      auto compiled = CompiledLevel::from_stream(in);
+      scan_level(ReaderDocument(m_filename, compiled.to_sexp()));
+    }
+  }
+  catch(...)
+  {
+    m_error = std::current_exception();
+  }
+}
+
+void
+LevelLoader::scan_level(const ReaderDocument& doc)
+{
+  m_tileset = "images/tiles.strf";
+  auto root = doc.get_root();
+  if (root.get_name() == "supertux-level")
+    root.get_mapping().get("tileset", m_tileset);
+
+  std::vector<std::string> images;
+  std::vector<std::string> sprites;
+  collect_files(doc.get_sexp(), images, sprites);
+
+  const std::string directory = doc.get_directory();
+  for (const auto& image : images)
+    m_images.push_back(resolve_level_file(directory, image));
+  for (const auto& sprite : sprites)
+    m_sprite_files.push_back(resolve_level_file(directory, sprite));
+}
+
+void
+LevelLoader::scan_resources()
+{
+  std::vector<std::string> files = m_sprite_files;
+  if (!m_tileset.empty())
+    files.push_back(m_tileset);
+
+  // Problems with these files get reported by the main thread once
+  // the level really uses them
+  for (const auto& filename : files)
+  {
+    try
+    {
+      const auto doc = ReaderDocument::from_file(filename);
+
+      std::vector<std::string> images;
+      std::vector<std::string> sprites;
+      collect_files(doc.get_sexp(), images, sprites);
+
+      const std::string directory = doc.get_directory();
+      for (const auto& image : images)
+        m_images.push_back(FileSystem::join(directory, image));
+    }
+    catch(const std::exception&)
+    {
+    }
+  }
+
+  for (auto& image : m_images)
+    image = FileSystem::normalize(image);
+  std::sort(m_images.begin(), m_images.end());
+  m_images.erase(std::unique(m_images.begin(), m_images.end()), m_images.end());
+}
+
+void
+LevelLoader::decode_images()
+{
+  for (size_t i = m_next_image++; i < m_images.size(); i = m_next_image++)
+  {
+    TextureManager::current()->preload(m_images[i]);
+    m_decoded_images += 1;
+  }
+}
+
+/* EOF */
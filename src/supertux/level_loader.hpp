@@ -0,0 +1,87 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_SUPERTUX_LEVEL_LOADER_HPP
+#define HEADER_SUPERTUX_SUPERTUX_LEVEL_LOADER_HPP
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+class ReaderDocument;
+
+/** Does the slow parts of loading a level on worker threads: parsing
+    the level file and decoding the images it uses into the
+    TextureManager. Building the Level itself and uploading the
+    textures is left to the main thread, which has to call update()
+    regularly to move the loader from one stage to the next. */
+class LevelLoader final
+{
+public:
+  explicit LevelLoader(const std::string& filename);
+  ~LevelLoader();
+
+  void update();
+
+  bool is_finished() const { return m_stage == Stage::FINISHED; }
+
+  /** Returns how much of the work is done, between 0 and 1 */
+  float get_progress() const;
+
+  /** Returns the parsed level file once finished, rethrows the error
+      if it couldn't be parsed. Compiled levels are left to LevelParser,
+      nullptr is returned for them. */
+  std::unique_ptr<ReaderDocument> release_document();
+
+private:
+  enum class Stage { PARSING_LEVEL, SCANNING, DECODING, FINISHED };
+
+  void start_workers(int count, const std::function<void ()>& work);
+  void join_workers();
+
+  void parse_level();
+  void scan_level(const ReaderDocument& doc);
+  void scan_resources();
+  void decode_images();
+
+private:
+  std::string m_filename;
+  Stage m_stage;
+
+  std::vector<std::thread> m_workers;
+  std::atomic<int> m_running_workers;
+  std::exception_ptr m_error;
+
+  std::unique_ptr<ReaderDocument> m_document;
+  std::string m_tileset;
+  std::vector<std::string> m_sprite_files;
+  std::vector<std::string> m_images;
+
+  std::atomic<size_t> m_next_image;
+  std::atomic<size_t> m_decoded_images;
+
+private:
+  LevelLoader(const LevelLoader&) = delete;
+  LevelLoader& operator=(const LevelLoader&) = delete;
+};
+
+#endif
+
+/* EOF */
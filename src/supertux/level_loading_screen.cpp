@@ -0,0 +1,121 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "supertux/level_loading_screen.hpp"
+
+#include "supertux/game_session.hpp"
+#include "supertux/globals.hpp"
+#include "supertux/level.hpp"
+#include "supertux/resources.hpp"
+#include "supertux/screen_fade.hpp"
+#include "supertux/screen_manager.hpp"
+#include "util/gettext.hpp"
+#include "util/log.hpp"
+#include "util/reader_document.hpp"
+#include "video/compositor.hpp"
+#include "video/drawing_context.hpp"
+#include "video/texture_manager.hpp"
+
+namespace {
+
+const float BAR_WIDTH = 320.0f;
+const float BAR_HEIGHT = 12.0f;
+
+} // namespace
+
+LevelLoadingScreen::LevelLoadingScreen(const std::string& levelfile, Savegame& savegame, Statistics* statistics) :
+  m_levelfile(levelfile),
+  m_savegame(savegame),
+  m_statistics(statistics),
+  m_loader(levelfile),
+  m_done(false)
+{
+}
+
+void
+LevelLoadingScreen::update(float dt_sec, const Controller& controller)
+{
+  if (m_done)
+    return;
+
+  m_loader.update();
+  if (m_loader.is_finished())
+  {
+    m_done = true;
+    start_session();
+  }
+}
+
+void
+LevelLoadingScreen::start_session()
+{
+  std::unique_ptr<ReaderDocument> document;
+  try
+  {
+    document = m_loader.release_document();
+  }
+  catch(const std::exception& e)
+  {
+    log_fatal << "Couldn't load level '" << m_levelfile << "': " << e.what() << std::endl;
+    TextureManager::current()->clear_preloaded();
+    ScreenManager::current()->pop_screen();
+    return;
+  }
+
+  try
+  {
+    auto session = std::make_unique<GameSession>(m_levelfile, m_savegame, m_statistics, std::move(document));
+    ScreenManager::current()->pop_screen();
+    ScreenManager::current()->push_screen(std::move(session));
+  }
+  catch(const std::exception& e)
+  {
+    // GameSession already took this screen down when it failed
+    log_fatal << "Couldn't start level '" << m_levelfile << "': " << e.what() << std::endl;
+  }
+
+  TextureManager::current()->clear_preloaded();
+}
+
+void
+LevelLoadingScreen::draw(Compositor& compositor)
+{
+  auto& context = compositor.make_context();
+  const float width = static_cast<float>(context.get_width());
+  const float height = static_cast<float>(context.get_height());
+
+  context.set_ambient_color(Color(1.0f, 1.0f, 1.0f, 1.0f));
+  context.color().draw_filled_rect(Rectf(0, 0, width, height), Color(0.0f, 0.0f, 0.0f, 1.0f), 0);
+
+  const float text_y = height / 2.0f - Resources::normal_font->get_height() - BAR_HEIGHT;
+  context.color().draw_center_text(Resources::normal_font, _("Loading..."), Vector(0, text_y), LAYER_FOREGROUND1);
+
+  const Rectf bar(Vector((width - BAR_WIDTH) / 2.0f, height / 2.0f), Sizef(BAR_WIDTH, BAR_HEIGHT));
+  context.color().draw_filled_rect(bar, Color(0.3f, 0.3f, 0.3f, 1.0f), LAYER_FOREGROUND1);
+  context.color().draw_filled_rect(Rectf(bar.get_left(), bar.get_top(),
+                                         bar.get_left() + BAR_WIDTH * m_loader.get_progress(), bar.get_bottom()),
+                                   Color(1.0f, 1.0f, 1.0f, 1.0f), LAYER_FOREGROUND1 + 1);
+}
+
+IntegrationStatus
+LevelLoadingScreen::get_status() const
+{
+  IntegrationStatus status;
+  status.m_details.push_back("Loading a level");
+  return status;
+}
+
+/* EOF */
@@ -0,0 +1,56 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_SUPERTUX_LEVEL_LOADING_SCREEN_HPP
+#define HEADER_SUPERTUX_SUPERTUX_LEVEL_LOADING_SCREEN_HPP
+
+#include <string>
+
+#include "supertux/level_loader.hpp"
+#include "supertux/screen.hpp"
+
+class Savegame;
+class Statistics;
+
+/** Screen that shows the progress of a LevelLoader and replaces
+    itself with the GameSession once the level is loaded */
+class LevelLoadingScreen final : public Screen
+{
+public:
+  LevelLoadingScreen(const std::string& levelfile, Savegame& savegame, Statistics* statistics = nullptr);
+
+  virtual void draw(Compositor& compositor) override;
+  virtual void update(float dt_sec, const Controller& controller) override;
+  virtual IntegrationStatus get_status() const override;
+
+private:
+  void start_session();
+
+private:
+  std::string m_levelfile;
+  Savegame& m_savegame;
+  Statistics* m_statistics;
+  LevelLoader m_loader;
+  bool m_done;
+
+private:
+  LevelLoadingScreen(const LevelLoadingScreen&) = delete;
+  LevelLoadingScreen& operator=(const LevelLoadingScreen&) = delete;
+};
+
+#endif
+
+/* EOF */
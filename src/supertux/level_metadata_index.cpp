@@ -0,0 +1,351 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "supertux/level_metadata_index.hpp"
+
+#include <stdexcept>
+#include <stdlib.h>
+#include <string.h>
+
+#include "addon/md5.hpp"
+#include "physfs/mapped_file.hpp"
+#include "util/file_system.hpp"
+#include "util/gettext.hpp"
+#include "util/log.hpp"
+#include "util/reader_mapping.hpp"
+#include "util/writer.hpp"
+
+namespace {
+
+/** Tokenizer for just as much of the s-expression syntax as needed to
+    read the top-level properties of a level and to skip the rest */
+class HeaderScanner final
+{
+public:
+  HeaderScanner(const char* data, size_t size) :
+    m_pos(data),
+    m_end(data + size)
+  {
+  }
+
+  bool at_end()
+  {
+    skip_whitespace();
+    return m_pos == m_end;
+  }
+
+  bool accept(char c)
+  {
+    skip_whitespace();
+    if (m_pos != m_end && *m_pos == c) {
+      ++m_pos;
+      return true;
+    }
+    return false;
+  }
+
+  void expect(char c)
+  {
+    if (!accept(c))
+      throw std::runtime_error(std::string("expected '") + c + "'");
+  }
+
+  /** Reads a symbol, number or boolean */
+  std::string read_atom()
+  {
+    skip_whitespace();
+    const char* start = m_pos;
+    while (m_pos != m_end && !is_delimiter(*m_pos))
+      ++m_pos;
+    return std::string(start, m_pos);
+  }
+
+  bool is_string()
+  {
+    skip_whitespace();
+    return m_pos != m_end && *m_pos == '"';
+  }
+
+  std::string read_string()
+  {
+    expect('"');
+    std::string result;
+    while (m_pos != m_end && *m_pos != '"')
+    {
+      if (*m_pos == '\\' && m_pos + 1 != m_end) {
+        ++m_pos;
+        result += (*m_pos == 'n') ? '\n' : (*m_pos == 't') ? '\t' : *m_pos;
+      } else {
+        result += *m_pos;
+      }
+      ++m_pos;
+    }
+    expect('"');
+    return result;
+  }
+
+  /** Moves past the ')' closing the current list, without looking at
+      what is inside */
+  void skip_list()
+  {
+    int depth = 1;
+    while (m_pos != m_end)
+    {
+      const char c = *m_pos++;
+      if (c == '"') {
+        while (m_pos != m_end && *m_pos != '"') {
+          if (*m_pos == '\\' && m_pos + 1 != m_end)
+            ++m_pos;
+          ++m_pos;
+        }
+        if (m_pos != m_end)
+          ++m_pos;
+      } else if (c == ';') {
+        skip_comment();
+      } else if (c == '(') {
+        depth += 1;
+      } else if (c == ')') {
+        depth -= 1;
+        if (depth == 0)
+          return;
+      }
+    }
+    throw std::runtime_error("unexpected end of file");
+  }
+
+private:
+  static bool is_delimiter(char c)
+  {
+    return c == '(' || c == ')' || c == '"' || c == ';' ||
+      c == ' ' || c == '\t' || c == '\n' || c == '\r';
+  }
+
+  void skip_whitespace()
+  {
+    while (m_pos != m_end)
+    {
+      if (*m_pos == ';') {
+        skip_comment();
+      } else if (*m_pos == ' ' || *m_pos == '\t' || *m_pos == '\n' || *m_pos == '\r') {
+        ++m_pos;
+      } else {
+        return;
+      }
+    }
+  }
+
+  void skip_comment()
+  {
+    const void* newline = memchr(m_pos, '\n', m_end - m_pos);
+    m_pos = newline ? static_cast<const char*>(newline) : m_end;
+  }
+
+private:
+  const char* m_pos;
+  const char* m_end;
+
+private:
+  HeaderScanner(const HeaderScanner&) = delete;
+  HeaderScanner& operator=(const HeaderScanner&) = delete;
+};
+
+/** Reads a string that might be marked for translation as (_ "text") */
+std::string read_text(HeaderScanner& scanner, bool& translatable)
+{
+  if (scanner.accept('(')) {
+    if (scanner.read_atom() != "_")
+      throw std::runtime_error("expected string");
+    translatable = true;
+    std::string text = scanner.read_string();
+    scanner.expect(')');
+    return text;
+  } else {
+    translatable = false;
+    return scanner.read_string();
+  }
+}
+
+} // namespace
+
+LevelMetadata::LevelMetadata() :
+  name(),
+  name_translatable(false),
+  target_time(0.0f),
+  author(),
+  license(),
+  sector_count(0),
+  file_stamp(),
+  file_hash()
+{
+}
+
+std::string
+LevelMetadata::get_name() const
+{
+  return name_translatable ? _(name) : name;
+}
+
+LevelMetadata
+LevelMetadataIndex::scan(const char* data, size_t size)
+{
+  HeaderScanner scanner(data, size);
+  LevelMetadata metadata;
+
+  scanner.expect('(');
+  if (scanner.read_atom() != "supertux-level")
+    throw std::runtime_error("file is not a supertux-level file.");
+
+  bool translatable;
+  while (!scanner.accept(')'))
+  {
+    if (scanner.at_end())
+      throw std::runtime_error("unexpected end of file");
+
+    // lone atoms aren't valid in a level, but are skipped like the
+    // parser does when iterating
+    if (!scanner.accept('(')) {
+      if (scanner.is_string())
+        scanner.read_string();
+      else
+        scanner.read_atom();
+      continue;
+    }
+
+    const std::string key = scanner.read_atom();
+    if (key == "sector") {
+      metadata.sector_count += 1;
+    } else if (key == "name") {
+      metadata.name = read_text(scanner, metadata.name_translatable);
+    } else if (key == "author") {
+      metadata.author = read_text(scanner, translatable);
+    } else if (key == "license") {
+      metadata.license = read_text(scanner, translatable);
+    } else if (key == "target-time") {
+      metadata.target_time = strtof(scanner.read_atom().c_str(), nullptr);
+    }
+    scanner.skip_list();
+  }
+
+  return metadata;
+}
+
+LevelMetadataIndex::LevelMetadataIndex(const std::string& filename) :
+  m_filename(filename),
+  m_entries(),
+  m_changed(false)
+{
+  load();
+}
+
+LevelMetadataIndex::~LevelMetadataIndex()
+{
+  try
+  {
+    save();
+  }
+  catch(const std::exception& err)
+  {
+    log_warning << "Couldn't save the level index: " << err.what() << std::endl;
+  }
+}
+
+const LevelMetadata&
+LevelMetadataIndex::get(const std::string& filename)
+{
+  const std::string key = FileSystem::normalize(filename);
+
+  FileStamp stamp;
+  if (!FileStamp::stat(key, stamp)) {
+    throw std::runtime_error("Couldn't find level '" + key + "'");
+  }
+
+  auto it = m_entries.find(key);
+  if (it != m_entries.end() && it->second.file_stamp == stamp)
+  {
+    return it->second;
+  }
+
+  MappedFile file(key);
+  LevelMetadata metadata;
+  try
+  {
+    metadata = scan(file.get_data(), file.get_size());
+  }
+  catch(const std::exception& err)
+  {
+    throw std::runtime_error("Problem when reading '" + key + "': " + err.what());
+  }
+
+  metadata.file_stamp = stamp;
+
+  MD5 md5;
+  md5.update(file.get_data(), file.get_size());
+  metadata.file_hash = md5.hex_digest();
+
+  m_changed = true;
+  return m_entries[key] = std::move(metadata);
+}
+
+void
+LevelMetadataIndex::load()
+{
+  if (!FileStamp::read_cache(m_filename, "supertux-level-index",
+                             [this](const std::string& file, const FileStamp& stamp,
+                                    const ReaderMapping& level) {
+                               LevelMetadata metadata;
+                               level.get("name", metadata.name);
+                               level.get("name-translatable", metadata.name_translatable);
+                               level.get("target-time", metadata.target_time);
+                               level.get("author", metadata.author);
+                               level.get("license", metadata.license);
+                               level.get("sector-count", metadata.sector_count);
+                               level.get("hash", metadata.file_hash);
+                               metadata.file_stamp = stamp;
+
+                               m_entries[file] = std::move(metadata);
+                             }))
+  {
+    m_entries.clear();
+  }
+}
+
+void
+LevelMetadataIndex::save()
+{
+  if (!m_changed)
+    return;
+
+  Writer writer(m_filename);
+  writer.start_list("supertux-level-index");
+  for (const auto& entry : m_entries)
+  {
+    const auto& metadata = entry.second;
+    FileStamp::start_cache_entry(writer, "level", entry.first, metadata.file_stamp);
+    writer.write("name", metadata.name);
+    writer.write("name-translatable", metadata.name_translatable);
+    writer.write("target-time", metadata.target_time);
+    writer.write("author", metadata.author);
+    writer.write("license", metadata.license);
+    writer.write("sector-count", metadata.sector_count);
+    writer.write("hash", metadata.file_hash);
+    writer.end_list("level");
+  }
+  writer.end_list("supertux-level-index");
+
+  m_changed = false;
+}
+
+/* EOF */
@@ -0,0 +1,88 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_SUPERTUX_LEVEL_METADATA_INDEX_HPP
+#define HEADER_SUPERTUX_SUPERTUX_LEVEL_METADATA_INDEX_HPP
+
+#include <string>
+#include <unordered_map>
+
+#include "physfs/file_stamp.hpp"
+#include "util/currenton.hpp"
+
+/** What worldmaps and level menus need to know about a level without
+    loading it */
+struct LevelMetadata
+{
+  LevelMetadata();
+
+  /** The name as written in the file, see get_name() */
+  std::string name;
+  bool name_translatable;
+
+  float target_time;
+  std::string author;
+  std::string license;
+  int sector_count;
+
+  /** Identify the version of the file the metadata was read from */
+  FileStamp file_stamp;
+  std::string file_hash;
+
+  /** Returns the name, translated if it was marked for translation.
+      The translation directory of the level has to be registered. */
+  std::string get_name() const;
+};
+
+/** Remembers the metadata of the levels that were looked at, across
+    runs of the game. The index is stored in the user directory; an entry
+    is read again when the size or modification time of its level file
+    changed. */
+class LevelMetadataIndex final : public Currenton<LevelMetadataIndex>
+{
+public:
+  /** Reads the metadata from the text of a level. Only the top-level
+      properties are parsed, the sectors are skipped over and counted.
+      Throws std::runtime_error if the text isn't a supertux-level. */
+  static LevelMetadata scan(const char* data, size_t size);
+
+public:
+  LevelMetadataIndex(const std::string& filename = "level-index");
+  ~LevelMetadataIndex() override;
+
+  /** Returns the metadata of the level, which is a file of the PhysFS
+      search path. Throws std::runtime_error if it can't be read. */
+  const LevelMetadata& get(const std::string& filename);
+
+  /** Writes the index if it changed since it was loaded */
+  void save();
+
+private:
+  void load();
+
+private:
+  std::string m_filename;
+  std::unordered_map<std::string, LevelMetadata> m_entries;
+  bool m_changed;
+
+private:
+  LevelMetadataIndex(const LevelMetadataIndex&) = delete;
+  LevelMetadataIndex& operator=(const LevelMetadataIndex&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -19,7 +19,10 @@
 #include <physfs.h>
 #include <sstream>
 
+#include "physfs/ifile_stream.hpp"
+#include "supertux/compiled_level.hpp"
 #include "supertux/level.hpp"
+#include "supertux/level_metadata_index.hpp"
 #include "supertux/sector.hpp"
 #include "supertux/sector_parser.hpp"
 #include "util/log.hpp"
@@ -33,17 +36,7 @@ LevelParser::get_level_name(const std::string& filename)
   try
   {
     register_translation_directory(filename);
-    auto doc = ReaderDocument::from_file(filename);
-    auto root = doc.get_root();
-
-    if (root.get_name() != "supertux-level") {
-      return "";
-    } else {
-      auto mapping = root.get_mapping();
-      std::string name;
-      mapping.get("name", name);
-      return name;
-    }
+    return LevelMetadataIndex::current()->get(filename).get_name();
   }
   catch(const std::exception& e)
   {
@@ -71,6 +64,35 @@ LevelParser::from_file(const std::string& filename, bool worldmap, bool editable
   return level;
 }
 
+std::unique_ptr<Level>
+LevelParser::from_document(const ReaderDocument& doc, bool worldmap, bool editable)
+{
+  auto level = std::make_unique<Level>(worldmap);
+  LevelParser parser(*level, worldmap, editable);
+  parser.load_document(doc);
+  return level;
+}
+
+std::unique_ptr<Level>
+LevelParser::from_file_with_prototype(const std::string& filename, const ReaderDocument* doc,
+                                      std::unique_ptr<CompiledLevel>& prototype)
+{
+  auto level = std::make_unique<Level>(false);
+  LevelParser parser(*level, false, false);
+  parser.load_with_prototype(filename, doc, prototype);
+  return level;
+}
+
+std::unique_ptr<Level>
+LevelParser::from_prototype(const CompiledLevel& prototype, const std::string& filename)
+{
+  auto level = std::make_unique<Level>(false);
+  level->m_filename = filename;
+  LevelParser parser(*level, false, false);
+  parser.load_compiled(prototype);
+  return level;
+}
+
 std::unique_ptr<Level>
 LevelParser::from_nothing(const std::string& basedir)
 {
@@ -134,7 +156,29 @@ LevelParser::load(const std::string& filepath)
   m_level.m_filename = filepath;
   register_translation_directory(filepath);
   try {
-    auto doc = ReaderDocument::from_file(filepath);
+    // the editor needs the text file as it has to be able to save it again
+    const std::string compiled_filepath = m_editable ? std::string() : CompiledLevel::find(filepath);
+    if (!compiled_filepath.empty()) {
+      load_compiled(read_compiled(compiled_filepath));
+      check_license(compiled_filepath);
+    } else {
+      auto doc = ReaderDocument::from_file(filepath);
+      load(doc);
+    }
+  } catch(std::exception& e) {
+    std::stringstream msg;
+    msg << "Problem when reading level '" << filepath << "': " << e.what();
+    throw std::runtime_error(msg.str());
+  }
+}
+
+void
+LevelParser::load_document(const ReaderDocument& doc)
+{
+  const std::string filepath = doc.get_filename();
+  m_level.m_filename = filepath;
+  register_translation_directory(filepath);
+  try {
     load(doc);
   } catch(std::exception& e) {
     std::stringstream msg;
@@ -143,6 +187,44 @@ LevelParser::load(const std::string& filepath)
   }
 }
 
+void
+LevelParser::load_with_prototype(const std::string& filepath, const ReaderDocument* doc,
+                                 std::unique_ptr<CompiledLevel>& prototype)
+{
+  prototype.reset();
+  m_level.m_filename = doc ? doc->get_filename() : filepath;
+  register_translation_directory(m_level.m_filename);
+
+  std::unique_ptr<ReaderDocument> file_doc;
+  try {
+    if (!doc) {
+      const std::string compiled_filepath = CompiledLevel::find(filepath);
+      if (!compiled_filepath.empty()) {
+        auto compiled = std::make_unique<CompiledLevel>(read_compiled(compiled_filepath));
+        load_compiled(*compiled);
+        check_license(compiled_filepath);
+        prototype = std::move(compiled);
+        return;
+      }
+
+      file_doc = std::make_unique<ReaderDocument>(ReaderDocument::from_file(filepath));
+      doc = file_doc.get();
+    }
+    load(*doc);
+  } catch(std::exception& e) {
+    std::stringstream msg;
+    msg << "Problem when reading level '" << m_level.m_filename << "': " << e.what();
+    throw std::runtime_error(msg.str());
+  }
+
+  try {
+    prototype = std::make_unique<CompiledLevel>(CompiledLevel::from_document(*doc, m_level));
+  } catch(std::exception& e) {
+    log_debug << "[" << m_level.m_filename << "] level is read from its file again on restart: "
+              << e.what() << std::endl;
+  }
+}
+
 void
 LevelParser::load(const ReaderDocument& doc)
 {
@@ -159,15 +241,7 @@ LevelParser::load(const ReaderDocument& doc)
     log_info << "[" << doc.get_filename() << "] level uses old format: version 1" << std::endl;
     load_old_format(level);
   } else if (version == 2 || version == 3) {
-    level.get("tileset", m_level.m_tileset);
-
-    level.get("name", m_level.m_name);
-    level.get("author", m_level.m_author);
-    level.get("contact", m_level.m_contact);
-    level.get("license", m_level.m_license);
-    level.get("target-time", m_level.m_target_time);
-    level.get("suppress-pause-menu", m_level.m_suppress_pause_menu);
-    level.get("note", m_level.m_note);
+    load_properties(level);
 
     auto iter = level.get_iter();
     while (iter.next()) {
@@ -177,12 +251,7 @@ LevelParser::load(const ReaderDocument& doc)
       }
     }
 
-    if (m_level.m_license.empty()) {
-      log_warning << "[" <<  doc.get_filename() << "] The level author \"" << m_level.m_author
-                  << "\" did not specify a license for this level \""
-                  << m_level.m_name << "\". You might not be allowed to share it."
-                  << std::endl;
-    }
+    check_license(doc.get_filename());
   } else {
     log_warning << "[" << doc.get_filename() << "] level format version " << version << " is not supported" << std::endl;
   }
@@ -190,6 +259,60 @@ LevelParser::load(const ReaderDocument& doc)
   m_level.m_stats.init(m_level);
 }
 
+CompiledLevel
+LevelParser::read_compiled(const std::string& filepath)
+{
+  log_debug << "LevelParser::read_compiled: " << filepath << std::endl;
+
+  IFileStream in(filepath);
+  if (!in.good()) {
+    throw std::runtime_error("Couldn't open file '" + filepath + "'.");
+  }
+  return CompiledLevel::from_stream(in);
+}
+
+void
+LevelParser::load_compiled(CompiledLevel compiled)
+{
+  ReaderDocument doc(m_level.m_filename, std::move(compiled.m_header));
+  auto root = doc.get_root();
+  if (root.get_name() != "supertux-level")
+    throw std::runtime_error("file is not a supertux-level file.");
+
+  load_properties(root.get_mapping());
+
+  // Sectors are only parsed once Level::get_sector() asks for them, in a
+  // game session that is the start sector and the sectors entered later
+  m_level.m_deferred_sectors = std::move(compiled.m_sectors);
+
+  m_level.m_stats.init(m_level);
+}
+
+void
+LevelParser::load_properties(const ReaderMapping& level)
+{
+  level.get("tileset", m_level.m_tileset);
+
+  level.get("name", m_level.m_name);
+  level.get("author", m_level.m_author);
+  level.get("contact", m_level.m_contact);
+  level.get("license", m_level.m_license);
+  level.get("target-time", m_level.m_target_time);
+  level.get("suppress-pause-menu", m_level.m_suppress_pause_menu);
+  level.get("note", m_level.m_note);
+}
+
+void
+LevelParser::check_license(const std::string& filename) const
+{
+  if (m_level.m_license.empty()) {
+    log_warning << "[" <<  filename << "] The level author \"" << m_level.m_author
+                << "\" did not specify a license for this level \""
+                << m_level.m_name << "\". You might not be allowed to share it."
+                << std::endl;
+  }
+}
+
 void
 LevelParser::load_old_format(const ReaderMapping& reader)
 {
@@ -20,6 +20,7 @@
 #include <memory>
 #include <string>
 
+class CompiledLevel;
 class Level;
 class ReaderDocument;
 class ReaderMapping;
@@ -29,6 +30,18 @@ class LevelParser final
 public:
   static std::unique_ptr<Level> from_stream(std::istream& stream, const std::string& context, bool worldmap, bool editable);
   static std::unique_ptr<Level> from_file(const std::string& filename, bool worldmap, bool editable);
+  static std::unique_ptr<Level> from_document(const ReaderDocument& doc, bool worldmap, bool editable);
+
+  /** Loads a level to be played, like from_file(), or like
+      from_document() if doc isn't null. prototype is set to a copy of the
+      level in its compiled form that from_prototype() can rebuild the
+      level from, or to null for levels in the old format. */
+  static std::unique_ptr<Level> from_file_with_prototype(const std::string& filename, const ReaderDocument* doc,
+                                                         std::unique_ptr<CompiledLevel>& prototype);
+
+  /** Rebuilds a level without reading or parsing its file again, the
+      sectors are only decoded once they are entered */
+  static std::unique_ptr<Level> from_prototype(const CompiledLevel& prototype, const std::string& filename);
   static std::unique_ptr<Level> from_nothing(const std::string& basedir);
   static std::unique_ptr<Level> from_nothing_worldmap(const std::string& basedir, const std::string& name);
 
@@ -40,6 +53,13 @@ private:
   void load(const ReaderDocument& doc);
   void load(std::istream& stream, const std::string& context);
   void load(const std::string& filepath);
+  void load_document(const ReaderDocument& doc);
+  void load_with_prototype(const std::string& filepath, const ReaderDocument* doc,
+                           std::unique_ptr<CompiledLevel>& prototype);
+  static CompiledLevel read_compiled(const std::string& filepath);
+  void load_compiled(CompiledLevel compiled);
+  void load_properties(const ReaderMapping& level);
+  void check_license(const std::string& filename) const;
   void load_old_format(const ReaderMapping& reader);
   void create(const std::string& filepath, const std::string& levelname);
 
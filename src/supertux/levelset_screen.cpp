@@ -20,6 +20,7 @@
 #include "sdk/integration.hpp"
 #include "supertux/game_session.hpp"
 #include "supertux/level.hpp"
+#include "supertux/level_loading_screen.hpp"
 #include "supertux/levelset.hpp"
 #include "supertux/savegame.hpp"
 #include "supertux/screen_fade.hpp"
@@ -83,14 +84,15 @@ LevelsetScreen::setup()
     if (Editor::is_active()) {
       log_warning << "Editor is still active, quiting Levelset screen" << std::endl;
       ScreenManager::current()->pop_screen();
-    } else {
+    } else if (m_start_pos) {
       auto screen = std::make_unique<GameSession>(FileSystem::join(m_basedir, m_level_filename),
                                                   m_savegame);
-      if (m_start_pos) {
-        screen->set_start_pos(m_start_pos->first, m_start_pos->second);
-        screen->restart_level();
-      }
+      screen->set_start_pos(m_start_pos->first, m_start_pos->second);
+      screen->restart_level();
       ScreenManager::current()->push_screen(std::move(screen));
+    } else {
+      ScreenManager::current()->push_screen(std::make_unique<LevelLoadingScreen>(FileSystem::join(m_basedir, m_level_filename),
+                                                                                 m_savegame));
     }
   }
 }
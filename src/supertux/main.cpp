@@ -19,6 +19,8 @@
 #include <config.h>
 #include <version.h>
 #include <fstream>
+#include <iterator>
+#include <sstream>
 
 #include <SDL_image.h>
 #include <SDL_ttf.h>
@@ -53,7 +55,9 @@ extern "C" {
 #include "sdk/integration.hpp"
 #include "sprite/sprite_data.hpp"
 #include "sprite/sprite_manager.hpp"
+#include "supertux/benchmark.hpp"
 #include "supertux/command_line_arguments.hpp"
+#include "supertux/compiled_level.hpp"
 #include "supertux/console.hpp"
 #include "supertux/error_handler.hpp"
 #include "supertux/game_manager.hpp"
@@ -74,6 +78,7 @@ extern "C" {
 #include "supertux/world.hpp"
 #include "util/file_system.hpp"
 #include "util/gettext.hpp"
+#include "util/reader_document.hpp"
 #include "util/string_util.hpp"
 #include "util/timelog.hpp"
 #include "util/string_util.hpp"
@@ -128,6 +133,7 @@ Main::Main() :
   m_squirrel_virtual_machine(),
   m_tile_manager(),
   m_sprite_manager(),
+  m_level_metadata_index(),
   m_resources(),
 #ifndef __EMSCRIPTEN__
   m_addon_manager(),
@@ -408,6 +414,47 @@ Main::resave(const std::string& input_filename, const std::string& output_filena
   Editor::s_resaving_in_progress = false;
 }
 
+void
+Main::compile_level(const std::string& input_filename, const std::string& output_filename)
+{
+  if (!StringUtil::has_suffix(input_filename, ".stl")) {
+    log_warning << input_filename << ": only levels can be compiled" << std::endl;
+    return;
+  }
+
+  std::ifstream in(input_filename, std::ios::binary);
+  if (!in) {
+    log_fatal << input_filename << ": couldn't open file for reading" << std::endl;
+    return;
+  }
+
+  try {
+    log_info << "compiling level: " << input_filename << std::endl;
+    const std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+
+    std::istringstream text_in(text);
+    auto doc = ReaderDocument::from_stream(text_in, input_filename);
+
+    // The level is loaded as in a game to count what the statistics need
+    // from each sector
+    auto level = LevelParser::from_document(doc, false, false);
+    auto compiled = CompiledLevel::from_document(doc, *level);
+    compiled.m_source_stamp = FileStamp(text.size(), boost::filesystem::last_write_time(input_filename));
+    compiled.m_source_hash = CompiledLevel::hash_source(text.data(), text.size());
+
+    std::ofstream out(output_filename, std::ios::binary);
+    if (!out) {
+      log_fatal << output_filename << ": couldn't open file for writing" << std::endl;
+    } else {
+      log_info << "saving compiled level: " << output_filename << std::endl;
+      compiled.write(out);
+    }
+  } catch(const std::exception& e) {
+    log_fatal << input_filename << ": couldn't compile level: " << e.what() << std::endl;
+  }
+}
+
 void
 Main::launch_game(const CommandLineArguments& args)
 {
@@ -419,8 +466,12 @@ Main::launch_game(const CommandLineArguments& args)
 
   s_timelog.log("commandline");
 
+  const bool benchmark = static_cast<bool>(args.benchmark_demo);
+
   auto video = g_config->video;
-  if (args.resave && *args.resave) {
+  if (benchmark) {
+    video = VideoSystem::VIDEO_NULL;
+  } else if ((args.resave && *args.resave) || (args.compile_level && *args.compile_level)) {
     if (args.video) {
       video = *args.video;
     } else {
@@ -435,8 +486,8 @@ Main::launch_game(const CommandLineArguments& args)
 
   s_timelog.log("audio");
   m_sound_manager.reset(new SoundManager());
-  m_sound_manager->enable_sound(g_config->sound_enabled);
-  m_sound_manager->enable_music(g_config->music_enabled);
+  m_sound_manager->enable_sound(g_config->sound_enabled && !benchmark);
+  m_sound_manager->enable_music(g_config->music_enabled && !benchmark);
   m_sound_manager->set_sound_volume(g_config->sound_volume);
   m_sound_manager->set_music_volume(g_config->music_volume);
 
@@ -446,6 +497,7 @@ Main::launch_game(const CommandLineArguments& args)
   s_timelog.log("resources");
   m_tile_manager.reset(new TileManager());
   m_sprite_manager.reset(new SpriteManager());
+  m_level_metadata_index.reset(new LevelMetadataIndex());
   m_resources.reset(new Resources());
 
   s_timelog.log("integrations");
@@ -465,6 +517,8 @@ Main::launch_game(const CommandLineArguments& args)
   m_game_manager.reset(new GameManager());
   m_screen_manager.reset(new ScreenManager(*m_video_system, *m_input_manager));
 
+  std::unique_ptr<Benchmark> benchmark_run;
+
   if (!args.filenames.empty())
   {
     for(const auto& start_level : args.filenames)
@@ -485,6 +539,10 @@ Main::launch_game(const CommandLineArguments& args)
       {
         resave(start_level, start_level);
       }
+      else if (args.compile_level && *args.compile_level)
+      {
+        compile_level(start_level, CompiledLevel::get_filename(start_level));
+      }
       else if (args.editor)
       {
         if (PHYSFS_exists(start_level.c_str())) {
@@ -509,7 +567,8 @@ Main::launch_game(const CommandLineArguments& args)
         std::unique_ptr<GameSession> session (
           new GameSession(filename, *m_savegame));
 
-        g_config->random_seed = session->get_demo_random_seed(g_config->start_demo);
+        const std::string& demo = benchmark ? *args.benchmark_demo : g_config->start_demo;
+        g_config->random_seed = session->get_demo_random_seed(demo);
         gameRandom.seed(g_config->random_seed);
         graphicsRandom.seed(0);
 
@@ -531,8 +590,11 @@ Main::launch_game(const CommandLineArguments& args)
           session->get_current_sector().get_player().set_pos(*g_config->tux_spawn_pos);
         }
 
-        if (!g_config->start_demo.empty())
-          session->play_demo(g_config->start_demo);
+        if (!demo.empty())
+          session->play_demo(demo);
+
+        if (benchmark)
+          benchmark_run.reset(new Benchmark(start_level, demo));
 
         if (!g_config->record_demo.empty())
           session->record_demo(g_config->record_demo);
@@ -560,6 +622,21 @@ Main::launch_game(const CommandLineArguments& args)
 #endif
 
   m_screen_manager->run();
+
+  if (benchmark_run)
+  {
+    if (args.benchmark_report)
+    {
+      std::ofstream out(*args.benchmark_report);
+      if (!out)
+        throw std::runtime_error("Couldn't open benchmark report '" + *args.benchmark_report + "' for writing");
+      benchmark_run->write_report(out);
+    }
+    else
+    {
+      benchmark_run->write_report(std::cout);
+    }
+  }
 }
 
 int
@@ -30,6 +30,7 @@
 #include "supertux/console.hpp"
 #include "supertux/game_manager.hpp"
 #include "supertux/gameconfig.hpp"
+#include "supertux/level_metadata_index.hpp"
 #include "supertux/player_status.hpp"
 #include "supertux/resources.hpp"
 #include "supertux/savegame.hpp"
@@ -86,6 +87,7 @@ private:
 
   void launch_game(const CommandLineArguments& args);
   void resave(const std::string& input_filename, const std::string& output_filename);
+  void compile_level(const std::string& input_filename, const std::string& output_filename);
 
 private:
   // Using pointers allows us to initialize them whenever we want
@@ -100,6 +102,7 @@ private:
   std::unique_ptr<SquirrelVirtualMachine> m_squirrel_virtual_machine;
   std::unique_ptr<TileManager> m_tile_manager;
   std::unique_ptr<SpriteManager> m_sprite_manager;
+  std::unique_ptr<LevelMetadataIndex> m_level_metadata_index;
   std::unique_ptr<Resources> m_resources;
 #ifndef __EMSCRIPTEN__
   std::unique_ptr<AddonManager> m_addon_manager;
@@ -17,13 +17,18 @@
 #include "supertux/menu/debug_menu.hpp"
 
 #include <algorithm>
+#include <fstream>
+#include <physfs.h>
 #include <sstream>
 
 #include "gui/item_stringselect.hpp"
 #include "supertux/debug.hpp"
 #include "supertux/gameconfig.hpp"
 #include "supertux/globals.hpp"
+#include "util/file_system.hpp"
 #include "util/gettext.hpp"
+#include "util/log.hpp"
+#include "util/profiler.hpp"
 #include "video/texture_manager.hpp"
 
 DebugMenu::DebugMenu() :
@@ -65,10 +70,34 @@ DebugMenu::DebugMenu() :
   add_toggle(-1, _("Show Controller"), &g_config->show_controller);
   add_toggle(-1, _("Show Framerate"), &g_config->show_fps);
   add_toggle(-1, _("Draw Redundant Frames"), &g_debug.draw_redundant_frames);
+  add_toggle(-1, _("Use Collision Broadphase"), &g_debug.use_collision_broadphase);
   add_toggle(-1, _("Show Player Position"), &g_config->show_player_pos);
   add_toggle(-1, _("Use Bitmap Fonts"),
              []{ return g_debug.get_use_bitmap_fonts(); },
              [](bool value){ g_debug.set_use_bitmap_fonts(value); });
+  add_toggle(-1, _("Show Profiler"),
+             []{ return g_profiler.get_show_overlay(); },
+             [](bool value){ g_profiler.set_show_overlay(value); });
+  add_toggle(-1, _("Record Profiler Trace"),
+             []{ return g_profiler.is_tracing(); },
+             [](bool value){
+               if (value)
+               {
+                 g_profiler.start_trace();
+                 return;
+               }
+
+               g_profiler.stop_trace();
+               const std::string filename = FileSystem::join(PHYSFS_getWriteDir(), "profile-trace.json");
+               std::ofstream out(filename);
+               if (!out)
+               {
+                 log_warning << "Couldn't open " << filename << " for writing" << std::endl;
+                 return;
+               }
+               g_profiler.write_trace(out);
+               log_info << "Profiler trace written to " << filename << std::endl;
+             });
   add_entry(_("Dump Texture Cache"), []{ TextureManager::current()->debug_print(std::cout); });
 
   add_hl();
@@ -92,6 +92,19 @@ public:
     return &m_col;
   }
 
+  /** Objects are not drawn while their bbox, grown by this margin, is out
+      of view; objects whose graphics overhang their bbox need a larger one. */
+  virtual float get_draw_margin() const { return 32.0f; }
+
+  /** Objects that draw far from their bbox (lights, HUD elements...) return
+      true, so that they are drawn even when they are out of view. */
+  virtual bool draws_outside_bbox() const { return false; }
+
+  /** Called instead of draw() while the object is out of view. Sprite
+      animations only advance while being drawn, so objects whose logic
+      waits for an animation to finish must advance their sprites here. */
+  virtual void skip_draw() {}
+
   virtual std::string get_class() const override { return "moving-object"; }
   virtual ObjectSettings get_settings() override;
 
@@ -17,12 +17,19 @@
 
 #include "supertux/object_factory.hpp"
 
+#include <algorithm>
+#include <assert.h>
 #include <sstream>
 
+#include "math/vector.hpp"
 #include "supertux/game_object.hpp"
+#include "util/reader_mapping.hpp"
+
+const size_t ObjectFactory::MAX_PROTOTYPES = 256;
 
 ObjectFactory::ObjectFactory() :
-  factories()
+  factories(),
+  m_prototypes()
 {
 }
 
@@ -43,4 +50,76 @@ ObjectFactory::create(const std::string& name, const ReaderMapping& reader) cons
   }
 }
 
+std::unique_ptr<GameObject>
+ObjectFactory::create(const std::string& name, const Vector& pos, const Direction& dir, const std::string& data) const
+{
+  const PrototypeKey key(name, dir, data);
+  auto it = m_prototypes.find(key);
+  if (it == m_prototypes.end())
+  {
+    if (m_prototypes.size() >= MAX_PROTOTYPES)
+    {
+      // prototypes in use are still referenced further up the stack
+      for (auto p = m_prototypes.begin(); p != m_prototypes.end();)
+      {
+        if (p->second.in_use)
+          ++p;
+        else
+          p = m_prototypes.erase(p);
+      }
+    }
+
+    std::stringstream lisptext;
+    lisptext << "(" << name << "\n"
+             << " (x 0)"
+             << " (y 0)" << data;
+    if (dir != Direction::AUTO) {
+      lisptext << " (direction \"" << dir << "\"))";
+    } else {
+      lisptext << ")";
+    }
+
+    auto doc = ReaderDocument::from_stream(lisptext);
+    it = m_prototypes.emplace(key, Prototype(doc.get_sexp())).first;
+  }
+
+  Prototype& prototype = it->second;
+  if (prototype.in_use)
+  {
+    // Called from the constructor of an object created from the same
+    // prototype, don't touch the position it may still be reading
+    sexp::Value sx = prototype.sx;
+    sx.as_array()[1].as_array()[1] = sexp::Value::real(pos.x);
+    sx.as_array()[2].as_array()[1] = sexp::Value::real(pos.y);
+    return create(name, ReaderMapping(prototype.doc, sx));
+  }
+
+  // (name (x 0) (y 0) ...), fill in the position
+  prototype.sx.as_array()[1].as_array()[1] = sexp::Value::real(pos.x);
+  prototype.sx.as_array()[2].as_array()[1] = sexp::Value::real(pos.y);
+
+  prototype.in_use = true;
+  try
+  {
+    auto object = create(name, ReaderMapping(prototype.doc, prototype.sx));
+    prototype.in_use = false;
+    return object;
+  }
+  catch(...)
+  {
+    prototype.in_use = false;
+    throw;
+  }
+}
+
+void
+ObjectFactory::clear_prototypes()
+{
+  assert(std::none_of(m_prototypes.begin(), m_prototypes.end(),
+                      [](const std::pair<const PrototypeKey, Prototype>& p) {
+                        return p.second.in_use;
+                      }));
+  m_prototypes.clear();
+}
+
 /* EOF */
@@ -22,9 +22,13 @@
 #include <map>
 #include <memory>
 #include <functional>
+#include <tuple>
+
+#include <sexp/value.hpp>
 
 #include "math/fwd.hpp"
 #include "supertux/direction.hpp"
+#include "util/reader_document.hpp"
 
 class ReaderMapping;
 class GameObject;
@@ -36,10 +40,46 @@ private:
   typedef std::map<std::string, FactoryFunction> Factories;
   Factories factories;
 
+  /** Parsed description of objects spawned by create(name, pos, ...),
+      only the position is filled in for each new object */
+  struct Prototype
+  {
+    Prototype(sexp::Value sx_) :
+      doc("<prototype>", sexp::Value()),
+      sx(std::move(sx_)),
+      in_use(false)
+    {}
+
+    ReaderDocument doc;
+    sexp::Value sx;
+
+    /** Set while an object is constructed from it, in case that
+        object spawns another one of the same kind */
+    bool in_use;
+  };
+  typedef std::tuple<std::string, Direction, std::string> PrototypeKey;
+  mutable std::map<PrototypeKey, Prototype> m_prototypes;
+
+  /** The prototypes that aren't in use are forgotten when there are
+      more than this, dispensers and the editor can create many */
+  static const size_t MAX_PROTOTYPES;
+
 public:
   /** Will throw in case of creation failure, will never return nullptr */
   std::unique_ptr<GameObject> create(const std::string& name, const ReaderMapping& reader) const;
 
+  /** Creates an object of class name at pos, data holds further
+      properties in s-expression syntax. Each combination of name,
+      dir and data is only parsed once. */
+  std::unique_ptr<GameObject> create(const std::string& name,
+                                     const Vector& pos, const Direction& dir = Direction::AUTO,
+                                     const std::string& data = {}) const;
+
+  /** Forgets the cached prototypes, called when a new level is loaded */
+  void clear_prototypes();
+
+  size_t get_prototype_count() const { return m_prototypes.size(); }
+
 protected:
   ObjectFactory();
 
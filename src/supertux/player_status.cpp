@@ -86,9 +86,9 @@ PlayerStatus::add_coins(int count, bool play_sound)
 
   static float sound_played_time = 0;
   if (count >= 100)
-    SoundManager::current()->play("sounds/lifeup.wav");
+    SoundManager::current()->play("sounds/lifeup.wav", 0.5f, SoundManager::PRIORITY_HIGH);
   else if (g_real_time > sound_played_time + 0.010f) {
-    SoundManager::current()->play("sounds/coin.wav");
+    SoundManager::current()->play("sounds/coin.wav", 0.5f, SoundManager::PRIORITY_LOW);
     sound_played_time = g_real_time;
   }
 }
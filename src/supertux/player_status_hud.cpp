@@ -81,13 +81,13 @@ PlayerStatusHUD::draw(DrawingContext& context)
                                   LAYER_HUD);
     }
 
-    context.color().draw_text(Resources::fixed_font,
-                              coins_text,
-                              Vector(static_cast<float>(context.get_width()) - BORDER_X - Resources::fixed_font->get_text_width(coins_text),
-                                    BORDER_Y + (Resources::fixed_font->get_text_height(coins_text) + 5.0f) * static_cast<float>(player_id)),
-                              ALIGN_LEFT,
-                              LAYER_HUD,
-                              PlayerStatusHUD::text_color);
+    context.color().draw_dynamic_text(Resources::fixed_font,
+                                      coins_text,
+                                      Vector(static_cast<float>(context.get_width()) - BORDER_X - Resources::fixed_font->get_text_width(coins_text),
+                                            BORDER_Y + (Resources::fixed_font->get_text_height(coins_text) + 5.0f) * static_cast<float>(player_id)),
+                                      ALIGN_LEFT,
+                                      LAYER_HUD,
+                                      PlayerStatusHUD::text_color);
   }
   std::string ammo_text;
 
@@ -109,18 +109,18 @@ PlayerStatusHUD::draw(DrawingContext& context)
                                    LAYER_HUD);
     }
 
-    context.color().draw_text(Resources::fixed_font,
-                              ammo_text,
-                              Vector(static_cast<float>(context.get_width())
-                                         - BORDER_X
-                                         - Resources::fixed_font->get_text_width(ammo_text),
-                                     BORDER_Y
-                                         + (Resources::fixed_font->get_text_height(coins_text) + 5.0f)
-                                         + (Resources::fixed_font->get_text_height(ammo_text) + 5.0f)
-                                         * static_cast<float>(player_id)),
-                              ALIGN_LEFT,
-                              LAYER_HUD,
-                              PlayerStatusHUD::text_color);
+    context.color().draw_dynamic_text(Resources::fixed_font,
+                                      ammo_text,
+                                      Vector(static_cast<float>(context.get_width())
+                                                 - BORDER_X
+                                                 - Resources::fixed_font->get_text_width(ammo_text),
+                                             BORDER_Y
+                                                 + (Resources::fixed_font->get_text_height(coins_text) + 5.0f)
+                                                 + (Resources::fixed_font->get_text_height(ammo_text) + 5.0f)
+                                                 * static_cast<float>(player_id)),
+                                      ALIGN_LEFT,
+                                      LAYER_HUD,
+                                      PlayerStatusHUD::text_color);
   }
 
   if (m_player_status.bonus == ICE_BONUS) {
@@ -141,18 +141,18 @@ PlayerStatusHUD::draw(DrawingContext& context)
                                    LAYER_HUD);
     }
 
-    context.color().draw_text(Resources::fixed_font,
-                              ammo_text,
-                              Vector(static_cast<float>(context.get_width())
-                                         - BORDER_X
-                                         - Resources::fixed_font->get_text_width(ammo_text),
-                                     BORDER_Y
-                                         + (Resources::fixed_font->get_text_height(coins_text) + 5.0f)
-                                         + (Resources::fixed_font->get_text_height(ammo_text) + 5.0f)
-                                         * static_cast<float>(player_id)),
-                              ALIGN_LEFT,
-                              LAYER_HUD,
-                              PlayerStatusHUD::text_color);
+    context.color().draw_dynamic_text(Resources::fixed_font,
+                                      ammo_text,
+                                      Vector(static_cast<float>(context.get_width())
+                                                 - BORDER_X
+                                                 - Resources::fixed_font->get_text_width(ammo_text),
+                                             BORDER_Y
+                                                 + (Resources::fixed_font->get_text_height(coins_text) + 5.0f)
+                                                 + (Resources::fixed_font->get_text_height(ammo_text) + 5.0f)
+                                                 * static_cast<float>(player_id)),
+                                      ALIGN_LEFT,
+                                      LAYER_HUD,
+                                      PlayerStatusHUD::text_color);
   }
 
 
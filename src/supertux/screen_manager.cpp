@@ -27,6 +27,7 @@
 #include "object/player.hpp"
 #include "sdk/integration.hpp"
 #include "squirrel/squirrel_virtual_machine.hpp"
+#include "supertux/benchmark.hpp"
 #include "supertux/console.hpp"
 #include "supertux/constants.hpp"
 #include "supertux/controller_hud.hpp"
@@ -39,7 +40,9 @@
 #include "supertux/resources.hpp"
 #include "supertux/screen_fade.hpp"
 #include "supertux/sector.hpp"
+#include "util/allocation_counter.hpp"
 #include "util/log.hpp"
+#include "util/profiler.hpp"
 #include "video/compositor.hpp"
 #include "video/drawing_context.hpp"
 
@@ -62,6 +65,9 @@ struct ScreenManager::FPS_Stats
     last_fps(0),
     last_fps_min(0),
     last_fps_max(0),
+    acc_allocations(0),
+    last_allocations(0),
+    allocations_prev(AllocationCounter::get_count()),
     // Use chrono instead of SDL_GetTicks for more precise FPS measurement
     time_prev(std::chrono::steady_clock::now())
   {
@@ -84,6 +90,10 @@ struct ScreenManager::FPS_Stats
     if (max_us < dtime_us)
       max_us = dtime_us;
 
+    const uint64_t allocations_now = AllocationCounter::get_count();
+    acc_allocations += allocations_now - allocations_prev;
+    allocations_prev = allocations_now;
+
     float expired_seconds = static_cast<float>(acc_us) / 1000000.0f;
     if (expired_seconds < 0.5f)
       return;
@@ -97,7 +107,9 @@ struct ScreenManager::FPS_Stats
     assert(min_us > 0);  // initialization to 1000000 and dtime_us > 0.
     last_fps_max = 1000000.0f / static_cast<float>(min_us);
     assert(last_fps_max > 0);  // min_us > 0.
+    last_allocations = static_cast<int>(acc_allocations / static_cast<uint64_t>(measurements_cnt));
     measurements_cnt = 0;
+    acc_allocations = 0;
     acc_us = 0;
     min_us = 1000000;
     max_us = 0;
@@ -107,6 +119,9 @@ struct ScreenManager::FPS_Stats
   float get_fps_min() const { return last_fps_min; }
   float get_fps_max() const { return last_fps_max; }
 
+  // Average number of heap allocations per frame in the previous 0.5 s
+  int get_allocations() const { return last_allocations; }
+
   // This returns the highest measured delay between two frames from the
   // previous and current 0.5 s measuring intervals
   float get_highest_max_ms() const
@@ -127,6 +142,9 @@ private:
   float last_fps;
   float last_fps_min;
   float last_fps_max;
+  uint64_t acc_allocations;
+  int last_allocations;
+  uint64_t allocations_prev;
   std::chrono::steady_clock::time_point time_prev;
 };
 
@@ -144,6 +162,7 @@ ScreenManager::ScreenManager(VideoSystem& video_system, InputManager& input_mana
   ms_per_step(static_cast<Uint32>(1000.0f / LOGICAL_FPS)),
   seconds_per_step(static_cast<float>(ms_per_step) / 1000.0f),
   m_fps_statistics(new FPS_Stats()),
+  m_compositor(new Compositor(video_system)),
   m_speed(1.0),
   m_actions(),
   m_screen_fade(),
@@ -235,16 +254,80 @@ ScreenManager::draw_fps(DrawingContext& context, FPS_Stats& fps_statistics)
   snprintf(str3, str_length, "%3.1f",
     static_cast<double>(fps_statistics.get_fps_max()));
   pos.y += 15;
-  context.color().draw_text(Resources::small_font, str3,
+  context.color().draw_dynamic_text(Resources::small_font, str3,
     pos, ALIGN_RIGHT, LAYER_HUD);
   pos.x -= w3;
-  context.color().draw_text(Resources::small_font, str2,
+  context.color().draw_dynamic_text(Resources::small_font, str2,
     pos, ALIGN_RIGHT, LAYER_HUD);
   pos.x -= w2;
-  context.color().draw_text(Resources::small_font, str1,
+  context.color().draw_dynamic_text(Resources::small_font, str1,
+    pos, ALIGN_RIGHT, LAYER_HUD);
+
+  const auto voices = SoundManager::current()->get_voice_stats();
+  snprintf(str1, str_length, "Voices %d / %d", voices.active, voices.pool_size);
+  snprintf(str2, str_length, "steals %d  drops %d  merged %d",
+    voices.steals, voices.drops, voices.merged);
+  pos.x = static_cast<float>(context.get_width()) - BORDER_X;
+  pos.y += 15;
+  context.color().draw_dynamic_text(Resources::small_font, str1,
+    pos, ALIGN_RIGHT, LAYER_HUD);
+  pos.y += 15;
+  context.color().draw_dynamic_text(Resources::small_font, str2,
+    pos, ALIGN_RIGHT, LAYER_HUD);
+
+  snprintf(str1, str_length, "Allocations %d / frame",
+    fps_statistics.get_allocations());
+  pos.y += 15;
+  context.color().draw_dynamic_text(Resources::small_font, str1,
     pos, ALIGN_RIGHT, LAYER_HUD);
 }
 
+void
+ScreenManager::draw_profiler(DrawingContext& context)
+{
+  const auto& zones = g_profiler.get_slowest_frame();
+
+  Vector pos(BORDER_X, BORDER_Y + 50);
+  context.color().draw_text(Resources::small_font,
+    "Profiler, slowest of " + std::to_string(Profiler::FRAME_WINDOW) + " frames  (calls / ms)",
+    pos, ALIGN_LEFT, LAYER_HUD);
+
+  static const float indent = Resources::small_font->get_text_width("  ");
+  static const float w_time = Resources::small_font->get_text_width("9999.99");
+  static const float w_calls = Resources::small_font->get_text_width("99999 / ");
+  static const float w_name = Resources::small_font->get_text_width("ScreenManager::update_gamelogic") + indent * 6;
+
+  // Walk the zone tree depth-first
+  std::vector<int> stack;
+  if (!zones.empty())
+    stack.push_back(0);
+
+  while (!stack.empty())
+  {
+    const auto& zone = zones[stack.back()];
+    stack.pop_back();
+
+    if (zone.next_sibling >= 0)
+      stack.push_back(zone.next_sibling);
+    if (zone.first_child >= 0)
+      stack.push_back(zone.first_child);
+
+    char calls[32];
+    char time[32];
+    snprintf(calls, sizeof(calls), "%d /", zone.calls);
+    snprintf(time, sizeof(time), "%.2f", zone.time_ms);
+
+    pos.y += 15;
+    const float x = BORDER_X + indent * static_cast<float>(zone.depth);
+    context.color().draw_text(Resources::small_font, zone.name,
+      Vector(x, pos.y), ALIGN_LEFT, LAYER_HUD);
+    context.color().draw_dynamic_text(Resources::small_font, calls,
+      Vector(BORDER_X + w_name + w_calls, pos.y), ALIGN_RIGHT, LAYER_HUD);
+    context.color().draw_dynamic_text(Resources::small_font, time,
+      Vector(BORDER_X + w_name + w_calls + w_time, pos.y), ALIGN_RIGHT, LAYER_HUD);
+  }
+}
+
 void
 ScreenManager::draw_player_pos(DrawingContext& context)
 {
@@ -254,7 +337,7 @@ ScreenManager::draw_player_pos(DrawingContext& context)
     auto pos = sector.get_player().get_pos();
     auto pos_text = "X:" + std::to_string(int(pos.x)) + " Y:" + std::to_string(int(pos.y));
 
-    context.color().draw_text(
+    context.color().draw_dynamic_text(
       Resources::small_font, pos_text,
       Vector(static_cast<float>(context.get_width()) - Resources::small_font->get_text_width("99999x99999") - BORDER_X,
              BORDER_Y + 60), ALIGN_LEFT, LAYER_HUD);
@@ -266,6 +349,8 @@ ScreenManager::draw(Compositor& compositor, FPS_Stats& fps_statistics)
 {
   assert(!m_screen_stack.empty());
 
+  ProfileZone profile_zone("ScreenManager::draw");
+
   // draw the actual screen
   m_screen_stack.back()->draw(compositor);
 
@@ -286,6 +371,9 @@ ScreenManager::draw(Compositor& compositor, FPS_Stats& fps_statistics)
   if (g_config->show_fps)
     draw_fps(context, fps_statistics);
 
+  if (g_profiler.get_show_overlay())
+    draw_profiler(context);
+
   if (g_config->show_controller) {
     m_controller_hud->draw(context);
   }
@@ -301,6 +389,8 @@ ScreenManager::draw(Compositor& compositor, FPS_Stats& fps_statistics)
 void
 ScreenManager::update_gamelogic(float dt_sec)
 {
+  ProfileZone profile_zone("ScreenManager::update_gamelogic");
+
   Controller& controller = m_input_manager.get_controller();
 
 #ifdef ENABLE_TOUCHSCREEN_SUPPORT
@@ -536,6 +626,13 @@ ScreenManager::handle_screen_switch()
 
 void ScreenManager::loop_iter()
 {
+  log_flush_thread_messages();
+
+  if (Benchmark::current()) {
+    benchmark_iter(*Benchmark::current());
+    return;
+  }
+
   // Useful if screens edit their status without switching screens
   Integration::update_status_all(m_screen_stack.back()->get_status());
   Integration::update_all();
@@ -558,6 +655,8 @@ void ScreenManager::loop_iter()
     return;
   }
 
+  ProfileZone profile_zone("ScreenManager::loop_iter");
+
   g_real_time = static_cast<float>(ticks) / 1000.0f;
 
   float speed_multiplier = g_debug.get_game_speed_multiplier();
@@ -601,8 +700,8 @@ void ScreenManager::loop_iter()
   if ((steps > 0 && !m_screen_stack.empty())
       || g_debug.draw_redundant_frames) {
     // Draw a frame
-    Compositor compositor(m_video_system);
-    draw(compositor, *m_fps_statistics);
+    m_compositor->start_frame();
+    draw(*m_compositor, *m_fps_statistics);
     m_fps_statistics->report_frame();
   }
 
@@ -618,6 +717,39 @@ static void g_loop_iter() {
 }
 #endif
 
+void
+ScreenManager::benchmark_iter(Benchmark& benchmark)
+{
+  ProfileZone profile_zone("ScreenManager::loop_iter");
+
+  // Run exactly one logical step and one frame per iteration, as fast as
+  // possible; the real time follows the game time so that the replay is
+  // deterministic
+  g_game_time += seconds_per_step;
+  g_real_time = g_game_time;
+
+  auto time_start = std::chrono::steady_clock::now();
+  process_events();
+  update_gamelogic(seconds_per_step);
+  auto time_updated = std::chrono::steady_clock::now();
+
+  if (!m_screen_stack.empty()) {
+    m_compositor->start_frame();
+    draw(*m_compositor, *m_fps_statistics);
+    m_fps_statistics->report_frame();
+  }
+  auto time_drawn = std::chrono::steady_clock::now();
+
+  benchmark.add_frame(
+    std::chrono::duration<double, std::milli>(time_updated - time_start).count(),
+    std::chrono::duration<double, std::milli>(time_drawn - time_updated).count());
+
+  if (benchmark.is_finished() && !m_screen_stack.empty())
+    quit();
+
+  handle_screen_switch();
+}
+
 void
 ScreenManager::run()
 {
@@ -28,6 +28,7 @@
 #include "supertux/screen.hpp"
 #include "util/currenton.hpp"
 
+class Benchmark;
 class Compositor;
 class ControllerHUD;
 class DrawingContext;
@@ -63,10 +64,12 @@ private:
   struct FPS_Stats;
   void draw_fps(DrawingContext& context, FPS_Stats& fps_statistics);
   void draw_player_pos(DrawingContext& context);
+  void draw_profiler(DrawingContext& context);
   void draw(Compositor& compositor, FPS_Stats& fps_statistics);
   void update_gamelogic(float dt_sec);
   void process_events();
   void handle_screen_switch();
+  void benchmark_iter(Benchmark& benchmark);
 
 private:
   VideoSystem& m_video_system;
@@ -84,6 +87,9 @@ private:
   const float seconds_per_step;
   std::unique_ptr<FPS_Stats> m_fps_statistics;
 
+  /** Kept between frames, so that its memory can be reused */
+  std::unique_ptr<Compositor> m_compositor;
+
   float m_speed;
   struct Action
   {
@@ -45,6 +45,7 @@
 #include "physfs/ifile_stream.hpp"
 #include "scripting/sector.hpp"
 #include "squirrel/squirrel_environment.hpp"
+#include "supertux/activation_region.hpp"
 #include "supertux/colorscheme.hpp"
 #include "supertux/constants.hpp"
 #include "supertux/debug.hpp"
@@ -76,6 +77,7 @@ Sector::Sector(Level& parent) :
   m_foremost_layer(),
   m_squirrel_environment(new SquirrelEnvironment(SquirrelVirtualMachine::current()->get_vm(), "sector")),
   m_collision_system(new CollisionSystem(*this)),
+  m_activation_region(new ActivationRegion),
   m_gravity(10.0)
 {
   Savegame* savegame = (Editor::current() && Editor::is_active()) ?
@@ -334,6 +336,8 @@ Sector::update(float dt_sec)
 
   m_squirrel_environment->update(dt_sec);
 
+  m_activation_region->update(*this);
+
   GameObjectManager::update(dt_sec);
 
   /* Handle all possible collisions. */
@@ -385,10 +389,20 @@ Sector::before_object_remove(GameObject& object)
     m_collision_system->remove(moving_object->get_collision_object());
   }
 
+  if (auto badguy = dynamic_cast<BadGuy*>(&object)) {
+    m_activation_region->remove(*badguy);
+  }
+
   if (s_current == this)
     m_squirrel_environment->try_unexpose(object);
 }
 
+void
+Sector::after_objects_removed()
+{
+  m_collision_system->flush_removals();
+}
+
 void
 Sector::draw(DrawingContext& context)
 {
@@ -33,6 +33,7 @@ namespace collision {
 class Constraints;
 }
 
+class ActivationRegion;
 class Camera;
 class CollisionSystem;
 class CollisionGroundMovementManager;
@@ -143,18 +144,22 @@ public:
   void set_init_script(const std::string& init_script) {
     m_init_script = init_script;
   }
+  const std::string& get_init_script() const { return m_init_script; }
 
   void run_script(const std::string& script, const std::string& sourcename);
 
   Camera& get_camera() const;
   Player& get_player() const;
   DisplayEffect& get_effect() const;
+  CollisionSystem& get_collision_system() const { return *m_collision_system; }
+  ActivationRegion& get_activation_region() const { return *m_activation_region; }
 
 private:
   uint32_t collision_tile_attributes(const Rectf& dest, const Vector& mov) const;
 
   virtual bool before_object_add(GameObject& object) override;
   virtual void before_object_remove(GameObject& object) override;
+  virtual void after_objects_removed() override;
 
   int calculate_foremost_layer() const;
 
@@ -176,6 +181,7 @@ private:
 
   std::unique_ptr<SquirrelEnvironment> m_squirrel_environment;
   std::unique_ptr<CollisionSystem> m_collision_system;
+  std::unique_ptr<ActivationRegion> m_activation_region;
 
   float m_gravity;
 
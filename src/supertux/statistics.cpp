@@ -515,7 +515,7 @@ Statistics::check_coins()
   if (m_coins >= m_total_coins)
   {
     m_cleared_coins = true;
-    SoundManager::current()->play("/sounds/coins_cleared.ogg", 0.5f);
+    SoundManager::current()->play("/sounds/coins_cleared.ogg", 0.5f, SoundManager::PRIORITY_HIGH);
   }
 }
 
@@ -528,7 +528,7 @@ Statistics::check_badguys()
   if (m_badguys >= m_total_badguys)
   {
     m_cleared_badguys = true;
-    SoundManager::current()->play("/sounds/retro_fall.wav", 0.5f);
+    SoundManager::current()->play("/sounds/retro_fall.wav", 0.5f, SoundManager::PRIORITY_HIGH);
   }
 }
 
@@ -541,7 +541,7 @@ Statistics::check_secrets()
   if (m_secrets >= m_total_secrets)
   {
     m_cleared_secrets = true;
-    SoundManager::current()->play("/sounds/tada.ogg", 0.5f);
+    SoundManager::current()->play("/sounds/tada.ogg", 0.5f, SoundManager::PRIORITY_HIGH);
   }
 }
 
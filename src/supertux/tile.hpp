@@ -112,6 +112,9 @@ public:
   SurfacePtr get_current_surface() const;
   SurfacePtr get_current_editor_surface() const;
 
+  /** Returns true if the surface changes over time */
+  bool is_animated() const { return m_images.size() > 1 || m_editor_images.size() > 1; }
+
   uint32_t get_attributes() const { return m_attributes; }
   int get_data() const { return m_data; }
 
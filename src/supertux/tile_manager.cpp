@@ -42,4 +42,10 @@ TileManager::get_tileset(const std::string &filename)
   }
 }
 
+bool
+TileManager::has_tileset(const std::string &filename) const
+{
+  return m_tilesets.find(filename) != m_tilesets.end();
+}
+
 /* EOF */
@@ -34,6 +34,7 @@ public:
   TileManager();
 
   TileSet* get_tileset(const std::string &filename);
+  bool has_tileset(const std::string &filename) const;
 };
 
 #endif
@@ -40,6 +40,7 @@ TileSet::from_file(const std::string& filename)
 
   TileSetParser parser(*tileset, filename);
   parser.parse();
+  tileset->build_autotileset_index();
 
   tileset->print_debug_info(filename);
 
@@ -49,7 +50,8 @@ TileSet::from_file(const std::string& filename)
 TileSet::TileSet() :
   m_autotilesets(),
   m_tiles(1),
-  m_tilegroups()
+  m_tilegroups(),
+  m_autotileset_index()
 {
   m_tiles[0] = std::make_unique<Tile>();
   m_autotilesets = new std::vector<AutotileSet*>();
@@ -95,19 +97,35 @@ TileSet::get(const uint32_t id) const
 AutotileSet*
 TileSet::get_autotileset_from_tile(uint32_t tile_id) const
 {
-  if (tile_id == 0)
+  if (tile_id == 0 || tile_id >= m_autotileset_index.size())
   {
     return nullptr;
   }
 
+  return m_autotileset_index[tile_id];
+}
+
+void
+TileSet::build_autotileset_index()
+{
+  m_autotileset_index.clear();
+
   for (auto& ats : *m_autotilesets)
   {
-    if (ats->is_member(tile_id))
+    for (const auto& tile_id : ats->get_member_tiles())
     {
-      return ats;
+      if (tile_id >= m_autotileset_index.size())
+      {
+        m_autotileset_index.resize(tile_id + 1, nullptr);
+      }
+
+      // Tiles that are in several autotilesets belong to the first one
+      if (!m_autotileset_index[tile_id])
+      {
+        m_autotileset_index[tile_id] = ats;
+      }
     }
   }
-  return nullptr;
 }
 
 void
@@ -61,6 +61,10 @@ public:
   
   AutotileSet* get_autotileset_from_tile(uint32_t tile_id) const;
 
+  /** Indexes the autotilesets by tile id for get_autotileset_from_tile();
+      must be called again when autotilesets are added */
+  void build_autotileset_index();
+
   uint32_t get_max_tileid() const {
     return static_cast<uint32_t>(m_tiles.size());
   }
@@ -79,6 +83,9 @@ private:
   std::vector<std::unique_ptr<Tile> > m_tiles;
   std::vector<Tilegroup> m_tilegroups;
 
+  /** First autotileset containing each tile id, indexed by tile id */
+  std::vector<AutotileSet*> m_autotileset_index;
+
 private:
   TileSet(const TileSet&) = delete;
   TileSet& operator=(const TileSet&) = delete;
@@ -43,6 +43,7 @@ public:
   virtual void event(Player& player, EventType type) override;
   virtual void update(float dt_sec) override;
   virtual void draw(DrawingContext& context) override;
+  virtual bool draws_outside_bbox() const override { return true; }
 
   /** returns true if the player is within bounds of the Climbable */
   bool may_climb(Player& player) const;
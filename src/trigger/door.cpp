@@ -120,6 +120,12 @@ Door::draw(DrawingContext& context)
   sprite->draw(context.color(), m_col.m_bbox.p1(), LAYER_BACKGROUNDTILES+1);
 }
 
+void
+Door::skip_draw()
+{
+  sprite->update();
+}
+
 void
 Door::event(Player& , EventType type)
 {
@@ -87,7 +87,7 @@ SecretAreaTrigger::get_settings()
 void
 SecretAreaTrigger::after_editor_set()
 {
-  m_col.m_bbox.set_size(new_size.x, new_size.y);
+  m_col.set_size(new_size.x, new_size.y);
 }
 
 std::string
@@ -41,6 +41,7 @@ public:
 
   virtual void event(Player& player, EventType type) override;
   virtual void draw(DrawingContext& context) override;
+  virtual bool draws_outside_bbox() const override { return true; }
 
   std::string get_fade_tilemap_name() const;
 
@@ -115,6 +115,12 @@ Switch::draw(DrawingContext& context)
   sprite->draw(context.color(), m_col.m_bbox.p1(), LAYER_TILES);
 }
 
+void
+Switch::skip_draw()
+{
+  sprite->update();
+}
+
 void
 Switch::event(Player& , EventType type)
 {
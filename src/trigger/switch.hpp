@@ -37,6 +37,7 @@ public:
 
   virtual void update(float dt_sec) override;
   virtual void draw(DrawingContext& context) override;
+  virtual void skip_draw() override;
   virtual void event(Player& player, EventType type) override;
 
 private:
@@ -0,0 +1,112 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "util/allocation_counter.hpp"
+
+#include <atomic>
+#include <new>
+#include <stdlib.h>
+
+namespace {
+
+std::atomic<uint64_t> s_allocation_count(0);
+
+void*
+counted_alloc(std::size_t size)
+{
+  s_allocation_count.fetch_add(1, std::memory_order_relaxed);
+  return malloc(size ? size : 1);
+}
+
+} // namespace
+
+namespace AllocationCounter {
+
+uint64_t
+get_count()
+{
+  return s_allocation_count.load(std::memory_order_relaxed);
+}
+
+} // namespace AllocationCounter
+
+void*
+operator new(std::size_t size)
+{
+  void* ptr = counted_alloc(size);
+  if (!ptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+void*
+operator new[](std::size_t size)
+{
+  void* ptr = counted_alloc(size);
+  if (!ptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+void*
+operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+  return counted_alloc(size);
+}
+
+void*
+operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+  return counted_alloc(size);
+}
+
+void
+operator delete(void* ptr) noexcept
+{
+  free(ptr);
+}
+
+void
+operator delete[](void* ptr) noexcept
+{
+  free(ptr);
+}
+
+void
+operator delete(void* ptr, std::size_t) noexcept
+{
+  free(ptr);
+}
+
+void
+operator delete[](void* ptr, std::size_t) noexcept
+{
+  free(ptr);
+}
+
+void
+operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+  free(ptr);
+}
+
+void
+operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+  free(ptr);
+}
+
+/* EOF */
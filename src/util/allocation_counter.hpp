@@ -0,0 +1,33 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_UTIL_ALLOCATION_COUNTER_HPP
+#define HEADER_SUPERTUX_UTIL_ALLOCATION_COUNTER_HPP
+
+#include <stdint.h>
+
+/** Counts the calls to the global operator new, used by the FPS
+    overlay to show how many heap allocations a frame makes. */
+namespace AllocationCounter {
+
+/** Number of allocations made through operator new since startup */
+uint64_t get_count();
+
+} // namespace AllocationCounter
+
+#endif
+
+/* EOF */
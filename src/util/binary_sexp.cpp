@@ -0,0 +1,395 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "util/binary_sexp.hpp"
+
+#include <algorithm>
+#include <sexp/value.hpp>
+#include <stdexcept>
+#include <stdint.h>
+#include <string.h>
+#include <unordered_map>
+#include <vector>
+
+namespace binary_sexp {
+
+namespace {
+
+enum Tag : uint8_t
+{
+  TAG_NIL,
+  TAG_FALSE,
+  TAG_TRUE,
+  TAG_INTEGER,
+  TAG_REAL,
+  TAG_STRING,
+  TAG_SYMBOL,
+  TAG_CONS,
+  TAG_ARRAY,
+  // only valid as array elements, expand to several integers
+  TAG_INTEGER_RUN,
+  TAG_INTEGER_RLE
+};
+
+/** Shortest run of integers in an array that gets packed */
+const size_t MIN_INTEGER_RUN = 8;
+
+class BinaryWriter final
+{
+public:
+  BinaryWriter() :
+    m_strings(),
+    m_string_table(),
+    m_body()
+  {
+  }
+
+  std::string finish()
+  {
+    std::string result;
+    write_u32(result, static_cast<uint32_t>(m_string_table.size()));
+    for (const auto& str : m_string_table) {
+      write_u32(result, static_cast<uint32_t>(str.size()));
+      result += str;
+    }
+    result += m_body;
+    return result;
+  }
+
+  void write_value(const sexp::Value& value)
+  {
+    switch (value.get_type())
+    {
+      case sexp::Value::Type::NIL:
+        write_u8(TAG_NIL);
+        break;
+
+      case sexp::Value::Type::BOOLEAN:
+        write_u8(value.as_bool() ? TAG_TRUE : TAG_FALSE);
+        break;
+
+      case sexp::Value::Type::INTEGER:
+        write_u8(TAG_INTEGER);
+        write_u32(m_body, static_cast<uint32_t>(value.as_int()));
+        break;
+
+      case sexp::Value::Type::REAL:
+      {
+        const float real = value.as_float();
+        uint32_t bits;
+        memcpy(&bits, &real, sizeof(bits));
+        write_u8(TAG_REAL);
+        write_u32(m_body, bits);
+        break;
+      }
+
+      case sexp::Value::Type::STRING:
+        write_u8(TAG_STRING);
+        write_u32(m_body, intern(value.as_string()));
+        break;
+
+      case sexp::Value::Type::SYMBOL:
+        write_u8(TAG_SYMBOL);
+        write_u32(m_body, intern(value.as_string()));
+        break;
+
+      case sexp::Value::Type::CONS:
+        write_u8(TAG_CONS);
+        write_value(value.get_car());
+        write_value(value.get_cdr());
+        break;
+
+      case sexp::Value::Type::ARRAY:
+        write_array(value.as_array());
+        break;
+    }
+  }
+
+private:
+  void write_array(const std::vector<sexp::Value>& array)
+  {
+    write_u8(TAG_ARRAY);
+    write_u32(m_body, static_cast<uint32_t>(array.size()));
+
+    size_t i = 0;
+    while (i < array.size())
+    {
+      size_t end = i;
+      while (end < array.size() && array[end].is_integer())
+        ++end;
+
+      if (end - i >= MIN_INTEGER_RUN) {
+        write_integer_run(array, i, end);
+        i = end;
+      } else {
+        write_value(array[i]);
+        ++i;
+      }
+    }
+  }
+
+  void write_integer_run(const std::vector<sexp::Value>& array, size_t begin, size_t end)
+  {
+    const uint32_t count = static_cast<uint32_t>(end - begin);
+
+    uint32_t runs = 1;
+    for (size_t i = begin + 1; i < end; ++i) {
+      if (array[i].as_int() != array[i - 1].as_int())
+        ++runs;
+    }
+
+    // each run costs two words, plain values one word each
+    if (runs * 2 < count) {
+      write_u8(TAG_INTEGER_RLE);
+      write_u32(m_body, count);
+      write_u32(m_body, runs);
+      size_t i = begin;
+      while (i < end) {
+        size_t run_end = i + 1;
+        while (run_end < end && array[run_end].as_int() == array[i].as_int())
+          ++run_end;
+        write_u32(m_body, static_cast<uint32_t>(run_end - i));
+        write_u32(m_body, static_cast<uint32_t>(array[i].as_int()));
+        i = run_end;
+      }
+    } else {
+      write_u8(TAG_INTEGER_RUN);
+      write_u32(m_body, count);
+      for (size_t i = begin; i < end; ++i) {
+        write_u32(m_body, static_cast<uint32_t>(array[i].as_int()));
+      }
+    }
+  }
+
+  uint32_t intern(const std::string& str)
+  {
+    auto it = m_strings.find(str);
+    if (it != m_strings.end())
+      return it->second;
+
+    const uint32_t index = static_cast<uint32_t>(m_string_table.size());
+    m_strings[str] = index;
+    m_string_table.push_back(str);
+    return index;
+  }
+
+  void write_u8(uint8_t value)
+  {
+    m_body += static_cast<char>(value);
+  }
+
+  static void write_u32(std::string& out, uint32_t value)
+  {
+    const char bytes[4] = {
+      static_cast<char>(value & 0xff),
+      static_cast<char>((value >> 8) & 0xff),
+      static_cast<char>((value >> 16) & 0xff),
+      static_cast<char>((value >> 24) & 0xff)
+    };
+    out.append(bytes, 4);
+  }
+
+private:
+  std::unordered_map<std::string, uint32_t> m_strings;
+  std::vector<std::string> m_string_table;
+  std::string m_body;
+
+private:
+  BinaryWriter(const BinaryWriter&) = delete;
+  BinaryWriter& operator=(const BinaryWriter&) = delete;
+};
+
+class BinaryReader final
+{
+public:
+  BinaryReader(const std::string& data) :
+    m_data(data),
+    m_pos(0),
+    m_string_table()
+  {
+    const uint32_t count = read_u32();
+    check_available(count);
+    m_string_table.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+      const uint32_t size = read_u32();
+      check_available(size);
+      m_string_table.emplace_back(m_data, m_pos, size);
+      m_pos += size;
+    }
+  }
+
+  sexp::Value read_value()
+  {
+    const uint8_t tag = read_u8();
+    switch (tag)
+    {
+      case TAG_NIL:
+        return sexp::Value::nil();
+
+      case TAG_FALSE:
+        return sexp::Value::boolean(false);
+
+      case TAG_TRUE:
+        return sexp::Value::boolean(true);
+
+      case TAG_INTEGER:
+        return sexp::Value::integer(static_cast<int>(read_u32()));
+
+      case TAG_REAL:
+      {
+        const uint32_t bits = read_u32();
+        float real;
+        memcpy(&real, &bits, sizeof(real));
+        return sexp::Value::real(real);
+      }
+
+      case TAG_STRING:
+        return sexp::Value::string(read_string());
+
+      case TAG_SYMBOL:
+        return sexp::Value::symbol(read_string());
+
+      case TAG_CONS:
+      {
+        auto car = read_value();
+        auto cdr = read_value();
+        return sexp::Value::cons(std::move(car), std::move(cdr));
+      }
+
+      case TAG_ARRAY:
+        return read_array();
+
+      default:
+        throw std::runtime_error("binary_sexp: invalid tag " + std::to_string(tag));
+    }
+  }
+
+  bool at_end() const { return m_pos == m_data.size(); }
+
+private:
+  sexp::Value read_array()
+  {
+    const uint32_t size = read_u32();
+
+    std::vector<sexp::Value> array;
+    // don't trust the size of broken data for the allocation, runs of
+    // integers can still make the array outgrow it
+    array.reserve(std::min(static_cast<size_t>(size), m_data.size() - m_pos));
+    while (array.size() < size)
+    {
+      check_available(1);
+      const uint8_t tag = static_cast<uint8_t>(m_data[m_pos]);
+      if (tag == TAG_INTEGER_RUN) {
+        ++m_pos;
+        const uint32_t count = read_run_count(array.size(), size);
+        for (uint32_t i = 0; i < count; ++i) {
+          array.push_back(sexp::Value::integer(static_cast<int>(read_u32())));
+        }
+      } else if (tag == TAG_INTEGER_RLE) {
+        ++m_pos;
+        const uint32_t count = read_run_count(array.size(), size);
+        const uint32_t runs = read_u32();
+        const size_t end = array.size() + count;
+        for (uint32_t run = 0; run < runs; ++run) {
+          const uint32_t length = read_u32();
+          const int value = static_cast<int>(read_u32());
+          if (length > end - array.size())
+            throw std::runtime_error("binary_sexp: run exceeds array size");
+          for (uint32_t i = 0; i < length; ++i) {
+            array.push_back(sexp::Value::integer(value));
+          }
+        }
+        if (array.size() != end)
+          throw std::runtime_error("binary_sexp: run length mismatch");
+      } else {
+        array.push_back(read_value());
+      }
+    }
+    return sexp::Value::array(std::move(array));
+  }
+
+  uint32_t read_run_count(size_t filled, size_t size)
+  {
+    const uint32_t count = read_u32();
+    if (count > size - filled)
+      throw std::runtime_error("binary_sexp: run exceeds array size");
+    return count;
+  }
+
+  const std::string& read_string()
+  {
+    const uint32_t index = read_u32();
+    if (index >= m_string_table.size())
+      throw std::runtime_error("binary_sexp: invalid string index");
+    return m_string_table[index];
+  }
+
+  uint8_t read_u8()
+  {
+    check_available(1);
+    return static_cast<uint8_t>(m_data[m_pos++]);
+  }
+
+  uint32_t read_u32()
+  {
+    check_available(4);
+    const auto* bytes = reinterpret_cast<const unsigned char*>(m_data.data() + m_pos);
+    m_pos += 4;
+    return static_cast<uint32_t>(bytes[0]) |
+      (static_cast<uint32_t>(bytes[1]) << 8) |
+      (static_cast<uint32_t>(bytes[2]) << 16) |
+      (static_cast<uint32_t>(bytes[3]) << 24);
+  }
+
+  void check_available(size_t size) const
+  {
+    if (size > m_data.size() - m_pos)
+      throw std::runtime_error("binary_sexp: unexpected end of data");
+  }
+
+private:
+  const std::string& m_data;
+  size_t m_pos;
+  std::vector<std::string> m_string_table;
+
+private:
+  BinaryReader(const BinaryReader&) = delete;
+  BinaryReader& operator=(const BinaryReader&) = delete;
+};
+
+} // namespace
+
+std::string
+write(const sexp::Value& value)
+{
+  BinaryWriter writer;
+  writer.write_value(value);
+  return writer.finish();
+}
+
+sexp::Value
+read(const std::string& data)
+{
+  BinaryReader reader(data);
+  sexp::Value value = reader.read_value();
+  if (!reader.at_end())
+    throw std::runtime_error("binary_sexp: trailing data");
+  return value;
+}
+
+} // namespace binary_sexp
+
+/* EOF */
@@ -0,0 +1,43 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_UTIL_BINARY_SEXP_HPP
+#define HEADER_SUPERTUX_UTIL_BINARY_SEXP_HPP
+
+#include <string>
+
+namespace sexp {
+class Value;
+} // namespace sexp
+
+/** Compact binary encoding of sexp::Value trees, used for compiled
+    levels. Strings and symbols are stored once in a table, and long runs
+    of integers inside arrays (such as tilemap data) are stored as raw
+    little-endian uint32 values or run-length encoded, whichever is
+    smaller. Line numbers are not preserved. */
+namespace binary_sexp {
+
+std::string write(const sexp::Value& value);
+
+/** Decodes data produced by write(), throws std::runtime_error if the
+    data is truncated or malformed */
+sexp::Value read(const std::string& data);
+
+} // namespace binary_sexp
+
+#endif
+
+/* EOF */
@@ -18,6 +18,9 @@
 #include "util/log.hpp"
 
 #include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
 
 #include "math/rectf.hpp"
 #include "supertux/console.hpp"
@@ -26,6 +29,43 @@
 
 LogLevel g_log_level = LOG_WARNING;
 
+namespace {
+
+/** The console and its buffer are only touched by the main thread,
+    messages logged by other threads wait here until it picks them up */
+std::mutex s_thread_messages_mutex;
+std::string s_thread_messages;
+
+const std::thread::id s_main_thread = std::this_thread::get_id();
+
+/** Stream buffer of the threads other than the main thread, hands each
+    finished message over to s_thread_messages */
+class ThreadLogBuffer final : public std::stringbuf
+{
+public:
+  virtual int sync() override
+  {
+    std::lock_guard<std::mutex> lock(s_thread_messages_mutex);
+    s_thread_messages += str();
+    str(std::string());
+    return 0;
+  }
+};
+
+std::ostream& get_thread_stream()
+{
+  thread_local ThreadLogBuffer buffer;
+  thread_local std::ostream stream(&buffer);
+  return stream;
+}
+
+bool is_main_thread()
+{
+  return std::this_thread::get_id() == s_main_thread;
+}
+
+} // namespace
+
 static std::ostream& get_logging_instance (bool use_console_buffer = true)
 {
   if (ConsoleBuffer::current() && use_console_buffer)
@@ -36,6 +76,13 @@ static std::ostream& get_logging_instance (bool use_console_buffer = true)
 
 static std::ostream& log_generic_f (const char *prefix, const char* file, int line, bool use_console_buffer = true)
 {
+  if (!is_main_thread())
+  {
+    get_thread_stream() << prefix << " " << file << ":" << line << " ";
+    return (get_thread_stream());
+  }
+
+  log_flush_thread_messages();
   get_logging_instance (use_console_buffer) << prefix << " " << file << ":" << line << " ";
   return (get_logging_instance (use_console_buffer));
 }
@@ -52,7 +99,7 @@ std::ostream& log_info_f(const char* file, int line)
 
 std::ostream& log_warning_f(const char* file, int line)
 {
-  if (g_config && g_config->developer_mode &&
+  if (g_config && g_config->developer_mode && is_main_thread() &&
      Console::current() && !Console::current()->hasFocus()) {
     Console::current()->open();
   }
@@ -61,13 +108,27 @@ std::ostream& log_warning_f(const char* file, int line)
 
 std::ostream& log_fatal_f(const char* file, int line)
 {
-  if (g_config && g_config->developer_mode &&
+  if (g_config && g_config->developer_mode && is_main_thread() &&
      Console::current() && !Console::current()->hasFocus()) {
     Console::current()->open();
   }
   return (log_generic_f ("[FATAL]", file, line));
 }
 
+void log_flush_thread_messages()
+{
+  if (!is_main_thread())
+    return;
+
+  std::string messages;
+  {
+    std::lock_guard<std::mutex> lock(s_thread_messages_mutex);
+    messages.swap(s_thread_messages);
+  }
+  if (!messages.empty())
+    get_logging_instance() << messages << std::flush;
+}
+
 /* Callbacks used by tinygettext */
 void log_info_callback(const std::string& str)
 {
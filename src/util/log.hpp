@@ -35,6 +35,10 @@ std::ostream& log_warning_f(const char* file, int line);
 std::ostream& log_fatal_f(const char* file, int line);
 #define log_fatal if (g_log_level >= LOG_FATAL) log_fatal_f(__FILE__, __LINE__)
 
+/** Passes the messages logged by other threads on to the console, they
+    are kept back until the main thread logs something or calls this */
+void log_flush_thread_messages();
+
 void log_info_callback(const std::string& str);
 void log_error_callback(const std::string& str);
 void log_warning_callback(const std::string& str);
@@ -17,7 +17,12 @@
 #ifndef HEADER_SUPERTUX_UTIL_OBSTACKPP_HPP
 #define HEADER_SUPERTUX_UTIL_OBSTACKPP_HPP
 
+#include <new>
 #include <obstack.h>
+#include <stdint.h>
+#include <type_traits>
+
+#include "util/span.hpp"
 
 inline void*
 operator new (size_t bytes, struct obstack& obst)
@@ -54,6 +59,48 @@ static inline void obstack_chunk_free(void* data)
   delete[] ptr;
 }
 
+/** Allocates an array of size default constructed elements on the
+    obstack. The elements are never destructed, so only trivially
+    destructible types can be used. */
+template<typename T>
+inline Span<T>
+obstack_alloc_span(struct obstack& obst, size_t size)
+{
+  static_assert(std::is_trivially_destructible<T>::value,
+                "obstack memory is freed without calling destructors");
+
+  if (size == 0)
+    return Span<T>();
+
+  T* data = static_cast<T*>(obstack_alloc(&obst, static_cast<int>(sizeof(T) * size)));
+  for (size_t i = 0; i < size; ++i)
+  {
+    new (data + i) T();
+  }
+  return Span<T>(data, size);
+}
+
+/** Frees all the objects on the obstack but keeps its memory, so that
+    allocating the same amount again doesn't reach the heap. If the
+    objects didn't fit into a single chunk, the obstack is started again
+    with a chunk that is big enough for all of them. */
+inline void
+obstack_reset(struct obstack& obst)
+{
+  if (obst.chunk->prev == nullptr)
+  {
+    char* base = obst.chunk->contents;
+    base += (-reinterpret_cast<uintptr_t>(base)) & static_cast<uintptr_t>(obst.alignment_mask);
+    obstack_free(&obst, base);
+  }
+  else
+  {
+    const int size = obstack_memory_used(&obst);
+    obstack_free(&obst, nullptr);
+    obstack_begin(&obst, size + size / 2);
+  }
+}
+
 #endif
 
 /* EOF */
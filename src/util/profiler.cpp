@@ -0,0 +1,196 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "util/profiler.hpp"
+
+#include <iomanip>
+#include <string.h>
+
+#include "util/log.hpp"
+
+Profiler g_profiler;
+
+namespace {
+
+/** Keeps a forgotten trace from eating all the memory, about 24 MB */
+const size_t MAX_TRACE_EVENTS = 1000000;
+
+} // namespace
+
+Profiler::Profiler() :
+  m_show_overlay(false),
+  m_tracing(false),
+  m_epoch(std::chrono::steady_clock::now()),
+  m_frame(),
+  m_stack(),
+  m_slowest_frame(),
+  m_window_slowest_frame(),
+  m_window_slowest_ms(0.0),
+  m_window_frames(0),
+  m_trace_events()
+{
+}
+
+void
+Profiler::begin_zone(const char* name)
+{
+  const int parent = m_stack.empty() ? -1 : m_stack.back().zone;
+
+  int zone = -1;
+  if (parent >= 0)
+  {
+    for (int child = m_frame[parent].first_child; child >= 0; child = m_frame[child].next_sibling)
+    {
+      // The same literal may have different addresses in different
+      // translation units
+      if (m_frame[child].name == name || strcmp(m_frame[child].name, name) == 0)
+      {
+        zone = child;
+        break;
+      }
+    }
+  }
+
+  if (zone < 0)
+  {
+    zone = static_cast<int>(m_frame.size());
+
+    Zone new_zone;
+    new_zone.name = name;
+    new_zone.depth = static_cast<int>(m_stack.size());
+    new_zone.calls = 0;
+    new_zone.time_ms = 0.0;
+    new_zone.parent = parent;
+    new_zone.first_child = -1;
+    new_zone.last_child = -1;
+    new_zone.next_sibling = -1;
+    m_frame.push_back(new_zone);
+
+    if (parent >= 0)
+    {
+      if (m_frame[parent].last_child >= 0)
+        m_frame[m_frame[parent].last_child].next_sibling = zone;
+      else
+        m_frame[parent].first_child = zone;
+      m_frame[parent].last_child = zone;
+    }
+  }
+
+  OpenZone open_zone;
+  open_zone.zone = zone;
+  open_zone.start = std::chrono::steady_clock::now();
+  m_stack.push_back(open_zone);
+}
+
+void
+Profiler::end_zone()
+{
+  if (m_stack.empty())
+    return;
+
+  const auto now = std::chrono::steady_clock::now();
+  const OpenZone open_zone = m_stack.back();
+  m_stack.pop_back();
+
+  const double duration_us = std::chrono::duration<double, std::micro>(now - open_zone.start).count();
+
+  Zone& zone = m_frame[open_zone.zone];
+  zone.calls += 1;
+  zone.time_ms += duration_us / 1000.0;
+
+  if (m_tracing && m_trace_events.size() < MAX_TRACE_EVENTS)
+  {
+    TraceEvent event;
+    event.name = zone.name;
+    event.start_us = std::chrono::duration<double, std::micro>(open_zone.start - m_epoch).count();
+    event.duration_us = duration_us;
+    m_trace_events.push_back(event);
+  }
+
+  if (m_stack.empty())
+    finish_frame();
+}
+
+void
+Profiler::finish_frame()
+{
+  const double frame_ms = m_frame.empty() ? 0.0 : m_frame[0].time_ms;
+
+  if (m_window_frames == 0 || frame_ms >= m_window_slowest_ms)
+  {
+    m_window_slowest_frame = m_frame;
+    m_window_slowest_ms = frame_ms;
+  }
+
+  m_window_frames += 1;
+  if (m_window_frames >= FRAME_WINDOW)
+  {
+    std::swap(m_slowest_frame, m_window_slowest_frame);
+    m_window_slowest_ms = 0.0;
+    m_window_frames = 0;
+  }
+
+  m_frame.clear();
+}
+
+void
+Profiler::start_trace()
+{
+  m_trace_events.clear();
+  m_tracing = true;
+}
+
+void
+Profiler::stop_trace()
+{
+  m_tracing = false;
+
+  if (m_trace_events.size() >= MAX_TRACE_EVENTS)
+    log_warning << "Profiler trace got truncated after " << MAX_TRACE_EVENTS << " zones" << std::endl;
+}
+
+void
+Profiler::write_trace(std::ostream& out) const
+{
+  out << std::fixed << std::setprecision(3);
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  for (size_t i = 0; i < m_trace_events.size(); ++i)
+  {
+    const auto& event = m_trace_events[i];
+    // Zone names are identifiers from the source, they need no escaping
+    out << (i == 0 ? "\n" : ",\n")
+        << "{\"name\":\"" << event.name << "\",\"cat\":\"supertux\",\"ph\":\"X\""
+        << ",\"ts\":" << event.start_us
+        << ",\"dur\":" << event.duration_us
+        << ",\"pid\":1,\"tid\":1}";
+  }
+  out << "\n]}\n";
+}
+
+ProfileZone::ProfileZone(const char* name) :
+  m_active(g_profiler.is_enabled())
+{
+  if (m_active)
+    g_profiler.begin_zone(name);
+}
+
+ProfileZone::~ProfileZone()
+{
+  if (m_active)
+    g_profiler.end_zone();
+}
+
+/* EOF */
@@ -0,0 +1,132 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_UTIL_PROFILER_HPP
+#define HEADER_SUPERTUX_UTIL_PROFILER_HPP
+
+#include <chrono>
+#include <ostream>
+#include <vector>
+
+/** Hierarchical frame profiler.
+
+    Code marks the zones it wants measured with ProfileZone objects;
+    zones opened while another one is open become its children, and
+    zones with the same name under the same parent are merged. A frame
+    ends whenever the outermost zone is closed.
+
+    Nothing is measured unless the overlay is shown or a trace is being
+    recorded, so the zones are cheap to leave in place. The profiler is
+    meant to be used from the main thread only. */
+class Profiler final
+{
+public:
+  struct Zone
+  {
+    const char* name;
+    int depth;
+    int calls;
+    double time_ms;
+
+    int parent;
+    int first_child;
+    int last_child;
+    int next_sibling;
+  };
+
+  /** The overlay shows the slowest frame out of this many */
+  static const int FRAME_WINDOW = 60;
+
+public:
+  Profiler();
+
+  bool is_enabled() const { return m_show_overlay || m_tracing; }
+
+  void set_show_overlay(bool value) { m_show_overlay = value; }
+  bool get_show_overlay() const { return m_show_overlay; }
+
+  void begin_zone(const char* name);
+  void end_zone();
+
+  /** Zones of the slowest of the last FRAME_WINDOW frames, the
+      outermost zone is at index 0 */
+  const std::vector<Zone>& get_slowest_frame() const { return m_slowest_frame; }
+
+  void start_trace();
+  void stop_trace();
+  bool is_tracing() const { return m_tracing; }
+
+  /** Writes the zones recorded since start_trace() in the Chrome trace
+      event format, which can be loaded in chrome://tracing or Perfetto */
+  void write_trace(std::ostream& out) const;
+
+private:
+  struct OpenZone
+  {
+    int zone;
+    std::chrono::steady_clock::time_point start;
+  };
+
+  struct TraceEvent
+  {
+    const char* name;
+    double start_us;
+    double duration_us;
+  };
+
+  void finish_frame();
+
+private:
+  bool m_show_overlay;
+  bool m_tracing;
+  std::chrono::steady_clock::time_point m_epoch;
+
+  std::vector<Zone> m_frame;
+  std::vector<OpenZone> m_stack;
+
+  std::vector<Zone> m_slowest_frame;
+  std::vector<Zone> m_window_slowest_frame;
+  double m_window_slowest_ms;
+  int m_window_frames;
+
+  std::vector<TraceEvent> m_trace_events;
+
+private:
+  Profiler(const Profiler&) = delete;
+  Profiler& operator=(const Profiler&) = delete;
+};
+
+/** Measures the time between its construction and destruction as a
+    zone of the global profiler */
+class ProfileZone final
+{
+public:
+  explicit ProfileZone(const char* name);
+  ~ProfileZone();
+
+private:
+  bool m_active;
+
+private:
+  ProfileZone(const ProfileZone&) = delete;
+  ProfileZone& operator=(const ProfileZone&) = delete;
+};
+
+extern Profiler g_profiler;
+
+#endif
+
+/* EOF */
@@ -16,23 +16,43 @@
 
 #include "util/reader_mapping.hpp"
 
+#include <algorithm>
 #include <boost/ref.hpp>
 #include <boost/utility/typed_in_place_factory.hpp>
 #include <sexp/io.hpp>
 #include <sstream>
 #include <stdexcept>
+#include <string.h>
 
 #include "util/gettext.hpp"
+#include "util/log.hpp"
 #include "util/reader_collection.hpp"
 #include "util/reader_document.hpp"
 #include "util/reader_error.hpp"
 
 bool ReaderMapping::s_translations_enabled = true;
+size_t ReaderMapping::s_index_min_size = 16;
+
+struct ReaderMapping::Index
+{
+  struct Entry
+  {
+    const char* key;
+    const sexp::Value* item;
+
+    /** The key appears more than once, only the first one is used */
+    bool duplicate;
+  };
+
+  /** One entry per key, sorted by key */
+  std::vector<Entry> entries;
+};
 
 ReaderMapping::ReaderMapping(const ReaderDocument& doc, const sexp::Value& sx) :
   m_doc(doc),
   m_sx(sx),
-  m_arr([this]() -> decltype(m_arr){ assert_is_array(m_doc, m_sx); return m_sx.as_array();}())
+  m_arr([this]() -> decltype(m_arr){ assert_is_array(m_doc, m_sx); return m_sx.as_array();}()),
+  m_index()
 {
 }
 
@@ -44,9 +64,70 @@ ReaderMapping::get_iter() const
   return ReaderIterator(m_doc, m_sx);
 }
 
+void
+ReaderMapping::build_index() const
+{
+  auto index = std::make_shared<Index>();
+  index->entries.reserve(m_arr.size() - 1);
+
+  for (size_t i = 1; i < m_arr.size(); ++i)
+  {
+    auto const& pair = m_arr[i];
+    assert_array_size_ge(m_doc, pair, 1);
+    assert_is_symbol(m_doc, pair.as_array()[0]);
+    index->entries.push_back({pair.as_array()[0].as_string().c_str(), &pair, false});
+  }
+
+  // stable, so that the first of several equal keys wins like in a scan
+  std::stable_sort(index->entries.begin(), index->entries.end(),
+                   [](const Index::Entry& lhs, const Index::Entry& rhs) {
+                     return strcmp(lhs.key, rhs.key) < 0;
+                   });
+
+  auto& entries = index->entries;
+  size_t last = 0;
+  for (size_t i = 1; i < entries.size(); ++i)
+  {
+    if (strcmp(entries[i].key, entries[last].key) == 0) {
+      entries[last].duplicate = true;
+    } else {
+      entries[++last] = entries[i];
+    }
+  }
+  if (!entries.empty())
+    entries.resize(last + 1);
+
+  m_index = std::move(index);
+}
+
 const sexp::Value*
 ReaderMapping::get_item(const char* key) const
 {
+  if (m_arr.size() > s_index_min_size)
+  {
+    if (!m_index)
+      build_index();
+
+    auto const& entries = m_index->entries;
+    auto it = std::lower_bound(entries.begin(), entries.end(), key,
+                               [](const Index::Entry& entry, const char* k) {
+                                 return strcmp(entry.key, k) < 0;
+                               });
+    if (it == entries.end() || strcmp(it->key, key) != 0)
+      return nullptr;
+
+    // Many keys legitimately repeat in large mappings (objects in a
+    // sector, tiles in a tileset), it's only a mistake if get() asks
+    // for one of them
+    if (it->duplicate)
+    {
+      log_warning << m_doc.get_filename() << ":" << it->item->get_line()
+                  << ": '" << key << "' is defined more than once, only the first one is used"
+                  << std::endl;
+    }
+    return it->item;
+  }
+
   for (size_t i = 1; i < m_arr.size(); ++i)
   {
     auto const& pair = m_arr[i];
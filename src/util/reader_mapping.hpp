@@ -18,6 +18,7 @@
 #define HEADER_SUPERTUX_UTIL_READER_MAPPING_HPP
 
 #include <boost/optional.hpp>
+#include <memory>
 
 #include "util/reader_iterator.hpp"
 
@@ -33,6 +34,10 @@ class ReaderMapping final
 public:
   static bool s_translations_enabled;
 
+  /** Mappings with at least that many entries get an index on their
+      first lookup instead of being scanned for every key */
+  static size_t s_index_min_size;
+
 public:
   // sx should point to (section (name value)...)
   ReaderMapping(const ReaderDocument& doc, const sexp::Value& sx);
@@ -82,14 +87,22 @@ public:
   const sexp::Value& get_sexp() const { return m_sx; }
   const ReaderDocument& get_doc() const { return m_doc; }
 
+private:
+  struct Index;
+
 private:
   /** Returns pointer to (key value) */
   const sexp::Value* get_item(const char* key) const;
 
+  void build_index() const;
+
 private:
   const ReaderDocument& m_doc;
   const sexp::Value& m_sx;
   const std::vector<sexp::Value>& m_arr;
+
+  /** Built lazily for large mappings, shared between copies */
+  mutable std::shared_ptr<const Index> m_index;
 };
 
 #endif
@@ -0,0 +1,87 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "util/ring_buffer.hpp"
+
+#include <algorithm>
+#include <string.h>
+
+RingBuffer::RingBuffer(size_t capacity) :
+  m_data(new char[capacity]),
+  m_capacity(capacity),
+  m_read_pos(0),
+  m_write_pos(0)
+{
+}
+
+size_t
+RingBuffer::write(const void* data, size_t size)
+{
+  const size_t write_pos = m_write_pos.load(std::memory_order_relaxed);
+  const size_t read_pos = m_read_pos.load(std::memory_order_acquire);
+
+  size = std::min(size, m_capacity - (write_pos - read_pos));
+  if (size == 0)
+    return 0;
+
+  const size_t offset = write_pos % m_capacity;
+  const size_t first = std::min(size, m_capacity - offset);
+  memcpy(m_data.get() + offset, data, first);
+  memcpy(m_data.get(), static_cast<const char*>(data) + first, size - first);
+
+  m_write_pos.store(write_pos + size, std::memory_order_release);
+  return size;
+}
+
+size_t
+RingBuffer::read(void* data, size_t size)
+{
+  const size_t read_pos = m_read_pos.load(std::memory_order_relaxed);
+  const size_t write_pos = m_write_pos.load(std::memory_order_acquire);
+
+  size = std::min(size, write_pos - read_pos);
+  if (size == 0)
+    return 0;
+
+  const size_t offset = read_pos % m_capacity;
+  const size_t first = std::min(size, m_capacity - offset);
+  memcpy(data, m_data.get() + offset, first);
+  memcpy(static_cast<char*>(data) + first, m_data.get(), size - first);
+
+  m_read_pos.store(read_pos + size, std::memory_order_release);
+  return size;
+}
+
+size_t
+RingBuffer::get_read_available() const
+{
+  return m_write_pos.load(std::memory_order_acquire) - m_read_pos.load(std::memory_order_acquire);
+}
+
+size_t
+RingBuffer::get_write_available() const
+{
+  return m_capacity - get_read_available();
+}
+
+void
+RingBuffer::clear()
+{
+  m_read_pos.store(0);
+  m_write_pos.store(0);
+}
+
+/* EOF */
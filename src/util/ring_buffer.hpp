@@ -0,0 +1,64 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_UTIL_RING_BUFFER_HPP
+#define HEADER_SUPERTUX_UTIL_RING_BUFFER_HPP
+
+#include <atomic>
+#include <memory>
+
+/** Fixed-size byte queue shared by exactly one producer thread and one
+    consumer thread without locking. write() must only be called by the
+    producer, read() only by the consumer. */
+class RingBuffer final
+{
+public:
+  RingBuffer(size_t capacity);
+
+  /** Copies as much of the data as fits, returns the amount of bytes written */
+  size_t write(const void* data, size_t size);
+
+  /** Copies up to size bytes out of the buffer, returns the amount read */
+  size_t read(void* data, size_t size);
+
+  /** Amount of bytes that the consumer can read */
+  size_t get_read_available() const;
+
+  /** Amount of bytes that the producer can write */
+  size_t get_write_available() const;
+
+  size_t get_capacity() const { return m_capacity; }
+
+  /** Drops all the content; neither side may use the buffer meanwhile. */
+  void clear();
+
+private:
+  std::unique_ptr<char[]> m_data;
+  const size_t m_capacity;
+
+  /** Total amount of bytes ever read and written; only the consumer moves
+      m_read_pos and only the producer moves m_write_pos. */
+  std::atomic<size_t> m_read_pos;
+  std::atomic<size_t> m_write_pos;
+
+private:
+  RingBuffer(const RingBuffer&) = delete;
+  RingBuffer& operator=(const RingBuffer&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -0,0 +1,70 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_UTIL_SPAN_HPP
+#define HEADER_SUPERTUX_UTIL_SPAN_HPP
+
+#include <stddef.h>
+#include <type_traits>
+#include <vector>
+
+/** View of a contiguous array that it doesn't own, like std::span of
+    C++20. The array has to outlive the view. */
+template<typename T>
+class Span final
+{
+public:
+  using value_type = typename std::remove_const<T>::type;
+
+public:
+  Span() :
+    m_data(nullptr),
+    m_size(0)
+  {}
+
+  Span(T* data, size_t size) :
+    m_data(data),
+    m_size(size)
+  {}
+
+  Span(std::vector<value_type>& vec) :
+    m_data(vec.data()),
+    m_size(vec.size())
+  {}
+
+  /** Only usable for views of const elements */
+  Span(const std::vector<value_type>& vec) :
+    m_data(vec.data()),
+    m_size(vec.size())
+  {}
+
+  T* data() const { return m_data; }
+  size_t size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+
+  T* begin() const { return m_data; }
+  T* end() const { return m_data + m_size; }
+
+  T& operator[](size_t i) const { return m_data[i]; }
+
+private:
+  T* m_data;
+  size_t m_size;
+};
+
+#endif
+
+/* EOF */
@@ -17,20 +17,50 @@
 #include "video/canvas.hpp"
 
 #include <algorithm>
+#include <assert.h>
+#include <limits>
 
 #include "supertux/globals.hpp"
 #include "util/log.hpp"
 #include "util/obstackpp.hpp"
+#include "util/profiler.hpp"
 #include "video/drawing_request.hpp"
 #include "video/painter.hpp"
 #include "video/renderer.hpp"
 #include "video/surface.hpp"
 #include "video/video_system.hpp"
 
+namespace {
+
+/** Layers are spread over a few thousand values at most, beyond that
+    the buckets would cost more than they save */
+const int MAX_LAYER_BUCKETS = 8192;
+
+bool
+can_merge(const DrawingRequest& lhs, const DrawingRequest& rhs)
+{
+  if (lhs.type != TEXTURE || rhs.type != TEXTURE || lhs.layer != rhs.layer)
+    return false;
+
+  const auto& a = static_cast<const TextureRequest&>(lhs);
+  const auto& b = static_cast<const TextureRequest&>(rhs);
+  return a.texture == b.texture &&
+         a.displacement_texture == b.displacement_texture &&
+         a.flip == b.flip &&
+         a.alpha == b.alpha &&
+         a.blend == b.blend &&
+         a.color == b.color;
+}
+
+} // namespace
+
 Canvas::Canvas(DrawingContext& context, obstack& obst) :
   m_context(context),
   m_obst(obst),
-  m_requests()
+  m_requests(),
+  m_sorted_requests(),
+  m_layer_offsets(),
+  m_sorted_count(0)
 {
   m_requests.reserve(500);
 }
@@ -48,18 +78,21 @@ Canvas::clear()
     request->~DrawingRequest();
   }
   m_requests.clear();
+  m_sorted_count = 0;
 }
 
 void
 Canvas::render(Renderer& renderer, Filter filter)
 {
-  // On a regular level, each frame has around 50-250 requests (before
-  // batching it was 1000-3000), the sort comparator function is
-  // called approximatly 3-7 times for each request.
-  std::stable_sort(m_requests.begin(), m_requests.end(),
-                   [](const DrawingRequest* r1, const DrawingRequest* r2){
-                     return r1->layer < r2->layer;
-                   });
+  ProfileZone profile_zone("Canvas::render");
+
+  // The color canvas gets rendered twice, below and above the lightmap
+  if (m_sorted_count != m_requests.size())
+  {
+    sort_requests();
+    merge_requests();
+    m_sorted_count = m_requests.size();
+  }
 
   Painter& painter = renderer.get_painter();
 
@@ -103,6 +136,117 @@ Canvas::render(Renderer& renderer, Filter filter)
   }
 }
 
+void
+Canvas::sort_requests()
+{
+  if (m_requests.size() < 2)
+    return;
+
+  int min_layer = std::numeric_limits<int>::max();
+  int max_layer = std::numeric_limits<int>::min();
+  bool sorted = true;
+  for (const auto& request : m_requests)
+  {
+    if (request->layer < max_layer)
+      sorted = false;
+    min_layer = std::min(min_layer, request->layer);
+    max_layer = std::max(max_layer, request->layer);
+  }
+
+  if (sorted)
+    return;
+
+  if (static_cast<long long>(max_layer) - min_layer >= MAX_LAYER_BUCKETS)
+  {
+    std::stable_sort(m_requests.begin(), m_requests.end(),
+                     [](const DrawingRequest* r1, const DrawingRequest* r2){
+                       return r1->layer < r2->layer;
+                     });
+    return;
+  }
+
+  // Counting sort: find where each layer starts, then put every
+  // request behind the ones of its layer that came before it
+  const size_t bucket_count = static_cast<size_t>(max_layer - min_layer) + 1;
+  m_layer_offsets.assign(bucket_count + 1, 0);
+  for (const auto& request : m_requests)
+  {
+    m_layer_offsets[request->layer - min_layer + 1] += 1;
+  }
+
+  for (size_t i = 1; i < bucket_count; ++i)
+  {
+    m_layer_offsets[i] += m_layer_offsets[i - 1];
+  }
+
+  m_sorted_requests.resize(m_requests.size());
+  for (const auto& request : m_requests)
+  {
+    m_sorted_requests[m_layer_offsets[request->layer - min_layer]++] = request;
+  }
+
+  m_requests.swap(m_sorted_requests);
+}
+
+void
+Canvas::merge_requests()
+{
+  if (m_requests.empty())
+    return;
+
+  size_t last = 0;
+  size_t run_begin = 0;
+  for (size_t i = 1; i <= m_requests.size(); ++i)
+  {
+    if (i < m_requests.size() && can_merge(*m_requests[run_begin], *m_requests[i]))
+      continue;
+
+    if (i - run_begin > 1)
+    {
+      merge_run(run_begin, i);
+    }
+    m_requests[last] = m_requests[run_begin];
+    last += 1;
+    run_begin = i;
+  }
+
+  m_requests.resize(last);
+}
+
+void
+Canvas::merge_run(size_t begin, size_t end)
+{
+  size_t size = 0;
+  for (size_t i = begin; i < end; ++i)
+  {
+    size += static_cast<TextureRequest&>(*m_requests[i]).srcrects.size();
+  }
+
+  auto srcrects = obstack_alloc_span<Rectf>(m_obst, size);
+  auto dstrects = obstack_alloc_span<Rectf>(m_obst, size);
+  auto angles = obstack_alloc_span<float>(m_obst, size);
+
+  size_t pos = 0;
+  for (size_t i = begin; i < end; ++i)
+  {
+    auto& part = static_cast<TextureRequest&>(*m_requests[i]);
+    std::copy(part.srcrects.begin(), part.srcrects.end(), srcrects.begin() + pos);
+    std::copy(part.dstrects.begin(), part.dstrects.end(), dstrects.begin() + pos);
+    std::copy(part.angles.begin(), part.angles.end(), angles.begin() + pos);
+    pos += part.srcrects.size();
+
+    if (i != begin)
+    {
+      m_requests[i]->~DrawingRequest();
+    }
+  }
+
+  auto& batch = static_cast<TextureRequest&>(*m_requests[begin]);
+  batch.srcrects = srcrects;
+  batch.dstrects = dstrects;
+  batch.angles = angles;
+}
+
 void
 Canvas::draw_surface(const SurfacePtr& surface,
                      const Vector& position, float angle, const Color& color, const Blend& blend,
@@ -127,11 +271,14 @@ Canvas::draw_surface(const SurfacePtr& surface,
   request->alpha = m_context.transform().alpha;
   request->blend = blend;
 
-  request->srcrects.emplace_back(Rectf(surface->get_region()));
-  request->dstrects.emplace_back(Rectf(apply_translate(position) * scale(),
-                                 Sizef(static_cast<float>(surface->get_width()) * scale(),
-                                       static_cast<float>(surface->get_height()) * scale())));
-  request->angles.emplace_back(angle);
+  request->srcrects = obstack_alloc_span<Rectf>(m_obst, 1);
+  request->dstrects = obstack_alloc_span<Rectf>(m_obst, 1);
+  request->angles = obstack_alloc_span<float>(m_obst, 1);
+  request->srcrects[0] = Rectf(surface->get_region());
+  request->dstrects[0] = Rectf(apply_translate(position) * scale(),
+                               Sizef(static_cast<float>(surface->get_width()) * scale(),
+                                     static_cast<float>(surface->get_height()) * scale()));
+  request->angles[0] = angle;
   request->texture = surface->get_texture().get();
   request->displacement_texture = surface->get_displacement_texture().get();
   request->color = color;
@@ -167,9 +314,13 @@ Canvas::draw_surface_part(const SurfacePtr& surface, const Rectf& srcrect, const
   request->alpha = m_context.transform().alpha * style.get_alpha();
   request->blend = style.get_blend();
 
-  request->srcrects.emplace_back(srcrect);
-  request->dstrects.emplace_back(apply_translate(dstrect.p1())*scale(), dstrect.get_size()*scale());
-  request->angles.emplace_back(0.0f);
+  const Rect region = surface->get_region();
+  request->srcrects = obstack_alloc_span<Rectf>(m_obst, 1);
+  request->dstrects = obstack_alloc_span<Rectf>(m_obst, 1);
+  request->angles = obstack_alloc_span<float>(m_obst, 1);
+  request->srcrects[0] = srcrect.moved(Vector(static_cast<float>(region.left),
+                                              static_cast<float>(region.top)));
+  request->dstrects[0] = Rectf(apply_translate(dstrect.p1())*scale(), dstrect.get_size()*scale());
   request->texture = surface->get_texture().get();
   request->displacement_texture = surface->get_displacement_texture().get();
   request->color = style.get_color();
@@ -179,29 +330,27 @@ Canvas::draw_surface_part(const SurfacePtr& surface, const Rectf& srcrect, const
 
 void
 Canvas::draw_surface_batch(const SurfacePtr& surface,
-                           std::vector<Rectf> srcrects,
-                           std::vector<Rectf> dstrects,
+                           Span<const Rectf> srcrects,
+                           Span<const Rectf> dstrects,
                            const Color& color,
                            int layer)
 {
-  const size_t len = srcrects.size();
-  draw_surface_batch(surface,
-                     std::move(srcrects),
-                     std::move(dstrects),
-                     std::vector<float>(len, 0.0f),
-                     color, layer);
+  draw_surface_batch(surface, srcrects, dstrects, Span<const float>(), color, layer);
 }
 
 void
 Canvas::draw_surface_batch(const SurfacePtr& surface,
-                           std::vector<Rectf> srcrects,
-                           std::vector<Rectf> dstrects,
-                           std::vector<float> angles,
+                           Span<const Rectf> srcrects,
+                           Span<const Rectf> dstrects,
+                           Span<const float> angles,
                            const Color& color,
                            int layer)
 {
   if (!surface) return;
 
+  assert(srcrects.size() == dstrects.size());
+  assert(angles.empty() || angles.size() == srcrects.size());
+
   auto request = new(m_obst) TextureRequest();
 
   request->type = TEXTURE;
@@ -210,15 +359,24 @@ Canvas::draw_surface_batch(const SurfacePtr& surface,
   request->alpha = m_context.transform().alpha;
   request->color = color;
 
-  request->srcrects = std::move(srcrects);
-  request->dstrects = std::move(dstrects);
-  request->angles = std::move(angles);
+  request->srcrects = obstack_alloc_span<Rectf>(m_obst, srcrects.size());
+  request->dstrects = obstack_alloc_span<Rectf>(m_obst, dstrects.size());
+  request->angles = obstack_alloc_span<float>(m_obst, srcrects.size());
 
-  for (auto& dstrect : request->dstrects)
+  const Rect region = surface->get_region();
+  const Vector offset(static_cast<float>(region.left), static_cast<float>(region.top));
+  for (size_t i = 0; i < srcrects.size(); ++i)
   {
-    dstrect = Rectf(apply_translate(dstrect.p1())*scale(), dstrect.get_size()*scale());
+    request->srcrects[i] = srcrects[i].moved(offset);
   }
 
+  for (size_t i = 0; i < dstrects.size(); ++i)
+  {
+    request->dstrects[i] = Rectf(apply_translate(dstrects[i].p1())*scale(), dstrects[i].get_size()*scale());
+  }
+
+  std::copy(angles.begin(), angles.end(), request->angles.begin());
+
   request->texture = surface->get_texture().get();
   request->displacement_texture = surface->get_displacement_texture().get();
 
@@ -232,6 +390,13 @@ Canvas::draw_text(const FontPtr& font, const std::string& text,
   font->draw_text(*this, text, pos, alignment, layer, color);
 }
 
+void
+Canvas::draw_dynamic_text(const FontPtr& font, const std::string& text,
+                          const Vector& pos, FontAlignment alignment, int layer, const Color& color)
+{
+  font->draw_dynamic_text(*this, text, pos, alignment, layer, color);
+}
+
 void
 Canvas::draw_center_text(const FontPtr& font, const std::string& text,
                          const Vector& position, int layer, const Color& color)
@@ -25,6 +25,7 @@
 
 #include "math/rectf.hpp"
 #include "math/vector.hpp"
+#include "util/span.hpp"
 #include "video/blend.hpp"
 #include "video/color.hpp"
 #include "video/drawing_target.hpp"
@@ -52,23 +53,30 @@ public:
   void draw_surface(const SurfacePtr& surface, const Vector& position, int layer);
   void draw_surface(const SurfacePtr& surface, const Vector& position, float angle, const Color& color, const Blend& blend,
                     int layer);
+  /** srcrect is relative to the surface, as are the srcrects of the
+      batches below */
   void draw_surface_part(const SurfacePtr& surface, const Rectf& srcrect, const Rectf& dstrect,
                          int layer, const PaintStyle& style = PaintStyle());
   void draw_surface_scaled(const SurfacePtr& surface, const Rectf& dstrect,
                            int layer, const PaintStyle& style = PaintStyle());
+  /** The rects are copied, the arrays can be reused right after the
+      call. angles can be left empty for unrotated surfaces. */
   void draw_surface_batch(const SurfacePtr& surface,
-                          std::vector<Rectf> srcrects,
-                          std::vector<Rectf> dstrects,
+                          Span<const Rectf> srcrects,
+                          Span<const Rectf> dstrects,
                           const Color& color,
                           int layer);
   void draw_surface_batch(const SurfacePtr& surface,
-                          std::vector<Rectf> srcrects,
-                          std::vector<Rectf> dstrects,
-                          std::vector<float> angles,
+                          Span<const Rectf> srcrects,
+                          Span<const Rectf> dstrects,
+                          Span<const float> angles,
                           const Color& color,
                           int layer);
   void draw_text(const FontPtr& font, const std::string& text,
                  const Vector& position, FontAlignment alignment, int layer, const Color& color = Color(1.0,1.0,1.0));
+  /** Draw text that changes often, see Font::draw_dynamic_text() */
+  void draw_dynamic_text(const FontPtr& font, const std::string& text,
+                         const Vector& position, FontAlignment alignment, int layer, const Color& color = Color(1.0,1.0,1.0));
   /** Draw text to the center of the screen */
   void draw_center_text(const FontPtr& font, const std::string& text,
                         const Vector& position, int layer, const Color& color = Color(1.0,1.0,1.0));
@@ -94,11 +102,31 @@ private:
   Vector apply_translate(const Vector& pos) const;
   float scale() const;
 
+  /** Orders the requests by layer, keeping the order in which they
+      were made within each layer */
+  void sort_requests();
+
+  /** Turns runs of texture requests that only differ in their rects
+      into a single request */
+  void merge_requests();
+
+  /** Moves the rects of the requests in [begin, end) into the first
+      one and destroys the others */
+  void merge_run(size_t begin, size_t end);
+
 private:
   DrawingContext& m_context;
   obstack& m_obst;
   std::vector<DrawingRequest*> m_requests;
 
+  /** Scratch space for sort_requests() */
+  std::vector<DrawingRequest*> m_sorted_requests;
+  std::vector<size_t> m_layer_offsets;
+
+  /** Number of requests after the last sort, rendering the same
+      requests once more doesn't need another sort */
+  size_t m_sorted_count;
+
 private:
   Canvas(const Canvas&) = delete;
   Canvas& operator=(const Canvas&) = delete;
@@ -18,6 +18,7 @@
 #include "video/compositor.hpp"
 
 #include "math/rect.hpp"
+#include "util/profiler.hpp"
 #include "video/drawing_request.hpp"
 #include "video/painter.hpp"
 #include "video/renderer.hpp"
@@ -28,6 +29,7 @@ bool Compositor::s_render_lighting = true;
 Compositor::Compositor(VideoSystem& video_system) :
   m_video_system(video_system),
   m_obst(),
+  m_context_pool(),
   m_drawing_contexts()
 {
   obstack_init(&m_obst);
@@ -36,23 +38,49 @@ Compositor::Compositor(VideoSystem& video_system) :
 Compositor::~Compositor()
 {
   m_drawing_contexts.clear();
+  m_context_pool.clear();
   obstack_free(&m_obst, nullptr);
 }
 
+void
+Compositor::start_frame()
+{
+  // the requests have to be destroyed before their memory is reused
+  for (auto* ctx : m_drawing_contexts)
+  {
+    ctx->clear();
+  }
+  m_drawing_contexts.clear();
+
+  obstack_reset(m_obst);
+}
+
 DrawingContext&
 Compositor::make_context(bool overlay)
 {
-  m_drawing_contexts.emplace_back(new DrawingContext(m_video_system, m_obst, overlay));
+  if (m_drawing_contexts.size() < m_context_pool.size())
+  {
+    DrawingContext& ctx = *m_context_pool[m_drawing_contexts.size()];
+    ctx.reset(overlay);
+    m_drawing_contexts.push_back(&ctx);
+  }
+  else
+  {
+    m_context_pool.emplace_back(new DrawingContext(m_video_system, m_obst, overlay));
+    m_drawing_contexts.push_back(m_context_pool.back().get());
+  }
   return *m_drawing_contexts.back();
 }
 
 void
 Compositor::render()
 {
+  ProfileZone profile_zone("Compositor::render");
+
   auto& lightmap = m_video_system.get_lightmap();
 
   bool use_lightmap = std::any_of(m_drawing_contexts.begin(), m_drawing_contexts.end(),
-                                  [](std::unique_ptr<DrawingContext>& ctx){
+                                  [](DrawingContext* ctx){
                                     return ctx->use_lightmap();
                                   });
 
@@ -64,7 +92,7 @@ Compositor::render()
     lightmap.start_draw();
     Painter& painter = lightmap.get_painter();
 
-    for (auto& ctx : m_drawing_contexts)
+    for (auto* ctx : m_drawing_contexts)
     {
       if (!ctx->is_overlay())
       {
@@ -86,7 +114,7 @@ Compositor::render()
 
     Painter& painter = back_renderer->get_painter();
 
-    for (auto& ctx : m_drawing_contexts)
+    for (auto* ctx : m_drawing_contexts)
     {
       painter.set_clip_rect(ctx->get_viewport());
       ctx->color().render(*back_renderer, Canvas::BELOW_LIGHTMAP);
@@ -103,7 +131,7 @@ Compositor::render()
     renderer.start_draw();
     Painter& painter = renderer.get_painter();
 
-    for (auto& ctx : m_drawing_contexts)
+    for (auto* ctx : m_drawing_contexts)
     {
       painter.set_clip_rect(ctx->get_viewport());
       ctx->color().render(renderer, Canvas::BELOW_LIGHTMAP);
@@ -122,11 +150,14 @@ Compositor::render()
         request.alpha = 1.0f;
         request.blend = Blend::MOD;
 
-        request.srcrects.emplace_back(0.0f, 0.0f,
-                                      static_cast<float>(texture->get_image_width()),
-                                      static_cast<float>(texture->get_image_height()));
-        request.dstrects.emplace_back(Vector(0.0f, 0.0f), lightmap.get_logical_size());
-        request.angles.emplace_back(0.0f);
+        Rectf srcrect(0.0f, 0.0f,
+                      static_cast<float>(texture->get_image_width()),
+                      static_cast<float>(texture->get_image_height()));
+        Rectf dstrect(Vector(0.0f, 0.0f), lightmap.get_logical_size());
+        float angle = 0.0f;
+        request.srcrects = Span<Rectf>(&srcrect, 1);
+        request.dstrects = Span<Rectf>(&dstrect, 1);
+        request.angles = Span<float>(&angle, 1);
 
         request.texture = texture.get();
         request.color = Color::WHITE;
@@ -136,7 +167,7 @@ Compositor::render()
     }
 
     // Render overlay elements
-    for (auto& ctx : m_drawing_contexts)
+    for (auto* ctx : m_drawing_contexts)
     {
       painter.set_clip_rect(ctx->get_viewport());
       ctx->color().render(renderer, Canvas::ABOVE_LIGHTMAP);
@@ -146,15 +177,7 @@ Compositor::render()
     renderer.end_draw();
   }
 
-  // cleanup
-  for (auto& ctx : m_drawing_contexts)
-  {
-    ctx->clear();
-  }
   m_video_system.flip();
-
-  obstack_free(&m_obst, nullptr);
-  obstack_init(&m_obst);
 }
 
 /* EOF */
@@ -36,6 +36,11 @@ public:
   Compositor(VideoSystem& video_system);
   ~Compositor();
 
+  /** Forgets the contexts and requests of the previous frame. Their
+      memory is kept, so that drawing a frame like the previous one
+      doesn't allocate anything. */
+  void start_frame();
+
   void render();
 
   /** Create a DrawingContext, if overlay is true the context will not
@@ -50,7 +55,11 @@ private:
   /* obstack holding the memory of the drawing requests */
   obstack m_obst;
 
-  std::vector<std::unique_ptr<DrawingContext> > m_drawing_contexts;
+  /** All contexts ever made, reused by make_context() */
+  std::vector<std::unique_ptr<DrawingContext> > m_context_pool;
+
+  /** Contexts made for the current frame */
+  std::vector<DrawingContext*> m_drawing_contexts;
 
 private:
   Compositor(const Compositor&) = delete;
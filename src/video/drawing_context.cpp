@@ -45,6 +45,19 @@ DrawingContext::~DrawingContext()
   clear();
 }
 
+void
+DrawingContext::reset(bool overlay)
+{
+  clear();
+  m_overlay = overlay;
+  m_viewport = Rect(0, 0,
+                    m_video_system.get_viewport().get_screen_width(),
+                    m_video_system.get_viewport().get_screen_height());
+  m_ambient_color = Color::WHITE;
+  m_transform_stack.resize(1);
+  m_transform_stack.front() = DrawingTransform();
+}
+
 void
 DrawingContext::set_ambient_color(Color ambient_color)
 {
@@ -45,6 +45,10 @@ public:
   DrawingContext(VideoSystem& video_system, obstack& obst, bool overlay);
   ~DrawingContext();
 
+  /** Brings the context back to the state of a new one, used by the
+      Compositor to reuse it in the next frame */
+  void reset(bool overlay);
+
   /** Returns the visible area in world coordinates */
   Rectf get_cliprect() const;
 
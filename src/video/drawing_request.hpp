@@ -23,6 +23,7 @@
 #include "math/rectf.hpp"
 #include "math/sizef.hpp"
 #include "math/vector.hpp"
+#include "util/span.hpp"
 #include "video/color.hpp"
 #include "video/drawing_context.hpp"
 #include "video/font.hpp"
@@ -68,9 +69,13 @@ struct TextureRequest : public DrawingRequest
 
   const Texture* texture;
   const Texture* displacement_texture;
-  std::vector<Rectf> srcrects;
-  std::vector<Rectf> dstrects;
-  std::vector<float> angles;
+
+  /** Arrays of the same size, they live on the obstack of the
+      Compositor like the request itself */
+  Span<Rectf> srcrects;
+  Span<Rectf> dstrects;
+  Span<float> angles;
+
   Color color;
 
 private:
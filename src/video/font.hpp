@@ -54,6 +54,15 @@ public:
 
   virtual void draw_text(Canvas& canvas, const std::string& text,
                          const Vector& pos, FontAlignment alignment, int layer, const Color& color) = 0;
+
+  /** Like draw_text(), for text that changes often, like counters and
+      timers. Fonts that keep a texture per string draw it glyph by
+      glyph instead. */
+  virtual void draw_dynamic_text(Canvas& canvas, const std::string& text,
+                                 const Vector& pos, FontAlignment alignment, int layer, const Color& color)
+  {
+    draw_text(canvas, text, pos, alignment, layer, color);
+  }
 };
 
 #endif
@@ -20,6 +20,7 @@
 #include <sstream>
 
 #include "video/sdl/sdl_screen_renderer.hpp"
+#include "video/sdl_surface_ptr.hpp"
 #include "video/video_system.hpp"
 
 SDLTexture::SDLTexture(SDL_Texture* texture, int width, int height, const Sampler& sampler) :
@@ -54,4 +55,27 @@ SDLTexture::~SDLTexture()
   SDL_DestroyTexture(m_texture);
 }
 
+void
+SDLTexture::update(const SDL_Surface& image, int x, int y)
+{
+  Uint32 format;
+  SDL_QueryTexture(m_texture, &format, nullptr, nullptr, nullptr);
+
+  SDLSurfacePtr convert(SDL_ConvertSurfaceFormat(const_cast<SDL_Surface*>(&image), format, 0));
+  if (!convert)
+  {
+    std::ostringstream msg;
+    msg << "couldn't convert image for texture update: " << SDL_GetError();
+    throw std::runtime_error(msg.str());
+  }
+
+  SDL_Rect rect{x, y, image.w, image.h};
+  if (SDL_UpdateTexture(m_texture, &rect, convert->pixels, convert->pitch) != 0)
+  {
+    std::ostringstream msg;
+    msg << "couldn't update texture: " << SDL_GetError();
+    throw std::runtime_error(msg.str());
+  }
+}
+
 /* EOF */
@@ -74,16 +74,9 @@ Surface::from_file(const std::string& filename, const boost::optional<Rect>& rec
   }
   else
   {
-    if (rect)
-    {
-      TexturePtr texture = TextureManager::current()->get(filename, *rect);
-      return SurfacePtr(new Surface(texture, TexturePtr(), NO_FLIP, filename));
-    }
-    else
-    {
-      TexturePtr texture = TextureManager::current()->get(filename);
-      return SurfacePtr(new Surface(texture, TexturePtr(), NO_FLIP, filename));
-    }
+    Rect region;
+    TexturePtr texture = TextureManager::current()->get_packed(filename, rect, region);
+    return SurfacePtr(new Surface(texture, TexturePtr(), region, NO_FLIP, filename));
   }
 }
 
@@ -135,7 +128,7 @@ Surface::region(const Rect& rect) const
 {
   SurfacePtr surface(new Surface(m_diffuse_texture,
                                  m_displacement_texture,
-                                 rect,
+                                 rect.moved(m_region.left, m_region.top),
                                  m_flip));
   return surface;
 }
@@ -46,11 +46,14 @@ private:
 public:
   ~Surface();
 
+  /** Returns a part of this surface, rect is relative to the surface */
   SurfacePtr region(const Rect& rect) const;
   SurfacePtr clone(Flip flip = NO_FLIP) const;
 
   TexturePtr get_texture() const;
   TexturePtr get_displacement_texture() const;
+  /** The part of the texture this surface shows, which is only a
+      small part of it when the image was packed into an atlas */
   Rect get_region() const { return m_region; }
   int get_width() const;
   int get_height() const;
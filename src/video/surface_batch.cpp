@@ -16,7 +16,10 @@
 
 #include "video/surface_batch.hpp"
 
+#include <algorithm>
+
 #include "math/rectf.hpp"
+#include "video/canvas.hpp"
 #include "video/surface.hpp"
 
 SurfaceBatch::SurfaceBatch(const SurfacePtr& surface, const Color& color) :
@@ -58,4 +61,48 @@ SurfaceBatch::draw(const Rectf& srcrect, const Rectf& dstrect, float angle)
   m_angles.emplace_back(angle);
 }
 
+void
+SurfaceBatch::clear()
+{
+  m_srcrects.clear();
+  m_dstrects.clear();
+  m_angles.clear();
+}
+
+SurfaceBatches::SurfaceBatches() :
+  m_batches()
+{
+}
+
+SurfaceBatch&
+SurfaceBatches::get(const SurfacePtr& surface, const Color& color)
+{
+  for (auto& batch : m_batches)
+  {
+    if (batch.get_surface() == surface && batch.get_color() == color)
+      return batch;
+  }
+
+  m_batches.emplace_back(surface, color);
+  return m_batches.back();
+}
+
+void
+SurfaceBatches::draw(Canvas& canvas, int layer)
+{
+  m_batches.erase(std::remove_if(m_batches.begin(), m_batches.end(),
+                                 [](const SurfaceBatch& batch) {
+                                   return batch.empty();
+                                 }),
+                  m_batches.end());
+
+  for (auto& batch : m_batches)
+  {
+    canvas.draw_surface_batch(batch.get_surface(), batch.get_srcrects(),
+                              batch.get_dstrects(), batch.get_angles(),
+                              batch.get_color(), layer);
+    batch.clear();
+  }
+}
+
 /* EOF */
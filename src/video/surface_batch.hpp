@@ -23,6 +23,7 @@
 #include "video/paint_style.hpp"
 #include "video/surface_ptr.hpp"
 
+class Canvas;
 class Rectf;
 
 class SurfaceBatch
@@ -30,17 +31,24 @@ class SurfaceBatch
 public:
   SurfaceBatch(const SurfacePtr& surface, const Color& color = Color::WHITE);
   SurfaceBatch(SurfaceBatch&&) = default;
+  SurfaceBatch& operator=(SurfaceBatch&&) = default;
 
   void draw(const Vector& pos, float angle = 0.0f);
   void draw(const Rectf& dstrect, float angle = 0.0f);
   void draw(const Rectf& srcrect, const Rectf& dstrect, float angle = 0.0f);
 
-  std::vector<Rectf> move_srcrects() { return std::move(m_srcrects); }
-  std::vector<Rectf> move_dstrects() { return std::move(m_dstrects); }
-  std::vector<float> move_angles() { return std::move(m_angles); }
+  const std::vector<Rectf>& get_srcrects() const { return m_srcrects; }
+  const std::vector<Rectf>& get_dstrects() const { return m_dstrects; }
+  const std::vector<float>& get_angles() const { return m_angles; }
 
+  const SurfacePtr& get_surface() const { return m_surface; }
   Color get_color() const { return m_color; }
 
+  bool empty() const { return m_srcrects.empty(); }
+
+  /** Forgets the rects, but keeps their memory */
+  void clear();
+
 private:
   SurfacePtr m_surface;
   Color m_color;
@@ -53,6 +61,30 @@ private:
   SurfaceBatch& operator=(const SurfaceBatch&) = delete;
 };
 
+/** The batches of an object that draws many surfaces each frame, like
+    a particle system. They are kept from one frame to the next, so
+    that drawing doesn't have to allocate their arrays again. */
+class SurfaceBatches final
+{
+public:
+  SurfaceBatches();
+
+  /** Returns the batch of surface drawn in color, there are only a
+      few of them, so they are searched linearly */
+  SurfaceBatch& get(const SurfacePtr& surface, const Color& color = Color::WHITE);
+
+  /** Draws and empties the batches, the ones that weren't used since
+      the last call are dropped */
+  void draw(Canvas& canvas, int layer);
+
+private:
+  std::vector<SurfaceBatch> m_batches;
+
+private:
+  SurfaceBatches(const SurfaceBatches&) = delete;
+  SurfaceBatches& operator=(const SurfaceBatches&) = delete;
+};
+
 #endif
 
 /* EOF */
@@ -24,6 +24,8 @@
 #include "math/rect.hpp"
 #include "video/flip.hpp"
 
+struct SDL_Surface;
+
 /** This class is a wrapper around a texture handle. It stores the
     texture width and height and provides convenience functions for
     uploading SDL_Surfaces into the texture. */
@@ -47,6 +49,10 @@ public:
   virtual int get_image_width() const = 0;
   virtual int get_image_height() const = 0;
 
+  /** Replaces the pixels at x, y with the content of image, used to
+      fill atlas textures one image at a time */
+  virtual void update(const SDL_Surface& image, int x, int y) = 0;
+
 private:
   boost::optional<Key> m_cache_key;
 
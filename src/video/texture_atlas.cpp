@@ -0,0 +1,144 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "video/texture_atlas.hpp"
+
+#include <SDL.h>
+#include <algorithm>
+
+#include "video/sdl_surface.hpp"
+#include "video/video_system.hpp"
+
+TextureAtlas::TextureAtlas() :
+  m_pages(),
+  m_entries()
+{
+}
+
+TexturePtr
+TextureAtlas::find(const Texture::Key& key, Rect& region) const
+{
+  auto it = m_entries.find(key);
+  if (it == m_entries.end())
+    return TexturePtr();
+
+  region = it->second.region;
+  return m_pages[it->second.page]->texture;
+}
+
+TexturePtr
+TextureAtlas::add(const Texture::Key& key, const SDL_Surface& image, const Rect& src_rect, Rect& region)
+{
+  const int w = src_rect.get_width();
+  const int h = src_rect.get_height();
+  if (w > MAX_IMAGE_SIZE || h > MAX_IMAGE_SIZE)
+    return TexturePtr();
+
+  Rect rect;
+  const size_t page = get_page(Size(w + 2, h + 2), rect);
+
+  SDLSurfacePtr padded = SDLSurface::create_rgba(w + 2, h + 2);
+  SDL_Surface* src = const_cast<SDL_Surface*>(&image);
+  SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+
+  auto copy = [src, &src_rect, &padded](int sx, int sy, int w_, int h_, int dx, int dy)
+  {
+    SDL_Rect srcrect{src_rect.left + sx, src_rect.top + sy, w_, h_};
+    SDL_Rect dstrect{dx, dy, w_, h_};
+    SDL_BlitSurface(src, &srcrect, padded.get(), &dstrect);
+  };
+
+  copy(0, 0, w, h, 1, 1);
+
+  // repeat the outermost pixels into the border
+  copy(0, 0, w, 1, 1, 0);
+  copy(0, h - 1, w, 1, 1, h + 1);
+  copy(0, 0, 1, h, 0, 1);
+  copy(w - 1, 0, 1, h, w + 1, 1);
+  copy(0, 0, 1, 1, 0, 0);
+  copy(w - 1, 0, 1, 1, w + 1, 0);
+  copy(0, h - 1, 1, 1, 0, h + 1);
+  copy(w - 1, h - 1, 1, 1, w + 1, h + 1);
+
+  m_pages[page]->texture->update(*padded, rect.left, rect.top);
+
+  region = Rect(rect.left + 1, rect.top + 1, Size(w, h));
+  m_entries[key] = Entry{page, region};
+
+  return m_pages[page]->texture;
+}
+
+size_t
+TextureAtlas::get_page(const Size& size, Rect& rect)
+{
+  for (size_t i = 0; i < m_pages.size(); ++i)
+  {
+    if (auto free_rect = m_pages[i]->packer.insert(size))
+    {
+      rect = *free_rect;
+      return i;
+    }
+  }
+
+  // Only the atlas holds on to the page, so everything on it can go
+  for (size_t i = 0; i < m_pages.size(); ++i)
+  {
+    if (m_pages[i]->texture.use_count() == 1)
+    {
+      reset_page(i);
+      rect = *m_pages[i]->packer.insert(size);
+      return i;
+    }
+  }
+
+  SDLSurfacePtr blank = SDLSurface::create_rgba(PAGE_SIZE, PAGE_SIZE);
+  m_pages.push_back(std::make_unique<Page>(VideoSystem::current()->new_texture(*blank)));
+  rect = *m_pages.back()->packer.insert(size);
+  return m_pages.size() - 1;
+}
+
+void
+TextureAtlas::reset_page(size_t page)
+{
+  m_pages[page]->packer.clear();
+
+  for (auto it = m_entries.begin(); it != m_entries.end();)
+  {
+    if (it->second.page == page)
+      it = m_entries.erase(it);
+    else
+      ++it;
+  }
+}
+
+void
+TextureAtlas::debug_print(std::ostream& out) const
+{
+  out << "atlas:begin" << std::endl;
+  for (size_t i = 0; i < m_pages.size(); ++i)
+  {
+    const size_t count = std::count_if(m_entries.begin(), m_entries.end(),
+                                       [i](const std::pair<const Texture::Key, Entry>& entry) {
+                                         return entry.second.page == i;
+                                       });
+    out << "  page " << i << ": " << count << " images, "
+        << m_pages[i]->texture.use_count() - 1 << " references" << std::endl;
+  }
+  out << "atlas:end: " << m_pages.size() << " pages of "
+      << PAGE_SIZE << "x" << PAGE_SIZE << std::endl;
+}
+
+/* EOF */
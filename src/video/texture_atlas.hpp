@@ -0,0 +1,92 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_VIDEO_TEXTURE_ATLAS_HPP
+#define HEADER_SUPERTUX_VIDEO_TEXTURE_ATLAS_HPP
+
+#include <map>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#include "math/rect.hpp"
+#include "math/rect_packer.hpp"
+#include "video/texture.hpp"
+#include "video/texture_ptr.hpp"
+
+struct SDL_Surface;
+
+/** Packs small images into a few large textures ("pages"), so that
+    drawing many different tiles and sprites doesn't require switching
+    textures all the time. Each image gets a one pixel border copied
+    from its edges, which keeps filtering from bleeding neighbouring
+    images into it. */
+class TextureAtlas final
+{
+public:
+  static const int PAGE_SIZE = 1024;
+
+  /** Larger images get a texture of their own */
+  static const int MAX_IMAGE_SIZE = 256;
+
+public:
+  TextureAtlas();
+
+  /** Returns the page holding the image packed under key and sets
+      region to where it is, nullptr if it isn't in the atlas */
+  TexturePtr find(const Texture::Key& key, Rect& region) const;
+
+  /** Copies the part src_rect of image into one of the pages and
+      returns it, or returns nullptr if it is too large for the atlas */
+  TexturePtr add(const Texture::Key& key, const SDL_Surface& image, const Rect& src_rect, Rect& region);
+
+  void debug_print(std::ostream& out) const;
+
+private:
+  struct Page
+  {
+    Page(const TexturePtr& texture_) :
+      texture(texture_),
+      packer(PAGE_SIZE, PAGE_SIZE)
+    {}
+
+    TexturePtr texture;
+    RectPacker packer;
+  };
+
+  struct Entry
+  {
+    size_t page;
+    Rect region;
+  };
+
+  /** Returns a page with room for an image of the given size, reusing
+      pages no surface refers to anymore before creating new ones */
+  size_t get_page(const Size& size, Rect& rect);
+  void reset_page(size_t page);
+
+private:
+  std::vector<std::unique_ptr<Page> > m_pages;
+  std::map<Texture::Key, Entry> m_entries;
+
+private:
+  TextureAtlas(const TextureAtlas&) = delete;
+  TextureAtlas& operator=(const TextureAtlas&) = delete;
+};
+
+#endif
+
+/* EOF */
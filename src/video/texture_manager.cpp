@@ -77,7 +77,10 @@ GLenum string2filter(const std::string& text)
 
 TextureManager::TextureManager() :
   m_image_textures(),
-  m_surfaces()
+  m_surfaces(),
+  m_atlas(),
+  m_preload_mutex(),
+  m_preloaded_surfaces()
 {
 }
 
@@ -92,6 +95,7 @@ TextureManager::~TextureManager()
   }
   m_image_textures.clear();
   m_surfaces.clear();
+  clear_preloaded();
 }
 
 TexturePtr
@@ -238,6 +242,62 @@ TextureManager::get(const std::string& _filename,
   return texture;
 }
 
+TexturePtr
+TextureManager::get_packed(const std::string& _filename, const boost::optional<Rect>& rect, Rect& region)
+{
+  const std::string filename = FileSystem::normalize(_filename);
+  const Texture::Key key(filename, rect ? *rect : Rect());
+
+  if (TexturePtr texture = m_atlas.find(key, region))
+    return texture;
+
+  // Images too large for the atlas end up in the regular cache
+  auto i = m_image_textures.find(key);
+  if (i != m_image_textures.end())
+  {
+    if (TexturePtr texture = i->second.lock())
+    {
+      region = Rect(0, 0, texture->get_image_width(), texture->get_image_height());
+      return texture;
+    }
+  }
+
+  try
+  {
+    if (rect)
+    {
+      const SDL_Surface& image = get_surface(filename);
+      if (Rect(0, 0, image.w, image.h).contains(*rect))
+      {
+        if (TexturePtr texture = m_atlas.add(key, image, *rect, region))
+          return texture;
+      }
+    }
+    else
+    {
+      SDLSurfacePtr image = load_surface(filename);
+      const Rect image_rect(0, 0, image->w, image->h);
+      if (TexturePtr texture = m_atlas.add(key, *image, image_rect, region))
+        return texture;
+
+      // Don't decode the image a second time in get()
+      TexturePtr texture = VideoSystem::current()->new_texture(*image, Sampler());
+      texture->m_cache_key = key;
+      m_image_textures[key] = texture;
+      region = image_rect;
+      return texture;
+    }
+  }
+  catch(const std::exception&)
+  {
+    // get() reports the error and falls back to the dummy texture
+  }
+
+  TexturePtr texture = get(filename, rect);
+  region = Rect(0, 0, texture->get_image_width(), texture->get_image_height());
+  return texture;
+}
+
 void
 TextureManager::reap_cache_entry(const Texture::Key& key)
 {
@@ -277,7 +337,7 @@ TextureManager::get_surface(const std::string& filename)
   }
   else
   {
-    SDLSurfacePtr image = SDLSurface::from_file(filename);
+    SDLSurfacePtr image = load_surface(filename);
     if (!image)
     {
       std::ostringstream msg;
@@ -289,6 +349,23 @@ TextureManager::get_surface(const std::string& filename)
   }
 }
 
+SDLSurfacePtr
+TextureManager::load_surface(const std::string& filename)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_preload_mutex);
+    auto it = m_preloaded_surfaces.find(filename);
+    if (it != m_preloaded_surfaces.end())
+    {
+      SDLSurfacePtr surface = std::move(it->second);
+      m_preloaded_surfaces.erase(it);
+      return surface;
+    }
+  }
+
+  return SDLSurface::from_file(filename);
+}
+
 TexturePtr
 TextureManager::create_image_texture_raw(const std::string& filename, const Rect& rect, const Sampler& sampler)
 {
@@ -369,7 +446,7 @@ TextureManager::create_image_texture(const std::string& filename, const Sampler&
 TexturePtr
 TextureManager::create_image_texture_raw(const std::string& filename, const Sampler& sampler)
 {
-  SDLSurfacePtr image = SDLSurface::from_file(filename);
+  SDLSurfacePtr image = load_surface(filename);
   if (!image)
   {
     std::ostringstream msg;
@@ -413,9 +490,43 @@ TextureManager::create_dummy_texture()
   }
 }
 
+void
+TextureManager::preload(const std::string& _filename)
+{
+  const std::string filename = FileSystem::normalize(_filename);
+
+  {
+    std::lock_guard<std::mutex> lock(m_preload_mutex);
+    if (m_preloaded_surfaces.find(filename) != m_preloaded_surfaces.end())
+      return;
+  }
+
+  SDLSurfacePtr image;
+  try
+  {
+    image = SDLSurface::from_file(filename);
+  }
+  catch(const std::exception&)
+  {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(m_preload_mutex);
+  m_preloaded_surfaces.emplace(filename, std::move(image));
+}
+
+void
+TextureManager::clear_preloaded()
+{
+  std::lock_guard<std::mutex> lock(m_preload_mutex);
+  m_preloaded_surfaces.clear();
+}
+
 void
 TextureManager::debug_print(std::ostream& out) const
 {
+  m_atlas.debug_print(out);
+
   size_t total_texture_pixels = 0;
   out << "textures:begin" << std::endl;
   for(const auto& it : m_image_textures)
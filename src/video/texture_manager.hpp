@@ -20,6 +20,7 @@
 #include <config.h>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <set>
 #include <string>
@@ -31,6 +32,7 @@
 #include "video/sampler.hpp"
 #include "video/sdl_surface_ptr.hpp"
 #include "video/texture.hpp"
+#include "video/texture_atlas.hpp"
 #include "video/texture_ptr.hpp"
 
 class GLTexture;
@@ -52,10 +54,28 @@ public:
                  const boost::optional<Rect>& rect,
                  const Sampler& sampler = Sampler());
 
+  /** Like get(), but small images get packed into a shared atlas
+      texture, region is set to where the image is on the returned
+      texture */
+  TexturePtr get_packed(const std::string& filename, const boost::optional<Rect>& rect, Rect& region);
+
+  /** Decodes the image into memory so that the next get() of it only
+      has to upload it to the GPU. Unlike the rest of the
+      TextureManager this may be called from any thread. Errors are
+      ignored here, they get reported once the texture is requested. */
+  void preload(const std::string& filename);
+
+  /** Frees preloaded images that were never requested */
+  void clear_preloaded();
+
   void debug_print(std::ostream& out) const;
 
 private:
   const SDL_Surface& get_surface(const std::string& filename);
+
+  /** Returns the preloaded image if there is one, decodes it otherwise */
+  SDLSurfacePtr load_surface(const std::string& filename);
+
   void reap_cache_entry(const Texture::Key& key);
 
   TexturePtr create_image_texture(const std::string& filename, const Rect& rect, const Sampler& sampler);
@@ -72,6 +92,10 @@ private:
 private:
   std::map<Texture::Key, std::weak_ptr<Texture> > m_image_textures;
   std::map<std::string, SDLSurfacePtr> m_surfaces;
+  TextureAtlas m_atlas;
+
+  std::mutex m_preload_mutex;
+  std::map<std::string, SDLSurfacePtr> m_preloaded_surfaces;
 
 private:
   TextureManager(const TextureManager&) = delete;
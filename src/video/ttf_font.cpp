@@ -25,6 +25,7 @@
 #include "physfs/physfs_sdl.hpp"
 #include "video/canvas.hpp"
 #include "video/surface.hpp"
+#include "video/ttf_glyph_cache.hpp"
 #include "video/ttf_surface_manager.hpp"
 
 TTFFont::TTFFont(const std::string& filename, int font_size, float line_spacing, int shadow_size, int border) :
@@ -33,7 +34,8 @@ TTFFont::TTFFont(const std::string& filename, int font_size, float line_spacing,
   m_font_size(font_size),
   m_line_spacing(line_spacing),
   m_shadow_size(shadow_size),
-  m_border(border)
+  m_border(border),
+  m_glyph_cache()
 {
   m_font = TTF_OpenFontRW(get_physfs_SDLRWops(m_filename), 1, font_size);
   if (!m_font)
@@ -131,6 +133,46 @@ TTFFont::draw_text(Canvas& canvas, const std::string& text,
   }
 }
 
+void
+TTFFont::draw_dynamic_text(Canvas& canvas, const std::string& text,
+                           const Vector& pos, FontAlignment alignment, int layer, const Color& color)
+{
+  if (!m_glyph_cache) {
+    m_glyph_cache.reset(new TTFGlyphCache(*this));
+  }
+
+  float last_y = pos.y - (static_cast<float>(TTF_FontHeight(m_font)) - get_height()) / 2.0f;
+
+  LineIterator iter(text);
+  while (iter.next())
+  {
+    const std::string& line = iter.get();
+
+    if (!line.empty())
+    {
+      Vector new_pos(pos.x, last_y);
+
+      if (alignment == ALIGN_CENTER)
+      {
+        new_pos.x -= m_glyph_cache->get_line_width(line) / 2.0f;
+      }
+      else if (alignment == ALIGN_RIGHT)
+      {
+        new_pos.x -= m_glyph_cache->get_line_width(line);
+      }
+
+      if (!m_glyph_cache->draw_line(canvas, line, glm::floor(new_pos), layer, color))
+      {
+        // fall back to a texture for the whole line
+        draw_text(canvas, line, Vector(pos.x, last_y + (static_cast<float>(TTF_FontHeight(m_font)) - get_height()) / 2.0f),
+                  alignment, layer, color);
+      }
+    }
+
+    last_y += get_height();
+  }
+}
+
 std::string
 TTFFont::wrap_to_width(const std::string& text, float width, std::string* overflow)
 {
@@ -19,6 +19,7 @@
 #define HEADER_SUPERTUX_VIDEO_TTF_FONT_HPP
 
 #include <SDL_ttf.h>
+#include <memory>
 
 #include "math/fwd.hpp"
 #include "video/color.hpp"
@@ -26,6 +27,7 @@
 
 class Canvas;
 class Painter;
+class TTFGlyphCache;
 
 class TTFFont final : public Font
 {
@@ -48,6 +50,8 @@ public:
 
   virtual void draw_text(Canvas& canvas, const std::string& text,
                          const Vector& pos, FontAlignment alignment, int layer, const Color& color) override;
+  virtual void draw_dynamic_text(Canvas& canvas, const std::string& text,
+                                 const Vector& pos, FontAlignment alignment, int layer, const Color& color) override;
 
   int get_shadow_size() const { return m_shadow_size; }
   int get_border() const { return m_border; }
@@ -62,6 +66,9 @@ private:
   int m_shadow_size;
   int m_border;
 
+  /** Created on first use of draw_dynamic_text() */
+  std::unique_ptr<TTFGlyphCache> m_glyph_cache;
+
 private:
   TTFFont(const TTFFont&) = delete;
   TTFFont& operator=(const TTFFont&) = delete;
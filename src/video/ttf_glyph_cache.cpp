@@ -0,0 +1,196 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "video/ttf_glyph_cache.hpp"
+
+#include <SDL_ttf.h>
+#include <algorithm>
+
+#include "util/log.hpp"
+#include "util/utf8_iterator.hpp"
+#include "video/canvas.hpp"
+#include "video/sdl_surface_ptr.hpp"
+#include "video/surface.hpp"
+#include "video/ttf_font.hpp"
+#include "video/ttf_surface.hpp"
+
+TTFGlyphCache::TTFGlyphCache(const TTFFont& font) :
+  m_font(font),
+  m_atlas(),
+  m_pages(),
+  m_glyphs(),
+  m_decorations(),
+  m_cores()
+{
+}
+
+bool
+TTFGlyphCache::draw_line(Canvas& canvas, const std::string& line, const Vector& pos,
+                         int layer, const Color& color)
+{
+  for (auto& quads : m_decorations)
+    quads.clear();
+  for (auto& quads : m_cores)
+    quads.clear();
+
+  float x = pos.x;
+  uint16_t prev = 0;
+  for (UTF8Iterator it(line); !it.done(); ++it)
+  {
+    if (*it > 0xFFFF)
+      return false;
+
+    const auto chr = static_cast<uint16_t>(*it);
+    const Glyph& glyph = get_glyph(chr);
+    if (!glyph.supported)
+      return false;
+
+    if (prev) {
+      x += static_cast<float>(TTF_GetFontKerningSizeGlyphs(m_font.get_ttf_font(), prev, chr));
+    }
+
+    const Vector glyph_pos(x + static_cast<float>(glyph.offset_x), pos.y);
+    if (glyph.decoration_page >= 0)
+    {
+      auto& quads = get_quads(m_decorations, glyph.decoration_page);
+      quads.srcrects.push_back(glyph.decoration_region);
+      quads.dstrects.push_back(Rectf(glyph_pos, glyph.decoration_region.get_size()));
+    }
+    if (glyph.core_page >= 0)
+    {
+      auto& quads = get_quads(m_cores, glyph.core_page);
+      quads.srcrects.push_back(glyph.core_region);
+      quads.dstrects.push_back(Rectf(glyph_pos, glyph.core_region.get_size()));
+    }
+
+    x += static_cast<float>(glyph.advance);
+    prev = chr;
+  }
+
+  for (size_t page = 0; page < m_decorations.size(); ++page) {
+    if (!m_decorations[page].srcrects.empty()) {
+      canvas.draw_surface_batch(m_pages[page], m_decorations[page].srcrects,
+                                m_decorations[page].dstrects, color, layer);
+    }
+  }
+  for (size_t page = 0; page < m_cores.size(); ++page) {
+    if (!m_cores[page].srcrects.empty()) {
+      canvas.draw_surface_batch(m_pages[page], m_cores[page].srcrects,
+                                m_cores[page].dstrects, color, layer);
+    }
+  }
+
+  return true;
+}
+
+TTFGlyphCache::Quads&
+TTFGlyphCache::get_quads(std::vector<Quads>& pages, int page)
+{
+  // pages get added to the atlas while a line is being laid out
+  if (static_cast<size_t>(page) >= pages.size())
+    pages.resize(page + 1);
+  return pages[page];
+}
+
+float
+TTFGlyphCache::get_line_width(const std::string& line)
+{
+  int width = 0;
+  uint16_t prev = 0;
+  for (UTF8Iterator it(line); !it.done(); ++it)
+  {
+    const auto chr = static_cast<uint16_t>(std::min<uint32_t>(*it, 0xFFFF));
+    if (prev) {
+      width += TTF_GetFontKerningSizeGlyphs(m_font.get_ttf_font(), prev, chr);
+    }
+    width += get_glyph(chr).advance;
+    prev = chr;
+  }
+
+  const int grow = std::max(m_font.get_border() * 2, m_font.get_shadow_size() * 2);
+  return static_cast<float>(width + grow);
+}
+
+const TTFGlyphCache::Glyph&
+TTFGlyphCache::get_glyph(uint16_t chr)
+{
+  auto it = m_glyphs.find(chr);
+  if (it != m_glyphs.end())
+    return it->second;
+
+  Glyph& glyph = m_glyphs[chr];
+  glyph.supported = true;
+  glyph.core_page = -1;
+  glyph.decoration_page = -1;
+  glyph.offset_x = 0;
+  glyph.advance = 0;
+
+  int minx, maxx, miny, maxy;
+  if (TTF_GlyphMetrics(m_font.get_ttf_font(), chr, &minx, &maxx, &miny, &maxy, &glyph.advance) < 0)
+  {
+    log_warning << "Couldn't get metrics of glyph " << chr << ": " << TTF_GetError() << std::endl;
+    return glyph;
+  }
+  // glyphs reaching left of the pen are rendered shifted to the right
+  glyph.offset_x = std::min(0, minx);
+
+  SDLSurfacePtr core(TTF_RenderGlyph_Blended(m_font.get_ttf_font(), chr, SDL_Color{255, 255, 255, 255}));
+  if (!core)
+  {
+    // Nothing to draw, e.g. whitespace
+    return glyph;
+  }
+
+  glyph.core_page = add_to_atlas("core-" + std::to_string(chr), *core, glyph.core_region);
+  if (glyph.core_page < 0)
+  {
+    glyph.supported = false;
+    return glyph;
+  }
+
+  if (m_font.get_border() > 0 || m_font.get_shadow_size() > 0)
+  {
+    SDLSurfacePtr decoration = TTFSurface::decorate(m_font, *core, false);
+    glyph.decoration_page = add_to_atlas("decoration-" + std::to_string(chr), *decoration, glyph.decoration_region);
+    if (glyph.decoration_page < 0) {
+      glyph.supported = false;
+    }
+  }
+
+  return glyph;
+}
+
+int
+TTFGlyphCache::add_to_atlas(const std::string& key, const SDL_Surface& image, Rectf& region)
+{
+  Rect rect;
+  TexturePtr texture = m_atlas.add(Texture::Key(key, Rect()), image, Rect(0, 0, image.w, image.h), rect);
+  if (!texture)
+    return -1;
+
+  region = Rectf(rect);
+
+  for (size_t i = 0; i < m_pages.size(); ++i) {
+    if (m_pages[i]->get_texture() == texture) {
+      return static_cast<int>(i);
+    }
+  }
+
+  m_pages.push_back(Surface::from_texture(texture));
+  return static_cast<int>(m_pages.size()) - 1;
+}
+
+/* EOF */
@@ -0,0 +1,102 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_VIDEO_TTF_GLYPH_CACHE_HPP
+#define HEADER_SUPERTUX_VIDEO_TTF_GLYPH_CACHE_HPP
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "math/rectf.hpp"
+#include "math/vector.hpp"
+#include "video/color.hpp"
+#include "video/surface_ptr.hpp"
+#include "video/texture_atlas.hpp"
+
+class Canvas;
+class TTFFont;
+
+/** Renders each glyph of a TTFFont once into a texture atlas and draws
+    text as a batch of glyphs. Unlike TTFSurfaceManager, which creates a
+    texture per string, this doesn't create new textures for text that
+    changes every frame, like timers, counters or console output. */
+class TTFGlyphCache final
+{
+public:
+  TTFGlyphCache(const TTFFont& font);
+
+  /** Draws a single line of text with its top left corner at pos,
+      returns false if the line contains characters that can't be
+      drawn glyph by glyph */
+  bool draw_line(Canvas& canvas, const std::string& line, const Vector& pos,
+                 int layer, const Color& color);
+
+  /** Width of the line as drawn by draw_line(), including kerning */
+  float get_line_width(const std::string& line);
+
+private:
+  struct Glyph
+  {
+    /** false if the glyph is too large for the atlas */
+    bool supported;
+
+    /** Index into m_pages, -1 for glyphs without pixels */
+    int core_page;
+    Rectf core_region;
+
+    /** Shadow and border of the glyph, drawn before all the cores
+        so that they don't cover neighbouring glyphs */
+    int decoration_page;
+    Rectf decoration_region;
+
+    int offset_x;
+    int advance;
+  };
+
+  struct Quads
+  {
+    void clear() { srcrects.clear(); dstrects.clear(); }
+
+    std::vector<Rectf> srcrects;
+    std::vector<Rectf> dstrects;
+  };
+
+private:
+  const Glyph& get_glyph(uint16_t chr);
+  int add_to_atlas(const std::string& key, const SDL_Surface& image, Rectf& region);
+  Quads& get_quads(std::vector<Quads>& pages, int page);
+
+private:
+  const TTFFont& m_font;
+  TextureAtlas m_atlas;
+  std::vector<SurfacePtr> m_pages;
+  std::unordered_map<uint16_t, Glyph> m_glyphs;
+
+  /** Quads of the line being drawn, indexed by page; kept between
+      calls so that drawing text doesn't allocate once warmed up */
+  std::vector<Quads> m_decorations;
+  std::vector<Quads> m_cores;
+
+private:
+  TTFGlyphCache(const TTFGlyphCache&) = delete;
+  TTFGlyphCache& operator=(const TTFGlyphCache&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -21,6 +21,7 @@
 #include <string>
 
 #include "math/vector.hpp"
+#include "video/sdl_surface_ptr.hpp"
 #include "video/surface_ptr.hpp"
 
 class TTFFont;
@@ -34,6 +35,10 @@ class TTFSurface final
 public:
   static TTFSurfacePtr create(const TTFFont& font, const std::string& text);
 
+  /** Adds the shadow and the border of the font around the white text
+      in text_surface, leaving out the text itself unless with_core is set */
+  static SDLSurfacePtr decorate(const TTFFont& font, SDL_Surface& text_surface, bool with_core = true);
+
 public:
   TTFSurface(const SurfacePtr& surface, const Vector& offset);
 
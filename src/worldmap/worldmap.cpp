@@ -39,6 +39,7 @@
 #include "supertux/game_session.hpp"
 #include "supertux/gameconfig.hpp"
 #include "supertux/level.hpp"
+#include "supertux/level_loading_screen.hpp"
 #include "supertux/menu/menu_storage.hpp"
 #include "supertux/player_status_hud.hpp"
 #include "supertux/resources.hpp"
@@ -400,7 +401,7 @@ WorldMap::update(float dt_sec)
 
           // update state and savegame
           save_state();
-          ScreenManager::current()->push_screen(std::make_unique<GameSession>(levelfile, m_savegame, &level_->get_statistics()),
+          ScreenManager::current()->push_screen(std::make_unique<LevelLoadingScreen>(levelfile, m_savegame, &level_->get_statistics()),
                                                 std::make_unique<ShrinkFade>(shrinkpos, 1.0f));
 
           m_in_level = true;
@@ -26,6 +26,7 @@
 #include "object/tilemap.hpp"
 #include "physfs/physfs_file_system.hpp"
 #include "physfs/util.hpp"
+#include "supertux/level_metadata_index.hpp"
 #include "supertux/tile_manager.hpp"
 #include "util/file_system.hpp"
 #include "util/log.hpp"
@@ -185,15 +186,10 @@ WorldMapParser::load_level_information(LevelTile& level)
     }
 
     register_translation_directory(filename);
-    auto doc = ReaderDocument::from_file(filename);
-    auto root = doc.get_root();
-    if (root.get_name() != "supertux-level") {
-      return;
-    } else {
-      auto level_mapping = root.get_mapping();
-      level_mapping.get("name", level.m_title);
-      level_mapping.get("target-time", level.m_target_time);
-    }
+    const auto& metadata = LevelMetadataIndex::current()->get(filename);
+    if (!metadata.name.empty())
+      level.m_title = metadata.get_name();
+    level.m_target_time = metadata.target_time;
   } catch(std::exception& e) {
     log_warning << "Problem when reading level information: " << e.what() << std::endl;
     return;
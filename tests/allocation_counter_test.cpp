@@ -0,0 +1,103 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "math/rectf.hpp"
+#include "test_video_system.hpp"
+#include "util/allocation_counter.hpp"
+#include "video/compositor.hpp"
+#include "video/drawing_context.hpp"
+#include "video/layer.hpp"
+#include "video/null/null_texture.hpp"
+#include "video/surface.hpp"
+#include "video/surface_batch.hpp"
+
+namespace {
+
+/** Draws a frame like the ones of a level: many sprites, tiles drawn
+    as batches, a particle system, the light and the HUD */
+void
+draw_frame(Compositor& compositor, const SurfacePtr& surface,
+           const std::vector<Rectf>& tiles, SurfaceBatches& particles)
+{
+  compositor.start_frame();
+
+  DrawingContext& context = compositor.make_context();
+  context.set_ambient_color(Color(0.5f, 0.5f, 0.5f));
+  context.push_transform();
+  context.set_translation(Vector(100.0f, 0.0f));
+
+  context.color().draw_surface_batch(surface, tiles, tiles, Color::WHITE, LAYER_TILES);
+  for (int i = 0; i < 300; ++i)
+  {
+    const Vector pos(static_cast<float>(i * 4), static_cast<float>(i % 20));
+    context.color().draw_surface(surface, pos, LAYER_OBJECTS + i % 3);
+    context.light().draw_surface(surface, pos, LAYER_OBJECTS);
+    particles.get(surface, Color(1.0f, 1.0f, 1.0f, (i % 2) ? 1.0f : 0.5f))
+      .draw(pos, static_cast<float>(i));
+  }
+  particles.draw(context.color(), LAYER_BACKGROUND1);
+  context.pop_transform();
+
+  DrawingContext& hud = compositor.make_context(true);
+  hud.color().draw_filled_rect(Rectf(0.0f, 0.0f, 100.0f, 20.0f), Color::BLACK, LAYER_HUD);
+  hud.color().draw_surface_part(surface, Rectf(0.0f, 0.0f, 8.0f, 8.0f),
+                                Rectf(10.0f, 10.0f, 18.0f, 18.0f), LAYER_HUD);
+
+  compositor.render();
+}
+
+} // namespace
+
+TEST(AllocationCounterTest, counts_new)
+{
+  // new-expressions may be optimized away, call the operators directly
+  const uint64_t before = AllocationCounter::get_count();
+  void* value = ::operator new(sizeof(int));
+  void* values = ::operator new[](4 * sizeof(int));
+  ASSERT_EQ(before + 2, AllocationCounter::get_count());
+  ::operator delete[](values);
+  ::operator delete(value);
+}
+
+TEST(AllocationCounterTest, frames_dont_allocate)
+{
+  TestVideoSystem video_system;
+  Compositor compositor(video_system);
+  const SurfacePtr surface = Surface::from_texture(TexturePtr(new NullTexture(Size(32, 32))));
+  SurfaceBatches particles;
+
+  std::vector<Rectf> tiles;
+  for (int i = 0; i < 500; ++i)
+    tiles.emplace_back(Vector(static_cast<float>(i % 40) * 32.0f, static_cast<float>(i / 40) * 32.0f),
+                       Sizef(32.0f, 32.0f));
+
+  // the first frames size the obstack, the contexts and the batches
+  for (int i = 0; i < 3; ++i)
+    draw_frame(compositor, surface, tiles, particles);
+
+  for (int i = 0; i < 10; ++i)
+  {
+    const uint64_t before = AllocationCounter::get_count();
+    draw_frame(compositor, surface, tiles, particles);
+    ASSERT_EQ(before, AllocationCounter::get_count()) << "frame " << i;
+  }
+}
+
+/* EOF */
@@ -0,0 +1,95 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <physfs.h>
+#include <string>
+#include <vector>
+
+#include "addon/archive_hash_cache.hpp"
+#include "benchmark_util.hpp"
+
+namespace {
+
+const int ARCHIVE_COUNT = 8;
+const size_t ARCHIVE_SIZE = 1024 * 1024;
+
+} // namespace
+
+TEST(ArchiveHashBenchmarkTest, synthetic_archives)
+{
+  namespace fs = boost::filesystem;
+
+  const fs::path root = fs::temp_directory_path() / fs::unique_path("supertux-addons-%%%%-%%%%");
+  fs::create_directories(root / "addons");
+
+  // The content of the archives doesn't matter, only their size
+  std::vector<std::string> archives;
+  for (int i = 0; i < ARCHIVE_COUNT; ++i)
+  {
+    std::string data(ARCHIVE_SIZE, '\0');
+    uint32_t state = 0x9e3779b9u * (i + 1);
+    for (auto& c : data) {
+      state = state * 1664525u + 1013904223u;
+      c = static_cast<char>(state >> 24);
+    }
+
+    const std::string name = "addons/archive" + std::to_string(i) + ".zip";
+    std::ofstream((root / name).string(), std::ios::binary) << data;
+    archives.push_back(name);
+  }
+
+  PHYSFS_init("archive_hash_benchmark_test");
+  ASSERT_TRUE(PHYSFS_setWriteDir(root.string().c_str()));
+  ASSERT_TRUE(PHYSFS_mount(root.string().c_str(), nullptr, 1));
+
+  const unsigned int worker_count = ArchiveHashCache::s_worker_count;
+
+  ArchiveHashCache::s_worker_count = 1;
+  auto start = std::chrono::steady_clock::now();
+  const auto expected = ArchiveHashCache("addons/hash-cache").get_hashes(archives);
+  const double serial_time = elapsed_ms(start);
+
+  ArchiveHashCache::s_worker_count = 0;
+  start = std::chrono::steady_clock::now();
+  {
+    ArchiveHashCache cache("addons/hash-cache");
+    ASSERT_EQ(expected, cache.get_hashes(archives));
+    cache.save();
+  }
+  const double parallel_time = elapsed_ms(start);
+
+  start = std::chrono::steady_clock::now();
+  ASSERT_EQ(expected, ArchiveHashCache("addons/hash-cache").get_hashes(archives));
+  const double cached_time = elapsed_ms(start);
+
+  std::cout << ARCHIVE_COUNT << " archives of " << ARCHIVE_SIZE / 1024 << " KiB: "
+            << "serial " << serial_time << " ms, "
+            << "parallel " << parallel_time << " ms, "
+            << "cached " << cached_time << " ms" << std::endl;
+
+  ArchiveHashCache::s_worker_count = worker_count;
+  PHYSFS_unmount(root.string().c_str());
+  PHYSFS_setWriteDir(nullptr);
+  fs::remove_all(root);
+}
+
+/* EOF */
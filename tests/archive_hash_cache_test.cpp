@@ -0,0 +1,94 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <physfs.h>
+#include <string>
+#include <vector>
+
+#include "addon/archive_hash_cache.hpp"
+#include "addon/md5.hpp"
+
+namespace {
+
+std::string md5_of(const std::string& data)
+{
+  MD5 md5;
+  md5.update(data.data(), data.size());
+  return md5.hex_digest();
+}
+
+} // namespace
+
+TEST(ArchiveHashCacheTest, cached_hashes)
+{
+  namespace fs = boost::filesystem;
+
+  const fs::path root = fs::temp_directory_path() / fs::unique_path("supertux-addons-%%%%-%%%%");
+  fs::create_directories(root / "addons" / "directory-addon");
+
+  const std::vector<std::string> contents = { "first", "second", "third" };
+  std::vector<std::string> archives;
+  std::vector<std::string> expected;
+  for (size_t i = 0; i < contents.size(); ++i)
+  {
+    const std::string name = "addons/archive" + std::to_string(i) + ".zip";
+    std::ofstream((root / name).string(), std::ios::binary) << contents[i];
+    archives.push_back(name);
+    expected.push_back(md5_of(contents[i]));
+  }
+  archives.push_back("addons/directory-addon");
+  expected.push_back(MD5().hex_digest());
+
+  PHYSFS_init("archive_hash_cache_test");
+  ASSERT_TRUE(PHYSFS_setWriteDir(root.string().c_str()));
+  ASSERT_TRUE(PHYSFS_mount(root.string().c_str(), nullptr, 1));
+
+  {
+    ArchiveHashCache cache("addons/hash-cache");
+    ASSERT_EQ(expected, cache.get_hashes(archives));
+    ASSERT_EQ(contents.size(), cache.get_hashed_count());
+    cache.save();
+  }
+
+  {
+    ArchiveHashCache cache("addons/hash-cache");
+    ASSERT_EQ(expected, cache.get_hashes(archives));
+    ASSERT_EQ(0u, cache.get_hashed_count());
+  }
+
+  // an archive that changed without changing its size is only told
+  // apart by its modification time
+  const fs::path changed = root / archives[0];
+  const std::time_t mtime = fs::last_write_time(changed);
+  std::ofstream(changed.string(), std::ios::binary) << "FIRST";
+  fs::last_write_time(changed, mtime + 10);
+
+  {
+    ArchiveHashCache cache("addons/hash-cache");
+    ASSERT_EQ(md5_of("FIRST"), cache.get_hashes(archives)[0]);
+    ASSERT_EQ(1u, cache.get_hashed_count());
+  }
+
+  PHYSFS_unmount(root.string().c_str());
+  PHYSFS_setWriteDir(nullptr);
+  fs::remove_all(root);
+}
+
+/* EOF */
@@ -0,0 +1,60 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include "supertux/autotile.hpp"
+
+TEST(AutotileTest, lookup)
+{
+  // The first autotile matching a mask wins
+  AutotileSet set({
+      new Autotile(10, {}, { new AutotileMask(0x00, true), new AutotileMask(0xFF, true) }, true),
+      new Autotile(11, { { 12, 1.0f } }, { new AutotileMask(0xFF, true) }, true),
+      new Autotile(13, {}, { new AutotileMask(0x02, false) }, false)
+    }, 99, "test", false);
+
+  EXPECT_EQ(10u, set.get_autotile(0, true, true, true, true, true, true, true, true, true, 0, 0));
+  EXPECT_EQ(10u, set.get_autotile(0, false, false, false, false, true, false, false, false, false, 0, 0));
+  EXPECT_EQ(13u, set.get_autotile(0, false, false, false, false, false, false, false, true, false, 0, 0));
+
+  // Masks without an autotile fall back to the default tile
+  EXPECT_EQ(99u, set.get_autotile(0, false, true, false, false, true, false, false, false, false, 0, 0));
+  EXPECT_EQ(0u, set.get_autotile(0, false, true, false, false, false, false, false, false, false, 0, 0));
+
+  EXPECT_TRUE(set.is_member(12));
+  EXPECT_TRUE(set.is_member(99));
+  EXPECT_FALSE(set.is_member(14));
+  EXPECT_TRUE(set.is_solid(11));
+  EXPECT_FALSE(set.is_solid(13));
+  EXPECT_EQ(0xFF, set.get_mask_from_tile(12));
+  EXPECT_EQ(0x02, set.get_mask_from_tile(13));
+}
+
+TEST(AutotileTest, lookup_corner)
+{
+  AutotileSet set({
+      new Autotile(20, {}, { new AutotileMask(0x0F, true) }, true),
+      new Autotile(21, {}, { new AutotileMask(0x01, true), new AutotileMask(0x08, true) }, true)
+    }, 20, "corner", true);
+
+  EXPECT_EQ(20u, set.get_autotile(0, true, false, true, false, false, false, true, false, true, 0, 0));
+  EXPECT_EQ(21u, set.get_autotile(0, false, false, false, false, false, false, false, false, true, 0, 0));
+  EXPECT_EQ(21u, set.get_autotile(0, true, false, false, false, false, false, false, false, false, 0, 0));
+  EXPECT_EQ(0x01, set.get_mask_from_tile(21));
+}
+
+/* EOF */
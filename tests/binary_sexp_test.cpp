@@ -0,0 +1,88 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <sexp/value.hpp>
+#include <stdexcept>
+#include <vector>
+
+#include "util/binary_sexp.hpp"
+
+TEST(BinarySexpTest, roundtrip)
+{
+  auto value = sexp::Value::array(
+    sexp::Value::symbol("sector"),
+    sexp::Value::array(sexp::Value::symbol("name"), sexp::Value::string("main")),
+    sexp::Value::array(sexp::Value::symbol("gravity"), sexp::Value::real(10.5f)),
+    sexp::Value::array(sexp::Value::symbol("solid"), sexp::Value::boolean(true)),
+    sexp::Value::array(sexp::Value::symbol("width"), sexp::Value::integer(-3)));
+
+  auto result = binary_sexp::read(binary_sexp::write(value));
+
+  const auto& arr = result.as_array();
+  ASSERT_EQ(5u, arr.size());
+  ASSERT_EQ("sector", arr[0].as_string());
+  ASSERT_TRUE(arr[0].is_symbol());
+  ASSERT_EQ("main", arr[1].as_array()[1].as_string());
+  ASSERT_TRUE(arr[1].as_array()[1].is_string());
+  ASSERT_EQ(10.5f, arr[2].as_array()[1].as_float());
+  ASSERT_TRUE(arr[3].as_array()[1].as_bool());
+  ASSERT_EQ(-3, arr[4].as_array()[1].as_int());
+}
+
+TEST(BinarySexpTest, integer_runs)
+{
+  std::vector<sexp::Value> tiles;
+  tiles.push_back(sexp::Value::symbol("tiles"));
+  // a long run of empty tiles is run-length encoded...
+  for (int i = 0; i < 1000; ++i) {
+    tiles.push_back(sexp::Value::integer(0));
+  }
+  // ...while varied data is stored as is
+  for (int i = 0; i < 100; ++i) {
+    tiles.push_back(sexp::Value::integer(i * 7));
+  }
+  tiles.push_back(sexp::Value::string("end"));
+  auto value = sexp::Value::array(std::move(tiles));
+
+  const std::string data = binary_sexp::write(value);
+  ASSERT_LT(data.size(), 1000u);
+
+  auto result = binary_sexp::read(data);
+  const auto& arr = result.as_array();
+  ASSERT_EQ(1102u, arr.size());
+  ASSERT_EQ("tiles", arr[0].as_string());
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_EQ(0, arr[1 + i].as_int());
+  }
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_EQ(i * 7, arr[1001 + i].as_int());
+  }
+  ASSERT_EQ("end", arr[1101].as_string());
+}
+
+TEST(BinarySexpTest, truncated)
+{
+  auto value = sexp::Value::array(sexp::Value::symbol("level"), sexp::Value::integer(1));
+  const std::string data = binary_sexp::write(value);
+
+  for (size_t i = 0; i < data.size(); ++i) {
+    ASSERT_THROW(binary_sexp::read(data.substr(0, i)), std::runtime_error);
+  }
+}
+
+/* EOF */
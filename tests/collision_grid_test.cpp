@@ -0,0 +1,125 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "collision/collision_grid.hpp"
+#include "collision/collision_hit.hpp"
+#include "collision/collision_listener.hpp"
+#include "collision/collision_object.hpp"
+
+namespace {
+
+class DummyListener final : public CollisionListener
+{
+public:
+  DummyListener() {}
+
+  virtual void collision_solid(const CollisionHit&) override {}
+  virtual bool collides(GameObject&, const CollisionHit&) const override { return true; }
+  virtual HitResponse collision(GameObject&, const CollisionHit&) override { return ABORT_MOVE; }
+  virtual void collision_tile(uint32_t) override {}
+  virtual bool listener_is_valid() const override { return true; }
+};
+
+class DummyObject final
+{
+public:
+  DummyObject(const Rectf& rect) :
+    m_listener(),
+    m_col(COLGROUP_MOVING, m_listener)
+  {
+    m_col.set_size(rect.get_width(), rect.get_height());
+    m_col.set_pos(rect.p1());
+  }
+
+  DummyListener m_listener;
+  CollisionObject m_col;
+};
+
+std::vector<CollisionObject*> query(CollisionGrid& grid, const Rectf& rect)
+{
+  std::vector<CollisionObject*> result;
+  grid.query(rect, result);
+  return result;
+}
+
+} // namespace
+
+TEST(CollisionGridTest, query)
+{
+  CollisionGrid grid;
+  DummyObject a(Rectf(0.0f, 0.0f, 32.0f, 32.0f));
+  DummyObject b(Rectf(1000.0f, 0.0f, 1032.0f, 32.0f));
+  DummyObject c(Rectf(100.0f, 0.0f, 300.0f, 32.0f));
+
+  grid.insert(a.m_col);
+  grid.insert(b.m_col);
+  grid.insert(c.m_col);
+
+  ASSERT_EQ(std::vector<CollisionObject*>({ &a.m_col, &c.m_col }),
+            query(grid, Rectf(0.0f, 0.0f, 200.0f, 32.0f)));
+  ASSERT_EQ(std::vector<CollisionObject*>({ &b.m_col }),
+            query(grid, Rectf(1010.0f, 10.0f, 1020.0f, 20.0f)));
+  ASSERT_TRUE(query(grid, Rectf(0.0f, 5000.0f, 32.0f, 5032.0f)).empty());
+
+  // results come in insertion order, even for huge query rectangles
+  ASSERT_EQ(std::vector<CollisionObject*>({ &a.m_col, &b.m_col, &c.m_col }),
+            query(grid, Rectf(-100000.0f, -100000.0f, 100000.0f, 100000.0f)));
+}
+
+TEST(CollisionGridTest, move_and_remove)
+{
+  CollisionGrid grid;
+  DummyObject a(Rectf(0.0f, 0.0f, 32.0f, 32.0f));
+  DummyObject b(Rectf(64.0f, 0.0f, 96.0f, 32.0f));
+
+  grid.insert(a.m_col);
+  grid.insert(b.m_col);
+
+  a.m_col.set_pos(Vector(2000.0f, 2000.0f));
+  ASSERT_EQ(std::vector<CollisionObject*>({ &b.m_col }),
+            query(grid, Rectf(0.0f, 0.0f, 32.0f, 32.0f)));
+  ASSERT_EQ(std::vector<CollisionObject*>({ &a.m_col }),
+            query(grid, Rectf(2000.0f, 2000.0f, 2010.0f, 2010.0f)));
+
+  // growing the bbox re-buckets the object as well
+  b.m_col.set_size(500.0f, 32.0f);
+  ASSERT_EQ(std::vector<CollisionObject*>({ &b.m_col }),
+            query(grid, Rectf(500.0f, 0.0f, 510.0f, 10.0f)));
+
+  grid.remove(b.m_col);
+  ASSERT_TRUE(query(grid, Rectf(0.0f, 0.0f, 100.0f, 32.0f)).empty());
+}
+
+TEST(CollisionGridTest, oversized)
+{
+  CollisionGrid grid;
+  DummyObject huge(Rectf(0.0f, 0.0f, 100000.0f, 100000.0f));
+  DummyObject small(Rectf(0.0f, 0.0f, 32.0f, 32.0f));
+
+  grid.insert(huge.m_col);
+  grid.insert(small.m_col);
+
+  ASSERT_EQ(std::vector<CollisionObject*>({ &huge.m_col }),
+            query(grid, Rectf(50000.0f, 50000.0f, 50010.0f, 50010.0f)));
+  ASSERT_EQ(std::vector<CollisionObject*>({ &huge.m_col, &small.m_col }),
+            query(grid, Rectf(0.0f, 0.0f, 10.0f, 10.0f)));
+}
+
+/* EOF */
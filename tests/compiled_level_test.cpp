@@ -0,0 +1,73 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <physfs.h>
+#include <string>
+
+#include "supertux/compiled_level.hpp"
+
+TEST(CompiledLevelTest, find_checks_source)
+{
+  namespace fs = boost::filesystem;
+
+  const fs::path root = fs::temp_directory_path() / fs::unique_path("supertux-levels-%%%%-%%%%");
+  fs::create_directories(root);
+
+  const std::string text = "(supertux-level (version 3) (name \"Test\"))";
+  std::ofstream((root / "test.stl").string(), std::ios::binary) << text;
+
+  CompiledLevel compiled;
+  compiled.m_source_stamp = FileStamp(text.size(), fs::last_write_time(root / "test.stl"));
+  compiled.m_source_hash = CompiledLevel::hash_source(text.data(), text.size());
+  compiled.m_header = sexp::Value::array(sexp::Value::symbol("supertux-level"));
+  {
+    std::ofstream out((root / "test.stlc").string(), std::ios::binary);
+    compiled.write(out);
+  }
+
+  {
+    std::ifstream in((root / "test.stlc").string(), std::ios::binary);
+    auto result = CompiledLevel::from_stream(in);
+    ASSERT_EQ(compiled.m_source_stamp, result.m_source_stamp);
+    ASSERT_EQ(compiled.m_source_hash, result.m_source_hash);
+  }
+
+  PHYSFS_init("compiled_level_test");
+  ASSERT_TRUE(PHYSFS_mount(root.string().c_str(), nullptr, 1));
+
+  ASSERT_EQ("test.stlc", CompiledLevel::find("test.stl"));
+
+  // copying the level changes the modification time, not the content
+  fs::last_write_time(root / "test.stl", compiled.m_source_stamp.mtime + 10);
+  ASSERT_EQ("test.stlc", CompiledLevel::find("test.stl"));
+
+  // saving the level in the same second as compiling it
+  std::ofstream((root / "test.stl").string(), std::ios::binary) << "(supertux-level (version 3) (name \"Tent\"))";
+  fs::last_write_time(root / "test.stl", compiled.m_source_stamp.mtime);
+  ASSERT_EQ("", CompiledLevel::find("test.stl"));
+
+  std::ofstream((root / "test.stl").string(), std::ios::binary) << text << ' ';
+  ASSERT_EQ("", CompiledLevel::find("test.stl"));
+
+  PHYSFS_unmount(root.string().c_str());
+  fs::remove_all(root);
+}
+
+/* EOF */
@@ -0,0 +1,99 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <physfs.h>
+
+#include "object/moving_sprite.hpp"
+#include "sprite/sprite.hpp"
+#include "sprite/sprite_manager.hpp"
+#include "supertux/game_object_manager.hpp"
+#include "supertux/globals.hpp"
+#include "test_video_system.hpp"
+#include "video/compositor.hpp"
+#include "video/drawing_context.hpp"
+#include "video/layer.hpp"
+#include "video/texture_manager.hpp"
+
+namespace {
+
+/** Crumbles away like an UnstableTile: the tile is removed once its
+    one-shot animation is done */
+class CrumblingTile final : public MovingSprite
+{
+public:
+  CrumblingTile(const Vector& pos) :
+    MovingSprite(pos, "crumbling.sprite", LAYER_TILES, COLGROUP_STATIC)
+  {
+    set_action("crumbling", /* loops = */ 1);
+  }
+
+  virtual HitResponse collision(GameObject&, const CollisionHit&) override { return FORCE_MOVE; }
+
+  virtual void update(float) override
+  {
+    if (m_sprite->animation_done())
+      remove_me();
+  }
+};
+
+class TestObjectManager final : public GameObjectManager
+{
+public:
+  TestObjectManager() {}
+
+  virtual bool before_object_add(GameObject&) override { return true; }
+  virtual void before_object_remove(GameObject&) override {}
+};
+
+} // namespace
+
+TEST(GameObjectManagerTest, offscreen_animations_finish)
+{
+  PHYSFS_init("game_object_manager_test");
+  PHYSFS_mount("../tests/data", nullptr, 1);
+
+  TestVideoSystem video_system;
+  TextureManager texture_manager;
+  SpriteManager sprite_manager;
+  Compositor compositor(video_system);
+
+  TestObjectManager manager;
+  CrumblingTile& visible = manager.add<CrumblingTile>(Vector(100.0f, 100.0f));
+  CrumblingTile& offscreen = manager.add<CrumblingTile>(Vector(-1000.0f, 100.0f));
+  manager.flush_game_objects();
+
+  // three frames at 10 fps, give the animation a second to finish
+  const float dt_sec = 0.05f;
+  for (int i = 0; i < 20; ++i)
+  {
+    g_game_time += dt_sec;
+    manager.update(dt_sec);
+
+    compositor.start_frame();
+    manager.draw(compositor.make_context());
+    compositor.render();
+  }
+
+  EXPECT_FALSE(visible.is_valid());
+  EXPECT_FALSE(offscreen.is_valid());
+
+  manager.flush_game_objects();
+  EXPECT_TRUE(manager.get_objects().empty());
+}
+
+/* EOF */
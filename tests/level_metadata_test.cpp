@@ -0,0 +1,59 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+
+#include "supertux/level_metadata_index.hpp"
+
+TEST(LevelMetadataTest, scan)
+{
+  const std::string text =
+    "; a level\n"
+    "(supertux-level\n"
+    "  (version 3)\n"
+    "  (name (_ \"Welcome (to) \\\"Antarctica\\\"\"))\n"
+    "  (author \"SuperTux Team\")\n"
+    "  (license \"CC-BY-SA 4.0 International\")\n"
+    "  (target-time 42.5)\n"
+    "  (sector (name \"main\")\n"
+    "    (tilemap (tiles 1 2 3)) ; (sector\n"
+    "    (text (text \")(sector\")))\n"
+    "  (sector (name \"secret\"))\n"
+    "  (tileset \"images/tiles.strf\")\n"
+    ")\n";
+
+  auto metadata = LevelMetadataIndex::scan(text.data(), text.size());
+  ASSERT_EQ("Welcome (to) \"Antarctica\"", metadata.name);
+  ASSERT_TRUE(metadata.name_translatable);
+  ASSERT_EQ("SuperTux Team", metadata.author);
+  ASSERT_EQ("CC-BY-SA 4.0 International", metadata.license);
+  ASSERT_EQ(42.5f, metadata.target_time);
+  ASSERT_EQ(2, metadata.sector_count);
+}
+
+TEST(LevelMetadataTest, scan_errors)
+{
+  const std::string worldmap = "(supertux-level-subset (title \"x\"))";
+  ASSERT_THROW(LevelMetadataIndex::scan(worldmap.data(), worldmap.size()), std::runtime_error);
+
+  const std::string truncated = "(supertux-level (name \"x\") (sector (name \"main\")";
+  ASSERT_THROW(LevelMetadataIndex::scan(truncated.data(), truncated.size()), std::runtime_error);
+}
+
+/* EOF */
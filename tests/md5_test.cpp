@@ -30,4 +30,23 @@ TEST(MD5, test)
   ASSERT_EQ("68e109f0f40ca72a15e05cc22786f8e6", MD5(helloworld).hex_digest());
 }
 
+TEST(MD5, buffer)
+{
+  std::string data;
+  for (int i = 0; i < 100000; ++i)
+    data += static_cast<char>(i * 7 % 256);
+
+  std::istringstream stream(data);
+  MD5 whole;
+  whole.update(data.data(), data.size());
+  ASSERT_EQ(MD5(stream).hex_digest(), whole.hex_digest());
+
+  // the digest doesn't depend on how the input is split
+  MD5 pieces;
+  pieces.update(data.data(), 1000);
+  pieces.update(data.data() + 1000, 0);
+  pieces.update(data.data() + 1000, data.size() - 1000);
+  ASSERT_EQ(whole.hex_digest(), pieces.hex_digest());
+}
+
 /* EOF */
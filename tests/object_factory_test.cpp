@@ -0,0 +1,154 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "math/vector.hpp"
+#include "supertux/game_object.hpp"
+#include "supertux/object_factory.hpp"
+#include "util/reader_document.hpp"
+#include "util/reader_mapping.hpp"
+
+namespace {
+
+class SpawnedObject final : public GameObject
+{
+public:
+  SpawnedObject(const ReaderMapping& reader) :
+    GameObject(reader),
+    m_x(),
+    m_y(),
+    m_speed(),
+    m_direction()
+  {
+    reader.get("x", m_x);
+    reader.get("y", m_y);
+    reader.get("speed", m_speed);
+    reader.get("direction", m_direction);
+  }
+
+  virtual void update(float) override {}
+  virtual void draw(DrawingContext&) override {}
+
+  float m_x;
+  float m_y;
+  float m_speed;
+  std::string m_direction;
+};
+
+class SpawnFactory final : public ObjectFactory
+{
+public:
+  SpawnFactory()
+  {
+    add_factory<SpawnedObject>("spawned");
+  }
+};
+
+} // namespace
+
+TEST(ObjectFactoryTest, create_from_prototype)
+{
+  SpawnFactory factory;
+
+  for (int i = 0; i < 3; ++i)
+  {
+    auto object = factory.create("spawned", Vector(10.5f * static_cast<float>(i), 20.0f),
+                                 Direction::LEFT, " (speed 3.5)");
+    auto& spawned = dynamic_cast<SpawnedObject&>(*object);
+    EXPECT_EQ(10.5f * static_cast<float>(i), spawned.m_x);
+    EXPECT_EQ(20.0f, spawned.m_y);
+    EXPECT_EQ(3.5f, spawned.m_speed);
+    EXPECT_EQ("left", spawned.m_direction);
+  }
+  // the later calls reuse the prototype of the first one
+  EXPECT_EQ(1u, factory.get_prototype_count());
+
+  auto object = factory.create("spawned", Vector(1.0f, 2.0f));
+  auto& spawned = dynamic_cast<SpawnedObject&>(*object);
+  EXPECT_EQ(1.0f, spawned.m_x);
+  EXPECT_EQ(0.0f, spawned.m_speed);
+  EXPECT_EQ("", spawned.m_direction);
+  EXPECT_EQ(2u, factory.get_prototype_count());
+
+  factory.clear_prototypes();
+  EXPECT_EQ(0u, factory.get_prototype_count());
+
+  EXPECT_THROW(factory.create("unknown", Vector(0.0f, 0.0f)), std::runtime_error);
+}
+
+TEST(ObjectFactoryTest, prototypes_are_bounded)
+{
+  SpawnFactory factory;
+
+  for (int i = 0; i < 1000; ++i)
+  {
+    const std::string data = " (speed " + std::to_string(i) + ")";
+    auto object = factory.create("spawned", Vector(0.0f, 0.0f), Direction::AUTO, data);
+    EXPECT_EQ(static_cast<float>(i), dynamic_cast<SpawnedObject&>(*object).m_speed);
+  }
+  EXPECT_LT(factory.get_prototype_count(), 1000u);
+}
+
+TEST(ObjectFactoryTest, spawn_benchmark)
+{
+  const int count = 10000;
+  SpawnFactory factory;
+
+  std::vector<std::unique_ptr<GameObject>> parsed_objects;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < count; ++i)
+  {
+    // what create() did before prototypes
+    std::stringstream lisptext;
+    lisptext << "(spawned (x " << i << ") (y 0) (speed 3.5) (direction \"left\"))";
+    auto doc = ReaderDocument::from_stream(lisptext);
+    parsed_objects.push_back(factory.create("spawned", doc.get_root().get_mapping()));
+  }
+  auto parsed = std::chrono::steady_clock::now() - start;
+
+  std::vector<std::unique_ptr<GameObject>> prototyped_objects;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < count; ++i)
+  {
+    prototyped_objects.push_back(
+      factory.create("spawned", Vector(static_cast<float>(i), 0.0f), Direction::LEFT, " (speed 3.5)"));
+  }
+  auto prototyped = std::chrono::steady_clock::now() - start;
+
+  EXPECT_EQ(1u, factory.get_prototype_count());
+  for (int i = 0; i < count; ++i)
+  {
+    const auto& lhs = dynamic_cast<const SpawnedObject&>(*parsed_objects[i]);
+    const auto& rhs = dynamic_cast<const SpawnedObject&>(*prototyped_objects[i]);
+    ASSERT_EQ(lhs.m_x, rhs.m_x) << i;
+    ASSERT_EQ(lhs.m_y, rhs.m_y) << i;
+    ASSERT_EQ(lhs.m_speed, rhs.m_speed) << i;
+    ASSERT_EQ(lhs.m_direction, rhs.m_direction) << i;
+  }
+
+  std::cout << "spawning " << count << " objects: "
+            << std::chrono::duration_cast<std::chrono::microseconds>(parsed).count() << "us parsed, "
+            << std::chrono::duration_cast<std::chrono::microseconds>(prototyped).count() << "us from prototype"
+            << std::endl;
+}
+
+/* EOF */
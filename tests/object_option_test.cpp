@@ -17,10 +17,14 @@
 #include <gtest/gtest.h>
 #include <iostream>
 #include <errno.h>
+#include <sstream>
 #include <string.h>
 #include <vector>
 
 #include "editor/object_option.hpp"
+#include "util/reader_document.hpp"
+#include "util/reader_mapping.hpp"
+#include "util/writer.hpp"
 #include "video/color.hpp"
 
 TEST(ObjectOption, to_string)
@@ -81,4 +85,58 @@ TEST(ObjectOption, to_string)
   }
 }
 
+TEST(ObjectOption, parse)
+{
+  int myint = 5;
+  std::string mystring = "text";
+  int myenum = 1;
+  Color mycolor = Color::YELLOW;
+
+  IntObjectOption intfield("int", &myint, "int", 0, 0);
+  StringObjectOption textfield("string", &mystring, "string", boost::none, 0);
+  EnumObjectOption enumfield("enum", &myenum, {"Foo", "Bar"}, {"foo", "bar"}, 0, "enum", 0);
+  ColorObjectOption color("color", &mycolor, "color", Color::WHITE, false, 0);
+
+  std::ostringstream out;
+  {
+    Writer writer(out);
+    writer.start_list("options");
+    intfield.save(writer);
+    textfield.save(writer);
+    enumfield.save(writer);
+    color.save(writer);
+    writer.end_list("options");
+  }
+
+  myint = 7;
+  mystring.clear();
+  myenum = 0;
+  mycolor = Color::WHITE;
+
+  std::istringstream in(out.str());
+  auto doc = ReaderDocument::from_stream(in);
+  auto mapping = doc.get_root().get_mapping();
+  intfield.parse(mapping);
+  textfield.parse(mapping);
+  enumfield.parse(mapping);
+  color.parse(mapping);
+
+  ASSERT_EQ(5, myint);
+  ASSERT_EQ("text", mystring);
+  ASSERT_EQ(1, myenum);
+  ASSERT_EQ(Color::YELLOW, mycolor);
+
+  // values equal to the default aren't saved, parsing restores them
+  std::istringstream empty_in("(options)");
+  auto empty_doc = ReaderDocument::from_stream(empty_in);
+  auto empty_mapping = empty_doc.get_root().get_mapping();
+  intfield.parse(empty_mapping);
+  enumfield.parse(empty_mapping);
+  color.parse(empty_mapping);
+
+  ASSERT_EQ(0, myint);
+  ASSERT_EQ(0, myenum);
+  ASSERT_EQ(Color::WHITE, mycolor);
+}
+
 /* EOF */
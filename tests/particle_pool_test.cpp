@@ -0,0 +1,100 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include "math/rectf.hpp"
+#include "object/particle_pool.hpp"
+
+TEST(ParticlePoolTest, allocate_and_release)
+{
+  ParticlePool pool;
+
+  size_t a = pool.allocate();
+  size_t b = pool.allocate();
+  size_t c = pool.allocate();
+  ASSERT_EQ(3u, pool.get_count());
+  ASSERT_EQ(3u, pool.get_slot_count());
+
+  pool.pos_x[b] = 42.0f;
+  pool.release(b);
+  ASSERT_EQ(2u, pool.get_count());
+  ASSERT_FALSE(pool.is_alive(b));
+  ASSERT_TRUE(pool.is_alive(a));
+  ASSERT_TRUE(pool.is_alive(c));
+
+  // Releasing twice must not corrupt the free list
+  pool.release(b);
+  ASSERT_EQ(2u, pool.get_count());
+
+  // The released slot gets reused, with default values
+  size_t d = pool.allocate();
+  ASSERT_EQ(b, d);
+  ASSERT_EQ(3u, pool.get_slot_count());
+  ASSERT_EQ(0.0f, pool.pos_x[d]);
+  ASSERT_EQ(1.0f, pool.scale[d]);
+
+  pool.clear();
+  ASSERT_EQ(0u, pool.get_count());
+  ASSERT_EQ(0u, pool.get_slot_count());
+}
+
+TEST(ParticlePoolTest, integrate)
+{
+  ParticlePool pool;
+
+  size_t i = pool.allocate();
+  pool.pos_x[i] = 10.0f;
+  pool.pos_y[i] = 20.0f;
+  pool.vel_x[i] = 1.0f;
+  pool.vel_y[i] = -2.0f;
+
+  pool.integrate(0.5f, 2.0f);
+  ASSERT_FLOAT_EQ(11.0f, pool.pos_x[i]);
+  ASSERT_FLOAT_EQ(18.0f, pool.pos_y[i]);
+  ASSERT_FLOAT_EQ(0.5f, pool.age[i]);
+
+  pool.integrate(1.0f, 1.0f, Vector(0.0f, 10.0f));
+  ASSERT_FLOAT_EQ(1.0f, pool.vel_x[i]);
+  ASSERT_FLOAT_EQ(8.0f, pool.vel_y[i]);
+  ASSERT_FLOAT_EQ(12.0f, pool.pos_x[i]);
+  ASSERT_FLOAT_EQ(26.0f, pool.pos_y[i]);
+}
+
+TEST(ParticlePoolTest, wrap)
+{
+  ParticlePool pool;
+
+  size_t a = pool.allocate();
+  size_t b = pool.allocate();
+  size_t c = pool.allocate();
+  pool.pos_x[a] = -10.0f;
+  pool.pos_y[a] = 50.0f;
+  pool.pos_x[b] = 250.0f;
+  pool.pos_y[b] = 310.0f;
+  pool.pos_x[c] = 100.0f;
+  pool.pos_y[c] = 100.0f;
+
+  pool.wrap(Rectf(0.0f, 0.0f, 200.0f, 100.0f));
+  ASSERT_FLOAT_EQ(190.0f, pool.pos_x[a]);
+  ASSERT_FLOAT_EQ(50.0f, pool.pos_y[a]);
+  ASSERT_FLOAT_EQ(50.0f, pool.pos_x[b]);
+  ASSERT_FLOAT_EQ(10.0f, pool.pos_y[b]);
+  ASSERT_FLOAT_EQ(100.0f, pool.pos_x[c]);
+  ASSERT_FLOAT_EQ(0.0f, pool.pos_y[c]);
+}
+
+/* EOF */
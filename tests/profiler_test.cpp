@@ -0,0 +1,85 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+
+#include "util/profiler.hpp"
+
+TEST(ProfilerTest, merges_sibling_zones)
+{
+  Profiler profiler;
+  for (int frame = 0; frame < Profiler::FRAME_WINDOW; ++frame)
+  {
+    profiler.begin_zone("frame");
+    for (int i = 0; i < 3; ++i)
+    {
+      profiler.begin_zone("update");
+      profiler.end_zone();
+    }
+    profiler.begin_zone("draw");
+    profiler.begin_zone("render");
+    profiler.end_zone();
+    profiler.end_zone();
+    profiler.end_zone();
+  }
+
+  const auto& zones = profiler.get_slowest_frame();
+  ASSERT_EQ(4u, zones.size());
+
+  ASSERT_STREQ("frame", zones[0].name);
+  ASSERT_EQ(-1, zones[0].parent);
+
+  const auto& update = zones[zones[0].first_child];
+  ASSERT_STREQ("update", update.name);
+  ASSERT_EQ(3, update.calls);
+  ASSERT_EQ(1, update.depth);
+
+  const auto& draw = zones[update.next_sibling];
+  ASSERT_STREQ("draw", draw.name);
+  ASSERT_EQ(-1, draw.next_sibling);
+  ASSERT_STREQ("render", zones[draw.first_child].name);
+  ASSERT_EQ(2, zones[draw.first_child].depth);
+}
+
+TEST(ProfilerTest, write_trace)
+{
+  Profiler profiler;
+  profiler.begin_zone("ignored");
+  profiler.end_zone();
+
+  profiler.start_trace();
+  ASSERT_TRUE(profiler.is_tracing());
+  profiler.begin_zone("outer");
+  profiler.begin_zone("inner");
+  profiler.end_zone();
+  profiler.end_zone();
+  profiler.stop_trace();
+  ASSERT_FALSE(profiler.is_tracing());
+
+  std::ostringstream out;
+  profiler.write_trace(out);
+  const std::string trace = out.str();
+
+  ASSERT_EQ(std::string::npos, trace.find("ignored"));
+  ASSERT_NE(std::string::npos, trace.find("\"name\":\"inner\""));
+  ASSERT_NE(std::string::npos, trace.find("\"name\":\"outer\""));
+  ASSERT_LT(trace.find("inner"), trace.find("outer"));
+}
+
+/* EOF */
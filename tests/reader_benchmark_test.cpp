@@ -0,0 +1,123 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sexp/value.hpp>
+#include <string>
+#include <vector>
+
+#include "benchmark_util.hpp"
+#include "util/reader_document.hpp"
+#include "util/reader_mapping.hpp"
+
+namespace {
+
+/** The largest files shipped in data/, relative to the build directory */
+const char* const BENCHMARK_FILES[] = {
+  "../data/images/tiles.strf",
+  "../data/levels/world1/crystal_mine.stl",
+  "../data/levels/world2/tower_of_ghosts.stl",
+  "../data/levels/bonus4/Night_Terrors.stl",
+  "../data/levels/world2/ancient_ruins.stl"
+};
+
+bool is_mapping(const sexp::Value& sx)
+{
+  if (!sx.is_array() || sx.as_array().empty() || !sx.as_array()[0].is_symbol())
+    return false;
+
+  const auto& arr = sx.as_array();
+  for (size_t i = 1; i < arr.size(); ++i) {
+    if (!arr[i].is_array() || arr[i].as_array().empty() || !arr[i].as_array()[0].is_symbol())
+      return false;
+  }
+  return true;
+}
+
+/** Looks up every key of every mapping in the document, plus a key that
+    doesn't exist, like object constructors do for their defaults.
+    Returns the amount of keys found. */
+int lookup_all(const ReaderDocument& doc, const sexp::Value& sx)
+{
+  if (!sx.is_array())
+    return 0;
+
+  int found = 0;
+  if (is_mapping(sx))
+  {
+    ReaderMapping mapping(doc, sx);
+    const auto& arr = sx.as_array();
+    for (size_t i = 1; i < arr.size(); ++i)
+    {
+      boost::optional<ReaderMapping> item;
+      if (mapping.get(arr[i].as_array()[0].as_string().c_str(), item))
+        found += 1;
+    }
+
+    boost::optional<ReaderMapping> item;
+    if (mapping.get("does-not-exist", item))
+      found += 1;
+  }
+
+  for (const auto& child : sx.as_array())
+    found += lookup_all(doc, child);
+  return found;
+}
+
+} // namespace
+
+TEST(ReaderBenchmarkTest, shipped_data)
+{
+  const size_t index_min_size = ReaderMapping::s_index_min_size;
+
+  for (const char* filename : BENCHMARK_FILES)
+  {
+    std::ifstream in(filename);
+    if (!in) {
+      std::cout << filename << ": not found, skipped" << std::endl;
+      continue;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto doc = ReaderDocument::from_stream(in, filename);
+    const double parse_time = elapsed_ms(start);
+
+    ReaderMapping::s_index_min_size = std::numeric_limits<size_t>::max();
+    start = std::chrono::steady_clock::now();
+    const int linear_found = lookup_all(doc, doc.get_sexp());
+    const double linear_time = elapsed_ms(start);
+
+    ReaderMapping::s_index_min_size = index_min_size;
+    start = std::chrono::steady_clock::now();
+    const int indexed_found = lookup_all(doc, doc.get_sexp());
+    const double indexed_time = elapsed_ms(start);
+
+    ASSERT_EQ(linear_found, indexed_found);
+
+    std::cout << filename << ": parse " << parse_time << " ms, "
+              << linear_found << " lookups: linear " << linear_time << " ms, "
+              << "indexed " << indexed_time << " ms" << std::endl;
+  }
+
+  ReaderMapping::s_index_min_size = index_min_size;
+}
+
+/* EOF */
@@ -169,4 +169,34 @@ TEST(ReaderTest, syntax_error)
   ASSERT_THROW({mymapping->get("b", myint);}, std::runtime_error);
 }
 
+TEST(ReaderTest, indexed_lookup)
+{
+  std::ostringstream text;
+  text << "(supertux-test\n";
+  for (int i = 0; i < 32; ++i) {
+    text << "  (key" << i << " " << i << ")\n";
+  }
+  text << "  (key7 700)\n";
+  text << ")\n";
+
+  std::istringstream in(text.str());
+  auto doc = ReaderDocument::from_stream(in);
+  auto mapping = doc.get_root().get_mapping();
+
+  for (int i = 0; i < 32; ++i) {
+    int value = -1;
+    ASSERT_TRUE(mapping.get(("key" + std::to_string(i)).c_str(), value));
+    ASSERT_EQ(i, value);
+  }
+
+  // like a linear scan, the first of duplicate keys is used
+  int value = -1;
+  ASSERT_TRUE(mapping.get("key7", value));
+  ASSERT_EQ(7, value);
+
+  ASSERT_FALSE(mapping.get("key32", value));
+  ASSERT_FALSE(mapping.get("aaa", value));
+  ASSERT_FALSE(mapping.get("zzz", value));
+}
+
 /* EOF */
@@ -0,0 +1,60 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include "math/rect_packer.hpp"
+
+TEST(RectPackerTest, fills_shelves)
+{
+  RectPacker packer(64, 64);
+
+  ASSERT_EQ(Rect(0, 0, 32, 32), *packer.insert(Size(32, 32)));
+  ASSERT_EQ(Rect(32, 0, 64, 32), *packer.insert(Size(32, 32)));
+  ASSERT_EQ(Rect(0, 32, 32, 64), *packer.insert(Size(32, 32)));
+  ASSERT_EQ(Rect(32, 32, 64, 64), *packer.insert(Size(32, 32)));
+  ASSERT_FALSE(packer.insert(Size(1, 1)));
+
+  packer.clear();
+  ASSERT_EQ(Rect(0, 0, 32, 32), *packer.insert(Size(32, 32)));
+}
+
+TEST(RectPackerTest, prefers_fitting_shelf)
+{
+  RectPacker packer(64, 64);
+
+  ASSERT_EQ(Rect(0, 0, 16, 32), *packer.insert(Size(16, 32)));
+  // much smaller than the first shelf, gets its own
+  ASSERT_EQ(Rect(0, 32, 16, 40), *packer.insert(Size(16, 8)));
+  // close enough in height to share the first shelf
+  ASSERT_EQ(Rect(16, 0, 32, 30), *packer.insert(Size(16, 30)));
+  ASSERT_EQ(Rect(16, 32, 32, 40), *packer.insert(Size(16, 8)));
+}
+
+TEST(RectPackerTest, rejects_invalid_sizes)
+{
+  RectPacker packer(64, 64);
+
+  ASSERT_FALSE(packer.insert(Size(65, 1)));
+  ASSERT_FALSE(packer.insert(Size(1, 65)));
+  ASSERT_FALSE(packer.insert(Size(0, 0)));
+
+  // falls back to a taller shelf once there is no room for a new one
+  ASSERT_TRUE(packer.insert(Size(32, 60)));
+  ASSERT_EQ(Rect(32, 0, 40, 8), *packer.insert(Size(8, 8)));
+}
+
+/* EOF */
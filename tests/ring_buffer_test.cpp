@@ -0,0 +1,84 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "util/ring_buffer.hpp"
+
+TEST(RingBufferTest, wrap_around)
+{
+  RingBuffer buffer(8);
+  char out[8];
+
+  ASSERT_EQ(6u, buffer.write("abcdef", 6));
+  ASSERT_EQ(4u, buffer.read(out, 4));
+  ASSERT_EQ("abcd", std::string(out, 4));
+
+  // only 6 bytes are free, the last write is truncated
+  ASSERT_EQ(6u, buffer.write("ghijklmn", 8));
+  ASSERT_EQ(0u, buffer.get_write_available());
+  ASSERT_EQ(0u, buffer.write("o", 1));
+
+  ASSERT_EQ(8u, buffer.read(out, 8));
+  ASSERT_EQ("efghijkl", std::string(out, 8));
+  ASSERT_EQ(0u, buffer.read(out, 8));
+
+  buffer.write("xy", 2);
+  buffer.clear();
+  ASSERT_EQ(0u, buffer.get_read_available());
+  ASSERT_EQ(8u, buffer.get_write_available());
+}
+
+TEST(RingBufferTest, producer_consumer)
+{
+  const size_t total = 100000;
+  RingBuffer buffer(1000);
+
+  std::thread producer([&] {
+    size_t written = 0;
+    unsigned char chunk[77];
+    while (written < total) {
+      size_t size = std::min(sizeof(chunk), total - written);
+      for (size_t i = 0; i < size; ++i)
+        chunk[i] = static_cast<unsigned char>((written + i) % 251);
+      size_t done = 0;
+      while (done < size) {
+        done += buffer.write(chunk + done, size - done);
+        std::this_thread::yield();
+      }
+      written += size;
+    }
+  });
+
+  std::vector<unsigned char> received;
+  received.reserve(total);
+  unsigned char chunk[129];
+  while (received.size() < total) {
+    size_t size = buffer.read(chunk, sizeof(chunk));
+    received.insert(received.end(), chunk, chunk + size);
+    if (size == 0)
+      std::this_thread::yield();
+  }
+  producer.join();
+
+  for (size_t i = 0; i < total; ++i)
+    ASSERT_EQ(i % 251, received[i]);
+}
+
+/* EOF */
@@ -0,0 +1,70 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_TESTS_TEST_VIDEO_SYSTEM_HPP
+#define HEADER_SUPERTUX_TESTS_TEST_VIDEO_SYSTEM_HPP
+
+#include <SDL.h>
+
+#include "video/null/null_renderer.hpp"
+#include "video/null/null_texture.hpp"
+#include "video/sdl_surface_ptr.hpp"
+#include "video/video_system.hpp"
+#include "video/viewport.hpp"
+
+/** Like NullVideoSystem, but without the config and texture manager */
+class TestVideoSystem final : public VideoSystem
+{
+public:
+  TestVideoSystem() :
+    m_viewport(Rect(0, 0, 1280, 800), Vector(1.0f, 1.0f)),
+    m_renderer(),
+    m_lightmap()
+  {}
+
+  virtual std::string get_name() const override { return "Test"; }
+  virtual Renderer* get_back_renderer() const override { return nullptr; }
+  virtual Renderer& get_renderer() const override { return const_cast<NullRenderer&>(m_renderer); }
+  virtual Renderer& get_lightmap() const override { return const_cast<NullRenderer&>(m_lightmap); }
+  virtual TexturePtr new_texture(const SDL_Surface& image, const Sampler&) override
+  {
+    return TexturePtr(new NullTexture(Size(image.w, image.h)));
+  }
+  virtual const Viewport& get_viewport() const override { return m_viewport; }
+  virtual void apply_config() override {}
+  virtual void flip() override {}
+  virtual void on_resize(int, int) override {}
+  virtual Size get_window_size() const override { return Size(1280, 800); }
+  virtual void set_vsync(int) override {}
+  virtual int get_vsync() const override { return 0; }
+  virtual void set_gamma(float) override {}
+  virtual void set_title(const std::string&) override {}
+  virtual void set_icon(const SDL_Surface&) override {}
+  virtual SDLSurfacePtr make_screenshot() override { return SDLSurfacePtr(); }
+
+private:
+  Viewport m_viewport;
+  NullRenderer m_renderer;
+  NullRenderer m_lightmap;
+
+private:
+  TestVideoSystem(const TestVideoSystem&) = delete;
+  TestVideoSystem& operator=(const TestVideoSystem&) = delete;
+};
+
+#endif
+
+/* EOF */
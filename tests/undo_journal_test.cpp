@@ -0,0 +1,152 @@
+//  SuperTux
+//  Copyright (C) 2021 A. Semphris <semphris@protonmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "editor/undo_journal.hpp"
+
+namespace {
+
+/** Stands in for a level with a single tilemap */
+struct FakeLevel
+{
+  std::string name;
+  std::vector<uint32_t> tiles;
+
+  std::string save() const
+  {
+    std::ostringstream out;
+    out << name;
+    for (const auto tile : tiles)
+      out << ' ' << tile;
+    return out.str();
+  }
+
+  void load(const std::string& snapshot)
+  {
+    std::istringstream in(snapshot);
+    in >> name;
+    tiles.clear();
+    uint32_t tile;
+    while (in >> tile)
+      tiles.push_back(tile);
+  }
+
+  void apply(const UndoJournal::Entry& entry, bool forward)
+  {
+    for (const auto& delta : entry.tiles)
+      for (const auto& change : delta.changes)
+        tiles[change.index] = forward ? change.new_tile : change.old_tile;
+  }
+};
+
+UndoJournal::Entry
+make_tile_entry(int index, uint32_t old_tile, uint32_t new_tile)
+{
+  UndoJournal::Entry entry{};
+  entry.diffable = true;
+  entry.tiles.push_back({ 0, 0, { { index, old_tile, new_tile } } });
+  return entry;
+}
+
+} // namespace
+
+TEST(UndoJournalTest, checkpoint_round_trip)
+{
+  const int deltas = UndoJournal::CHECKPOINT_INTERVAL + 5;
+
+  FakeLevel level{ "before", std::vector<uint32_t>(deltas, 0) };
+  const auto save = [&level] { return level.save(); };
+
+  UndoJournal journal(1000, 1024 * 1024);
+  journal.record(UndoJournal::Entry{}, save);
+
+  for (int i = 0; i < deltas; ++i)
+  {
+    level.tiles[i] = i + 1;
+    journal.record(make_tile_entry(i, 0, i + 1), save);
+  }
+
+  // only the 25th delta carries the level along with it
+  const auto& undo_stack = journal.get_undo_stack();
+  ASSERT_EQ(static_cast<size_t>(deltas + 1), undo_stack.size());
+  for (int i = 1; i <= deltas; ++i)
+    EXPECT_EQ(i == UndoJournal::CHECKPOINT_INTERVAL, !undo_stack[i].snapshot.empty()) << i;
+  const std::string painted = level.save();
+
+  level.name = "after";
+  UndoJournal::Entry rename{};
+  journal.record(std::move(rename), save);
+  const std::string renamed = level.save();
+
+  int loads = 0;
+  int applies = 0;
+  const auto apply = [&level, &applies](const UndoJournal::Entry& entry, bool forward) {
+    applies += 1;
+    level.apply(entry, forward);
+  };
+  const auto load = [&level, &loads](const std::string& snapshot) {
+    loads += 1;
+    level.load(snapshot);
+  };
+
+  // undoing the snapshot starts from the checkpoint, not from the base
+  ASSERT_TRUE(journal.undo(apply, load));
+  EXPECT_EQ(1, loads);
+  EXPECT_EQ(deltas - UndoJournal::CHECKPOINT_INTERVAL, applies);
+  EXPECT_EQ(painted, level.save());
+
+  // the deltas are undone in place
+  loads = 0;
+  for (int i = 0; i < deltas; ++i)
+    ASSERT_TRUE(journal.undo(apply, load));
+  EXPECT_EQ(0, loads);
+  EXPECT_EQ(FakeLevel({ "before", std::vector<uint32_t>(deltas, 0) }).save(), level.save());
+  EXPECT_FALSE(journal.undo(apply, load));
+
+  for (int i = 0; i < deltas; ++i)
+    ASSERT_TRUE(journal.redo(apply, load));
+  EXPECT_EQ(painted, level.save());
+
+  ASSERT_TRUE(journal.redo(apply, load));
+  EXPECT_EQ(1, loads);
+  EXPECT_EQ(renamed, level.save());
+  EXPECT_FALSE(journal.redo(apply, load));
+}
+
+TEST(UndoJournalTest, cleanup_keeps_a_base)
+{
+  FakeLevel level{ "level", std::vector<uint32_t>(100, 0) };
+  const auto save = [&level] { return level.save(); };
+
+  UndoJournal journal(10, 1024 * 1024);
+  journal.record(UndoJournal::Entry{}, save);
+  for (int i = 0; i < 100; ++i)
+  {
+    level.tiles[i] = 1;
+    journal.record(make_tile_entry(i, 0, 1), save);
+  }
+
+  // entries are only dropped up to the next checkpoint
+  const auto& undo_stack = journal.get_undo_stack();
+  ASSERT_FALSE(undo_stack.empty());
+  EXPECT_FALSE(undo_stack.front().snapshot.empty());
+  EXPECT_LE(undo_stack.size(), static_cast<size_t>(UndoJournal::CHECKPOINT_INTERVAL));
+}
+
+/* EOF */